@@ -20,13 +20,92 @@
 
 #include "assimp_importer.h"
 
+#include "engine/optimizer/mesh_optimizer.h"
 #include "objects/mesh.h"
+#include "objects/mesh_registry.h"
 #include "objects/scene.h"
 #include "objects/scene_object.h"
 #include "objects/components/render_data.h"
+#include "util/gvr_gl.h"
+#include "util/gvr_log.h"
 
 namespace gvr {
+static const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const unsigned long long FNV_PRIME = 1099511628211ULL;
+
+static unsigned long long hashBytes(unsigned long long hash, const void* data,
+        size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// FNV-1a over what createMesh() reads from ai_mesh, before any of its work
+static unsigned long long hashSource(const aiMesh* ai_mesh) {
+    unsigned long long hash = FNV_OFFSET_BASIS;
+    unsigned int vertex_count = ai_mesh->mNumVertices;
+    hash = hashBytes(hash, &ai_mesh->mPrimitiveTypes,
+            sizeof(ai_mesh->mPrimitiveTypes));
+    hash = hashBytes(hash, &vertex_count, sizeof(vertex_count));
+    const aiVector3D* attributes[] = { ai_mesh->mVertices, ai_mesh->mNormals,
+            ai_mesh->mTextureCoords[0] };
+    for (int i = 0; i < 3; ++i) {
+        bool present = attributes[i] != 0;
+        hash = hashBytes(hash, &present, sizeof(present));
+        if (present) {
+            hash = hashBytes(hash, attributes[i],
+                    vertex_count * sizeof(aiVector3D));
+        }
+    }
+    for (int i = 0; i < ai_mesh->mNumFaces; ++i) {
+        const aiFace& face = ai_mesh->mFaces[i];
+        hash = hashBytes(hash, &face.mNumIndices, sizeof(face.mNumIndices));
+        hash = hashBytes(hash, face.mIndices,
+                face.mNumIndices * sizeof(unsigned int));
+    }
+    return hash;
+}
+
+static int countIndices(const aiMesh* ai_mesh) {
+    int index_count = 0;
+    for (int i = 0; i < ai_mesh->mNumFaces; ++i) {
+        index_count += ai_mesh->mFaces[i].mNumIndices;
+    }
+    return index_count;
+}
+
 std::shared_ptr<Mesh> AssimpImporter::getMesh(int index) {
+    // nodes using the same aiMesh, and other imports of the same content,
+    // get one mesh and one set of buffers, and only the first is built and
+    // optimized; a mesh that released its data is built again, to reload()
+    // it from
+    if (index < meshes_.size()) {
+        std::shared_ptr<Mesh> mesh = meshes_[index].lock();
+        if (mesh && !mesh->released()) {
+            return mesh;
+        }
+    }
+    const aiMesh* ai_mesh = assimp_importer_->GetScene()->mMeshes[index];
+    unsigned long long source_hash = hashSource(ai_mesh);
+    int vertex_count = ai_mesh->mNumVertices;
+    int index_count = countIndices(ai_mesh);
+    std::shared_ptr<Mesh> mesh = MeshRegistry::findSource(source_hash,
+            vertex_count, index_count);
+    if (!mesh) {
+        mesh = MeshRegistry::intern(createMesh(index), source_hash,
+                vertex_count, index_count);
+    }
+    if (meshes_.size() <= index) {
+        meshes_.resize(index + 1);
+    }
+    meshes_[index] = mesh;
+    return mesh;
+}
+
+std::shared_ptr<Mesh> AssimpImporter::createMesh(int index) {
     Mesh* mesh = new Mesh();
 
     aiMesh* ai_mesh = assimp_importer_->GetScene()->mMeshes[index];
@@ -64,19 +143,58 @@ std::shared_ptr<Mesh> AssimpImporter::getMesh(int index) {
         mesh->set_tex_coords(std::move(tex_coords));
     }
 
-    std::vector<unsigned short> triangles;
+    // kept whole; the mesh picks its index size from the vertex count. A
+    // mesh without triangles, such as a scanned point cloud, keeps its
+    // lines or else its points
+    int face_size = 3;
+    if (!(ai_mesh->mPrimitiveTypes
+            & (aiPrimitiveType_TRIANGLE | aiPrimitiveType_POLYGON))) {
+        if (ai_mesh->mPrimitiveTypes & aiPrimitiveType_LINE) {
+            face_size = 2;
+            mesh->set_primitive_type(Mesh::LINES);
+        } else if (ai_mesh->mPrimitiveTypes & aiPrimitiveType_POINT) {
+            face_size = 1;
+            mesh->set_primitive_type(Mesh::POINTS);
+        }
+    }
+    std::vector<unsigned int> triangles;
     for (int i = 0; i < ai_mesh->mNumFaces; ++i) {
-        if (ai_mesh->mFaces[i].mNumIndices == 3) {
-            triangles.push_back(ai_mesh->mFaces[i].mIndices[0]);
-            triangles.push_back(ai_mesh->mFaces[i].mIndices[1]);
-            triangles.push_back(ai_mesh->mFaces[i].mIndices[2]);
+        if (ai_mesh->mFaces[i].mNumIndices == face_size) {
+            triangles.insert(triangles.end(), ai_mesh->mFaces[i].mIndices,
+                    ai_mesh->mFaces[i].mIndices + face_size);
         }
     }
     mesh->set_triangles(std::move(triangles));
+    if (face_size != 3) {
+        return std::shared_ptr < Mesh > (mesh);
+    }
+
+    MeshOptimizer::CacheStatistics before = MeshOptimizer::analyzeVertexCache(
+            mesh->triangles(), mesh->vertices().size(),
+            MeshOptimizer::CACHE_SIZE);
+    mesh->optimize(1.05f);
+    MeshOptimizer::CacheStatistics after = MeshOptimizer::analyzeVertexCache(
+            mesh->triangles(), mesh->vertices().size(),
+            MeshOptimizer::CACHE_SIZE);
+    LOGD("AssimpImporter::createMesh(%d) : ACMR %.3f -> %.3f, ATVR %.3f -> %.3f",
+            index, before.acmr, after.acmr, before.atvr, after.atvr);
 
     return std::shared_ptr < Mesh > (mesh);
 }
 
+std::vector<std::shared_ptr<Mesh>> AssimpImporter::getMeshLods(int index,
+        const std::vector<float>& ratios, std::vector<float>& errors) {
+    std::shared_ptr<Mesh> mesh = getMesh(index);
+    std::vector<std::shared_ptr<Mesh>> lods = mesh->generateLods(ratios,
+            errors);
+    for (int i = 0; i < lods.size(); ++i) {
+        LOGD("AssimpImporter::getMeshLods(%d) : %d -> %d triangles, error %f",
+                index, static_cast<int>(mesh->triangles().size() / 3),
+                static_cast<int>(lods[i]->triangles().size() / 3), errors[i]);
+    }
+    return lods;
+}
+
 void AssimpImporter::scene_recursion(aiNode* assimp_node, const aiScene* assimp_scene, std::shared_ptr<Scene> gvr_scene_pointer, JNIEnv * env, jobject default_bitmap, jobject gvr_context, jmethodID method_ID, aiMatrix4x4 accumulated_transform)
 {
     for(int i=0; i < assimp_node->mNumMeshes; i++)
@@ -162,6 +280,25 @@ void AssimpImporter::scene_recursion(aiNode* assimp_node, const aiScene* assimp_
         gvr_scene_object->attachTransform(gvr_scene_object, gvr_transform);
         gvr_scene_object->attachRenderData(gvr_scene_object, scene_object_render_data);
 
+#if !_GVRF_USE_GLES3_
+        // GLES2 has no 32-bit indices: the first part of a large mesh stays
+        // here and the others become children sharing the material
+        if (gvr_mesh->getIndexType() == GL_UNSIGNED_INT) {
+            std::vector<std::shared_ptr<Mesh>> parts = gvr_mesh->split(65536);
+            scene_object_render_data->set_mesh(parts[0]);
+            for (int j = 1; j < parts.size(); ++j) {
+                std::shared_ptr<SceneObject> part_object(new SceneObject());
+                std::shared_ptr<Transform> part_transform(new Transform());
+                part_object->attachTransform(part_object, part_transform);
+                std::shared_ptr<RenderData> part_render_data(new RenderData());
+                part_render_data->set_mesh(parts[j]);
+                part_render_data->set_material(gvr_material);
+                part_object->attachRenderData(part_object, part_render_data);
+                gvr_scene_object->addChildObject(gvr_scene_object, part_object);
+            }
+        }
+#endif
+
         //Attaches the Scene Object to the Scene.
         gvr_scene_pointer->addSceneObject(gvr_scene_object);
     }
@@ -70,10 +70,18 @@ public:
 gvr_scene_pointer, JNIEnv * env, jobject default_bitmap, jobject gvr_context, jmethodID 
 method_ID, aiMatrix4x4 accumulated_transform);
     std::shared_ptr<Scene> load_scene(JNIEnv* env, jobject obj, jobject bitmap, jobject gvr_context);
+    // may be shared with other nodes and imports; see MeshRegistry
     std::shared_ptr<Mesh> getMesh(int index);
+    // the mesh simplified to each of ratios; see Mesh::generateLods()
+    std::vector<std::shared_ptr<Mesh>> getMeshLods(int index,
+            const std::vector<float>& ratios, std::vector<float>& errors);
+
+private:
+    std::shared_ptr<Mesh> createMesh(int index);
 
 private:
     Assimp::Importer* assimp_importer_;
+    std::vector<std::weak_ptr<Mesh>> meshes_;
 };
 }
 #endif
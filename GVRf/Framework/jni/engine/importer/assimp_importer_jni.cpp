@@ -34,6 +34,11 @@ Java_org_gearvrf_NativeAssimpImporter_loadScene(JNIEnv * env,
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeAssimpImporter_getMesh(JNIEnv * env,
         jobject obj, jlong jassimp_importer, jint index);
+
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeAssimpImporter_getMeshLods(JNIEnv * env,
+        jobject obj, jlong jassimp_importer, jint index, jfloatArray ratios,
+        jfloatArray errors);
 }
 
 JNIEXPORT jint JNICALL
@@ -61,4 +66,31 @@ Java_org_gearvrf_NativeAssimpImporter_getMesh(JNIEnv * env,
     std::shared_ptr<Mesh> mesh = assimp_importer->getMesh(index);
     return reinterpret_cast<jlong>(new std::shared_ptr<Mesh>(mesh));
 }
+
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeAssimpImporter_getMeshLods(JNIEnv * env,
+        jobject obj, jlong jassimp_importer, jint index, jfloatArray ratios,
+        jfloatArray errors) {
+    std::shared_ptr<AssimpImporter> assimp_importer =
+            *reinterpret_cast<std::shared_ptr<AssimpImporter>*>(jassimp_importer);
+    jfloat* ratios_pointer = env->GetFloatArrayElements(ratios, 0);
+    std::vector<float> native_ratios(ratios_pointer,
+            ratios_pointer + env->GetArrayLength(ratios));
+    env->ReleaseFloatArrayElements(ratios, ratios_pointer, JNI_ABORT);
+
+    std::vector<float> native_errors;
+    std::vector<std::shared_ptr<Mesh>> lods = assimp_importer->getMeshLods(
+            index, native_ratios, native_errors);
+    env->SetFloatArrayRegion(errors, 0, native_errors.size(),
+            native_errors.data());
+
+    std::vector<jlong> long_lods;
+    for (auto it = lods.begin(); it != lods.end(); ++it) {
+        long_lods.push_back(
+                reinterpret_cast<jlong>(new std::shared_ptr<Mesh>(*it)));
+    }
+    jlongArray jlods = env->NewLongArray(long_lods.size());
+    env->SetLongArrayRegion(jlods, 0, long_lods.size(), long_lods.data());
+    return jlods;
+}
 }
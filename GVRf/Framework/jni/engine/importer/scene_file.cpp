@@ -0,0 +1,520 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Reads and writes scenes in the gvrf binary scene format.
+ ***************************************************************************/
+
+#include "scene_file.h"
+
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "glm/gtc/type_ptr.hpp"
+
+#include "objects/material.h"
+#include "objects/mesh.h"
+#include "objects/scene.h"
+#include "objects/scene_object.h"
+#include "objects/components/render_data.h"
+#include "objects/components/transform.h"
+#include "util/block_allocator.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+static const char MAGIC[4] = { 'G', 'V', 'R', 'S' };
+
+std::map<unsigned long long, std::shared_ptr<Mesh>> SceneFile::meshes_;
+std::map<unsigned long long, std::shared_ptr<Texture>> SceneFile::textures_;
+
+static void splitHash(unsigned long long hash, uint32_t* words) {
+    words[0] = static_cast<uint32_t>(hash);
+    words[1] = static_cast<uint32_t>(hash >> 32);
+}
+
+static unsigned long long joinHash(const uint32_t* words) {
+    return static_cast<unsigned long long>(words[0])
+            | (static_cast<unsigned long long>(words[1]) << 32);
+}
+
+static uint32_t addString(std::vector<char>& strings,
+        std::map<std::string, uint32_t>& string_offsets,
+        const std::string& string) {
+    auto it = string_offsets.find(string);
+    if (it != string_offsets.end()) {
+        return it->second;
+    }
+    uint32_t offset = strings.size();
+    strings.insert(strings.end(), string.begin(), string.end());
+    strings.push_back('\0');
+    string_offsets[string] = offset;
+    return offset;
+}
+
+static SceneFile::Property makeProperty(uint32_t key, uint32_t type,
+        const float* value, int count) {
+    SceneFile::Property property;
+    memset(&property, 0, sizeof(property));
+    property.key = key;
+    property.type = type;
+    memcpy(property.value, value, count * sizeof(float));
+    return property;
+}
+
+static void collectNodes(const std::shared_ptr<SceneObject>& scene_object,
+        int parent, std::vector<SceneObject*>& scene_objects,
+        std::vector<int>& parents) {
+    int index = scene_objects.size();
+    scene_objects.push_back(scene_object.get());
+    parents.push_back(parent);
+    std::vector<std::shared_ptr<SceneObject>> children =
+            scene_object->children();
+    for (auto it = children.begin(); it != children.end(); ++it) {
+        collectNodes(*it, index, scene_objects, parents);
+    }
+}
+
+template<class T>
+static void appendRecords(std::vector<char>& buffer, const std::vector<T>& records) {
+    if (!records.empty()) {
+        const char* data = reinterpret_cast<const char*>(records.data());
+        buffer.insert(buffer.end(), data, data + records.size() * sizeof(T));
+    }
+}
+
+template<class T>
+static const T* records(const char* data, size_t size, uint32_t offset,
+        uint32_t count) {
+    if (offset % 4 != 0 || offset > size
+            || count > (size - offset) / sizeof(T)) {
+        std::string error = "SceneFile::read() : section out of bounds";
+        throw error;
+    }
+    return reinterpret_cast<const T*>(data + offset);
+}
+
+unsigned long long SceneFile::registerMesh(const std::shared_ptr<Mesh>& mesh) {
+    unsigned long long hash = mesh->getContentHash();
+    meshes_[hash] = mesh;
+    return hash;
+}
+
+void SceneFile::registerTexture(unsigned long long hash,
+        const std::shared_ptr<Texture>& texture) {
+    textures_[hash] = texture;
+}
+
+void SceneFile::clearResources() {
+    meshes_.clear();
+    textures_.clear();
+}
+
+void SceneFile::write(Scene* scene, std::vector<char>& buffer) {
+    std::vector<SceneObject*> scene_objects;
+    std::vector<int> parents;
+    const std::vector<std::shared_ptr<SceneObject>>& roots =
+            scene->scene_objects();
+    for (auto it = roots.begin(); it != roots.end(); ++it) {
+        collectNodes(*it, -1, scene_objects, parents);
+    }
+
+    std::map<Texture*, unsigned long long> texture_hashes;
+    for (auto it = textures_.begin(); it != textures_.end(); ++it) {
+        texture_hashes[it->second.get()] = it->first;
+    }
+
+    std::vector<Node> nodes(scene_objects.size());
+    std::vector<MaterialRecord> materials;
+    std::vector<Property> properties;
+    std::vector<MeshReference> meshes;
+    std::vector<char> strings;
+    std::map<std::string, uint32_t> string_offsets;
+    std::map<Material*, int> material_indices;
+    std::map<Mesh*, int> mesh_indices;
+
+    for (int i = 0; i < scene_objects.size(); ++i) {
+        SceneObject* scene_object = scene_objects[i];
+        Node& node = nodes[i];
+        memset(&node, 0, sizeof(node));
+        node.parent = parents[i];
+        node.name = addString(strings, string_offsets, scene_object->name());
+        node.mesh = -1;
+        node.material = -1;
+
+        std::shared_ptr<Transform> transform = scene_object->transform();
+        if (transform) {
+            node.flags |= HAS_TRANSFORM;
+            memcpy(node.position, glm::value_ptr(transform->position()),
+                    sizeof(node.position));
+            node.rotation[0] = transform->rotation_w();
+            node.rotation[1] = transform->rotation_x();
+            node.rotation[2] = transform->rotation_y();
+            node.rotation[3] = transform->rotation_z();
+            memcpy(node.scale, glm::value_ptr(transform->scale()),
+                    sizeof(node.scale));
+        }
+
+        std::shared_ptr<RenderData> render_data = scene_object->render_data();
+        if (!render_data) {
+            continue;
+        }
+        node.flags |= HAS_RENDER_DATA;
+        node.flags |= render_data->cull_test() ? CULL_TEST : 0;
+        node.flags |= render_data->offset() ? OFFSET : 0;
+        node.flags |= render_data->depth_test() ? DEPTH_TEST : 0;
+        node.flags |= render_data->alpha_blend() ? ALPHA_BLEND : 0;
+        node.render_mask = render_data->render_mask();
+        node.rendering_order = render_data->rendering_order();
+        node.offset_factor = render_data->offset_factor();
+        node.offset_units = render_data->offset_units();
+
+        Mesh* mesh = render_data->mesh().get();
+        if (mesh != 0) {
+            auto it = mesh_indices.find(mesh);
+            if (it == mesh_indices.end()) {
+                MeshReference reference;
+                splitHash(mesh->getContentHash(), reference.hash);
+                it = mesh_indices.insert(
+                        std::make_pair(mesh, (int) meshes.size())).first;
+                meshes.push_back(reference);
+            }
+            node.mesh = it->second;
+        }
+
+        Material* material = render_data->material().get();
+        if (material != 0) {
+            auto it = material_indices.find(material);
+            if (it == material_indices.end()) {
+                MaterialRecord record;
+                record.shader_type = material->shader_type();
+                record.first_property = properties.size();
+
+                for (auto t = material->textures().begin();
+                        t != material->textures().end(); ++t) {
+                    auto hash = texture_hashes.find(t->second.get());
+                    if (hash == texture_hashes.end()) {
+                        LOGW("SceneFile::write() : texture %s is not registered",
+                                t->first.c_str());
+                        continue;
+                    }
+                    Property property = makeProperty(
+                            addString(strings, string_offsets, t->first),
+                            TEXTURE, 0, 0);
+                    splitHash(hash->second, property.hash);
+                    properties.push_back(property);
+                }
+                for (auto f = material->floats().begin();
+                        f != material->floats().end(); ++f) {
+                    properties.push_back(
+                            makeProperty(
+                                    addString(strings, string_offsets,
+                                            f->first), FLOAT, &f->second, 1));
+                }
+                for (auto v = material->vec2s().begin();
+                        v != material->vec2s().end(); ++v) {
+                    properties.push_back(
+                            makeProperty(
+                                    addString(strings, string_offsets,
+                                            v->first), VEC2,
+                                    glm::value_ptr(v->second), 2));
+                }
+                for (auto v = material->vec3s().begin();
+                        v != material->vec3s().end(); ++v) {
+                    properties.push_back(
+                            makeProperty(
+                                    addString(strings, string_offsets,
+                                            v->first), VEC3,
+                                    glm::value_ptr(v->second), 3));
+                }
+                for (auto v = material->vec4s().begin();
+                        v != material->vec4s().end(); ++v) {
+                    properties.push_back(
+                            makeProperty(
+                                    addString(strings, string_offsets,
+                                            v->first), VEC4,
+                                    glm::value_ptr(v->second), 4));
+                }
+                for (auto m = material->mat4s().begin();
+                        m != material->mat4s().end(); ++m) {
+                    properties.push_back(
+                            makeProperty(
+                                    addString(strings, string_offsets,
+                                            m->first), MAT4,
+                                    glm::value_ptr(m->second), 16));
+                }
+
+                record.property_count = properties.size()
+                        - record.first_property;
+                it = material_indices.insert(
+                        std::make_pair(material, (int) materials.size())).first;
+                materials.push_back(record);
+            }
+            node.material = it->second;
+        }
+    }
+
+    while (strings.size() % 4 != 0) {
+        strings.push_back('\0');
+    }
+
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.node_count = nodes.size();
+    header.node_offset = sizeof(Header);
+    header.material_count = materials.size();
+    header.material_offset = header.node_offset + nodes.size() * sizeof(Node);
+    header.property_count = properties.size();
+    header.property_offset = header.material_offset
+            + materials.size() * sizeof(MaterialRecord);
+    header.mesh_count = meshes.size();
+    header.mesh_offset = header.property_offset
+            + properties.size() * sizeof(Property);
+    header.string_size = strings.size();
+    header.string_offset = header.mesh_offset
+            + meshes.size() * sizeof(MeshReference);
+
+    buffer.clear();
+    buffer.reserve(header.string_offset + header.string_size);
+    const char* header_data = reinterpret_cast<const char*>(&header);
+    buffer.insert(buffer.end(), header_data, header_data + sizeof(Header));
+    appendRecords(buffer, nodes);
+    appendRecords(buffer, materials);
+    appendRecords(buffer, properties);
+    appendRecords(buffer, meshes);
+    appendRecords(buffer, strings);
+}
+
+void SceneFile::writeToFile(Scene* scene, const std::string& path) {
+    std::vector<char> buffer;
+    write(scene, buffer);
+
+    std::ofstream ofs(path.c_str(), std::ios::out | std::ios::binary);
+    ofs.write(buffer.data(), buffer.size());
+    ofs.close();
+    if (!ofs) {
+        std::string error = "SceneFile::writeToFile() : cannot write " + path;
+        throw error;
+    }
+}
+
+std::vector<std::shared_ptr<SceneObject>> SceneFile::read(const char* data,
+        size_t size) {
+    // records hold floats, which must not be read unaligned
+    std::vector<uint32_t> aligned_copy;
+    if (reinterpret_cast<uintptr_t>(data) % 4 != 0) {
+        aligned_copy.resize((size + 3) / 4);
+        memcpy(aligned_copy.data(), data, size);
+        data = reinterpret_cast<const char*>(aligned_copy.data());
+    }
+
+    if (size < sizeof(Header)) {
+        std::string error = "SceneFile::read() : file too small";
+        throw error;
+    }
+    const Header& header = *reinterpret_cast<const Header*>(data);
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+            || header.version != VERSION) {
+        std::string error = "SceneFile::read() : not a scene file";
+        throw error;
+    }
+
+    const Node* nodes = records<Node>(data, size, header.node_offset,
+            header.node_count);
+    const MaterialRecord* material_records = records<MaterialRecord>(data,
+            size, header.material_offset, header.material_count);
+    const Property* properties = records<Property>(data, size,
+            header.property_offset, header.property_count);
+    const MeshReference* mesh_references = records<MeshReference>(data, size,
+            header.mesh_offset, header.mesh_count);
+    const char* strings = records<char>(data, size, header.string_offset,
+            header.string_size);
+    if (header.string_size == 0 || strings[header.string_size - 1] != '\0') {
+        std::string error = "SceneFile::read() : bad string table";
+        throw error;
+    }
+
+    // every object of the file comes out of one block
+    std::shared_ptr<MemoryBlock> block(
+            new MemoryBlock(
+                    header.node_count
+                            * (sharedAllocationSize<SceneObject>()
+                                    + sharedAllocationSize<Transform>()
+                                    + sharedAllocationSize<RenderData>())
+                            + header.material_count
+                                    * sharedAllocationSize<Material>()));
+    BlockAllocator<SceneObject> allocator(block);
+
+    std::vector<std::shared_ptr<Mesh>> meshes(header.mesh_count);
+    for (int i = 0; i < header.mesh_count; ++i) {
+        auto it = meshes_.find(joinHash(mesh_references[i].hash));
+        if (it != meshes_.end()) {
+            meshes[i] = it->second;
+        } else {
+            LOGW("SceneFile::read() : mesh %d is not registered", i);
+        }
+    }
+
+    std::vector<std::shared_ptr<Material>> materials(header.material_count);
+    for (int i = 0; i < header.material_count; ++i) {
+        const MaterialRecord& record = material_records[i];
+        if (record.first_property > header.property_count
+                || record.property_count
+                        > header.property_count - record.first_property) {
+            std::string error = "SceneFile::read() : bad material";
+            throw error;
+        }
+        std::shared_ptr<Material> material = std::allocate_shared<Material>(
+                allocator,
+                static_cast<Material::ShaderType>(record.shader_type));
+        for (int j = 0; j < record.property_count; ++j) {
+            const Property& property = properties[record.first_property + j];
+            if (property.key >= header.string_size) {
+                std::string error = "SceneFile::read() : bad property key";
+                throw error;
+            }
+            std::string key(strings + property.key);
+            switch (property.type) {
+            case TEXTURE: {
+                auto it = textures_.find(joinHash(property.hash));
+                if (it != textures_.end()) {
+                    material->setTexture(key, it->second);
+                } else {
+                    LOGW("SceneFile::read() : texture %s is not registered",
+                            key.c_str());
+                }
+                break;
+            }
+            case FLOAT:
+                material->setFloat(key, property.value[0]);
+                break;
+            case VEC2:
+                material->setVec2(key, glm::make_vec2(property.value));
+                break;
+            case VEC3:
+                material->setVec3(key, glm::make_vec3(property.value));
+                break;
+            case VEC4:
+                material->setVec4(key, glm::make_vec4(property.value));
+                break;
+            case MAT4:
+                material->setMat4(key, glm::make_mat4(property.value));
+                break;
+            default:
+                LOGW("SceneFile::read() : unknown property type %d",
+                        property.type);
+                break;
+            }
+        }
+        materials[i] = material;
+    }
+
+    std::vector<std::shared_ptr<SceneObject>> scene_objects;
+    std::vector<std::shared_ptr<SceneObject>> roots;
+    scene_objects.reserve(header.node_count);
+    for (int i = 0; i < header.node_count; ++i) {
+        const Node& node = nodes[i];
+        if (node.parent < -1 || node.parent >= i
+                || node.name >= header.string_size
+                || node.mesh >= (int) header.mesh_count
+                || node.material >= (int) header.material_count) {
+            std::string error = "SceneFile::read() : bad node";
+            throw error;
+        }
+
+        std::shared_ptr<SceneObject> scene_object = std::allocate_shared<
+                SceneObject>(allocator);
+        scene_object->set_name(strings + node.name);
+
+        if (node.flags & HAS_TRANSFORM) {
+            std::shared_ptr<Transform> transform = std::allocate_shared<
+                    Transform>(allocator);
+            transform->set_position(glm::make_vec3(node.position));
+            transform->set_rotation(node.rotation[0], node.rotation[1],
+                    node.rotation[2], node.rotation[3]);
+            transform->set_scale(glm::make_vec3(node.scale));
+            scene_object->attachTransform(scene_object, transform);
+        }
+
+        if (node.flags & HAS_RENDER_DATA) {
+            std::shared_ptr<RenderData> render_data = std::allocate_shared<
+                    RenderData>(allocator);
+            render_data->set_cull_test(node.flags & CULL_TEST);
+            render_data->set_offset(node.flags & OFFSET);
+            render_data->set_depth_test(node.flags & DEPTH_TEST);
+            render_data->set_alpha_blend(node.flags & ALPHA_BLEND);
+            render_data->set_render_mask(node.render_mask);
+            render_data->set_rendering_order(node.rendering_order);
+            render_data->set_offset_factor(node.offset_factor);
+            render_data->set_offset_units(node.offset_units);
+            if (node.mesh >= 0) {
+                render_data->set_mesh(meshes[node.mesh]);
+            }
+            if (node.material >= 0) {
+                render_data->set_material(materials[node.material]);
+            }
+            scene_object->attachRenderData(scene_object, render_data);
+        }
+
+        if (node.parent >= 0) {
+            scene_objects[node.parent]->addChildObject(
+                    scene_objects[node.parent], scene_object);
+        } else {
+            roots.push_back(scene_object);
+        }
+        scene_objects.push_back(scene_object);
+    }
+
+    return roots;
+}
+
+std::vector<std::shared_ptr<SceneObject>> SceneFile::readFile(
+        const std::string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::string error = "SceneFile::readFile() : cannot open " + path;
+        throw error;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        close(fd);
+        std::string error = "SceneFile::readFile() : cannot stat " + path;
+        throw error;
+    }
+    size_t size = file_stat.st_size;
+    void* data = mmap(0, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        std::string error = "SceneFile::readFile() : cannot map " + path;
+        throw error;
+    }
+
+    try {
+        std::vector<std::shared_ptr<SceneObject>> roots = read(
+                static_cast<const char*>(data), size);
+        munmap(data, size);
+        return roots;
+    } catch (...) {
+        munmap(data, size);
+        throw;
+    }
+}
+
+}
@@ -0,0 +1,138 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Reads and writes scenes in the gvrf binary scene format.
+ ***************************************************************************/
+
+#ifndef SCENE_FILE_H_
+#define SCENE_FILE_H_
+
+#include <map>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace gvr {
+class Material;
+class Mesh;
+class Scene;
+class SceneObject;
+class Texture;
+
+/*
+ * The file is a header followed by flat arrays of fixed-size records and a
+ * string table, all 4-byte aligned, so a memory-mapped file is read in
+ * place. Nodes are stored depth first, so a parent always precedes its
+ * children. Meshes and textures are not embedded; they are referenced by
+ * content hash and resolved against the registered resources at load time.
+ */
+class SceneFile {
+private:
+    SceneFile();
+
+public:
+    static const uint32_t VERSION = 1;
+
+    enum NodeFlags {
+        HAS_TRANSFORM = 0x1,
+        HAS_RENDER_DATA = 0x2,
+        CULL_TEST = 0x4,
+        OFFSET = 0x8,
+        DEPTH_TEST = 0x10,
+        ALPHA_BLEND = 0x20
+    };
+
+    enum PropertyType {
+        TEXTURE = 0, FLOAT = 1, VEC2 = 2, VEC3 = 3, VEC4 = 4, MAT4 = 16
+    };
+
+    struct Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t node_count;
+        uint32_t node_offset;
+        uint32_t material_count;
+        uint32_t material_offset;
+        uint32_t property_count;
+        uint32_t property_offset;
+        uint32_t mesh_count;
+        uint32_t mesh_offset;
+        uint32_t string_size;
+        uint32_t string_offset;
+    };
+
+    struct Node {
+        int32_t parent;
+        uint32_t name;
+        uint32_t flags;
+        float position[3];
+        float rotation[4];
+        float scale[3];
+        int32_t mesh;
+        int32_t material;
+        int32_t render_mask;
+        int32_t rendering_order;
+        float offset_factor;
+        float offset_units;
+    };
+
+    struct MaterialRecord {
+        int32_t shader_type;
+        uint32_t first_property;
+        uint32_t property_count;
+    };
+
+    struct Property {
+        uint32_t key;
+        uint32_t type;
+        uint32_t hash[2];
+        float value[16];
+    };
+
+    struct MeshReference {
+        uint32_t hash[2];
+    };
+
+    // the mesh is registered under its content hash, which is returned
+    static unsigned long long registerMesh(const std::shared_ptr<Mesh>& mesh);
+    static void registerTexture(unsigned long long hash,
+            const std::shared_ptr<Texture>& texture);
+    static void clearResources();
+
+    static void write(Scene* scene, std::vector<char>& buffer);
+    static void writeToFile(Scene* scene, const std::string& path);
+
+    // returns the root objects; throws if the data is not a scene file
+    static std::vector<std::shared_ptr<SceneObject>> read(const char* data,
+            size_t size);
+    static std::vector<std::shared_ptr<SceneObject>> readFile(
+            const std::string& path);
+
+private:
+    SceneFile(const SceneFile& scene_file);
+    SceneFile(SceneFile&& scene_file);
+    SceneFile& operator=(const SceneFile& scene_file);
+    SceneFile& operator=(SceneFile&& scene_file);
+
+private:
+    static std::map<unsigned long long, std::shared_ptr<Mesh>> meshes_;
+    static std::map<unsigned long long, std::shared_ptr<Texture>> textures_;
+};
+
+}
+#endif
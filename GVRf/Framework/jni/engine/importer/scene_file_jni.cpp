@@ -0,0 +1,145 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "scene_file.h"
+
+#include "android/asset_manager_jni.h"
+
+#include "objects/mesh.h"
+#include "objects/scene.h"
+#include "objects/scene_object.h"
+#include "objects/textures/texture.h"
+#include "util/gvr_jni.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeSceneFile_registerMesh(JNIEnv * env,
+        jobject obj, jlong jmesh);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneFile_registerTexture(JNIEnv * env,
+        jobject obj, jlong hash, jlong jtexture);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneFile_clearResources(JNIEnv * env,
+        jobject obj);
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneFile_writeToFile(JNIEnv * env,
+        jobject obj, jlong jscene, jstring path);
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeSceneFile_readFileFromAssets(JNIEnv * env,
+        jobject obj, jobject asset_manager, jstring filename);
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeSceneFile_readFileFromSDCard(JNIEnv * env,
+        jobject obj, jstring path);
+}
+
+static jlongArray toSceneObjectArray(JNIEnv * env,
+        const std::vector<std::shared_ptr<SceneObject>>& scene_objects) {
+    std::vector<jlong> pointers(scene_objects.size());
+    for (int i = 0; i < scene_objects.size(); ++i) {
+        pointers[i] = reinterpret_cast<jlong>(new std::shared_ptr<SceneObject>(
+                scene_objects[i]));
+    }
+    jlongArray jpointers = env->NewLongArray(pointers.size());
+    env->SetLongArrayRegion(jpointers, 0, pointers.size(), pointers.data());
+    return jpointers;
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeSceneFile_registerMesh(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    std::shared_ptr<Mesh> mesh = *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    return static_cast<jlong>(SceneFile::registerMesh(mesh));
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneFile_registerTexture(JNIEnv * env,
+        jobject obj, jlong hash, jlong jtexture) {
+    std::shared_ptr<Texture> texture =
+            *reinterpret_cast<std::shared_ptr<Texture>*>(jtexture);
+    SceneFile::registerTexture(static_cast<unsigned long long>(hash), texture);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneFile_clearResources(JNIEnv * env,
+        jobject obj) {
+    SceneFile::clearResources();
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneFile_writeToFile(JNIEnv * env,
+        jobject obj, jlong jscene, jstring path) {
+    std::shared_ptr<Scene> scene =
+            *reinterpret_cast<std::shared_ptr<Scene>*>(jscene);
+    const char* native_path = env->GetStringUTFChars(path, 0);
+    std::string path_string(native_path);
+    env->ReleaseStringUTFChars(path, native_path);
+    try {
+        SceneFile::writeToFile(scene.get(), path_string);
+        return JNI_TRUE;
+    } catch (std::string error) {
+        LOGE("%s", error.c_str());
+        return JNI_FALSE;
+    }
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeSceneFile_readFileFromAssets(JNIEnv * env,
+        jobject obj, jobject asset_manager, jstring filename) {
+    const char* native_string = env->GetStringUTFChars(filename, 0);
+    AAssetManager* mgr = AAssetManager_fromJava(env, asset_manager);
+    AAsset* asset = AAssetManager_open(mgr, native_string, AASSET_MODE_BUFFER);
+    env->ReleaseStringUTFChars(filename, native_string);
+    if (NULL == asset) {
+        LOGE("_ASSET_NOT_FOUND_");
+        return 0;
+    }
+
+    jlongArray jscene_objects = 0;
+    // uncompressed assets are mapped straight from the apk
+    const char* buffer = static_cast<const char*>(AAsset_getBuffer(asset));
+    if (buffer != NULL) {
+        try {
+            jscene_objects = toSceneObjectArray(env,
+                    SceneFile::read(buffer, AAsset_getLength(asset)));
+        } catch (std::string error) {
+            LOGE("%s", error.c_str());
+        }
+    }
+    AAsset_close(asset);
+    return jscene_objects;
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeSceneFile_readFileFromSDCard(JNIEnv * env,
+        jobject obj, jstring path) {
+    const char* native_path = env->GetStringUTFChars(path, 0);
+    std::string path_string(native_path);
+    env->ReleaseStringUTFChars(path, native_path);
+    try {
+        return toSceneObjectArray(env, SceneFile::readFile(path_string));
+    } catch (std::string error) {
+        LOGE("%s", error.c_str());
+        return 0;
+    }
+}
+
+}
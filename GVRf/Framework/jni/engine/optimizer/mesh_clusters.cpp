@@ -0,0 +1,156 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Splits the triangles of a mesh into clusters that are culled separately.
+ ***************************************************************************/
+
+#include "mesh_clusters.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace gvr {
+// clusters narrower than this cone, about 60 degrees, cull well by facing
+static const float MAX_CONE_COS = 0.5f;
+
+static MeshCluster finishCluster(const std::vector<unsigned int>& indices,
+        const std::vector<glm::vec3>& vertices, int first, int end) {
+    MeshCluster cluster;
+    cluster.first_index = first;
+    cluster.index_count = end - first;
+    cluster.min_vertex = std::numeric_limits<unsigned int>::max();
+    cluster.max_vertex = 0;
+
+    glm::vec3 min(std::numeric_limits<float>::max());
+    glm::vec3 max(-std::numeric_limits<float>::max());
+    for (int i = first; i < end; ++i) {
+        cluster.min_vertex = std::min(cluster.min_vertex, indices[i]);
+        cluster.max_vertex = std::max(cluster.max_vertex, indices[i]);
+        min = glm::min(min, vertices[indices[i]]);
+        max = glm::max(max, vertices[indices[i]]);
+    }
+    glm::vec3 center = (min + max) * 0.5f;
+    float radius = 0.0f;
+    for (int i = first; i < end; ++i) {
+        radius = std::max(radius,
+                glm::length(vertices[indices[i]] - center));
+    }
+    cluster.sphere = glm::vec4(center, radius);
+
+    std::vector<glm::vec3> normals;
+    normals.reserve((end - first) / 3);
+    glm::vec3 sum(0.0f);
+    for (int i = first; i < end; i += 3) {
+        const glm::vec3& p0 = vertices[indices[i]];
+        glm::vec3 normal = glm::cross(vertices[indices[i + 1]] - p0,
+                vertices[indices[i + 2]] - p0);
+        float length = glm::length(normal);
+        if (length > 0.0f) {
+            normals.push_back(normal / length);
+            sum += normals.back();
+        }
+    }
+    float sum_length = glm::length(sum);
+    cluster.cone_axis = sum_length > 0.0f ? sum / sum_length : glm::vec3(0.0f);
+    cluster.cone_cutoff = 1.0f;
+    if (sum_length > 0.0f) {
+        float min_cos = 1.0f;
+        for (auto it = normals.begin(); it != normals.end(); ++it) {
+            min_cos = std::min(min_cos, glm::dot(*it, cluster.cone_axis));
+        }
+        // a cone of 90 degrees or more has a triangle facing any camera
+        if (min_cos > 0.0f) {
+            cluster.cone_cutoff = sqrtf(1.0f - min_cos * min_cos);
+        }
+    }
+    return cluster;
+}
+
+std::vector<MeshCluster> MeshClusters::build(
+        const std::vector<unsigned int>& indices,
+        const std::vector<glm::vec3>& vertices) {
+    std::vector<MeshCluster> clusters;
+    std::vector<int> marks(vertices.size(), -1);
+    int first = 0;
+    int triangle_count = 0;
+    glm::vec3 normal_sum(0.0f);
+    int index_count = indices.size() - indices.size() % 3;
+    for (int i = 0; i < index_count; i += 3) {
+        bool connected = false;
+        for (int j = 0; j < 3; ++j) {
+            if (indices[i + j] >= vertices.size()) {
+                std::string error =
+                        "MeshClusters::build() : index out of range";
+                throw error;
+            }
+            connected = connected || marks[indices[i + j]] == first;
+        }
+        const glm::vec3& p0 = vertices[indices[i]];
+        glm::vec3 normal = glm::cross(vertices[indices[i + 1]] - p0,
+                vertices[indices[i + 2]] - p0);
+        float length = glm::length(normal);
+        normal = length > 0.0f ? normal / length : normal;
+        float sum_length = glm::length(normal_sum);
+        bool turned = sum_length > 0.0f
+                && glm::dot(normal, normal_sum) < MAX_CONE_COS * sum_length;
+
+        if (triangle_count == MAX_TRIANGLES
+                || (triangle_count >= MIN_TRIANGLES && (!connected || turned))) {
+            clusters.push_back(finishCluster(indices, vertices, first, i));
+            first = i;
+            triangle_count = 0;
+            normal_sum = glm::vec3(0.0f);
+        }
+        for (int j = 0; j < 3; ++j) {
+            marks[indices[i + j]] = first;
+        }
+        normal_sum += normal;
+        ++triangle_count;
+    }
+    if (triangle_count > 0) {
+        clusters.push_back(
+                finishCluster(indices, vertices, first, index_count));
+    }
+    return clusters;
+}
+
+bool MeshClusters::isVisible(const MeshCluster& cluster,
+        const glm::vec4* frustum, const glm::vec3& camera_position,
+        bool backface_culling) {
+    glm::vec3 center(cluster.sphere);
+    float radius = cluster.sphere.w;
+    for (int i = 0; i < 6; ++i) {
+        if (glm::dot(glm::vec3(frustum[i]), center) + frustum[i].w
+                < -radius) {
+            return false;
+        }
+    }
+
+    // conservative for any point of the bounding sphere
+    if (backface_culling && cluster.cone_cutoff < 1.0f) {
+        glm::vec3 to_center = center - camera_position;
+        if (glm::dot(to_center, cluster.cone_axis)
+                >= cluster.cone_cutoff * glm::length(to_center) + radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
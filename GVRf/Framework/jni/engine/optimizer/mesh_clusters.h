@@ -0,0 +1,79 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Splits the triangles of a mesh into clusters that are culled separately.
+ ***************************************************************************/
+
+#ifndef MESH_CLUSTERS_H_
+#define MESH_CLUSTERS_H_
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace gvr {
+
+struct MeshCluster {
+    // the cluster's triangles are indices [first_index, first_index +
+    // index_count), using the vertices [min_vertex, max_vertex]
+    int first_index;
+    int index_count;
+    unsigned int min_vertex;
+    unsigned int max_vertex;
+
+    glm::vec4 sphere;
+
+    // every triangle normal is within the cone around cone_axis whose half
+    // angle has the sine cone_cutoff; 1 when the cone is too wide to cull
+    glm::vec3 cone_axis;
+    float cone_cutoff;
+};
+
+/*
+ * Clusters are runs of consecutive triangles, so a mesh ordered by
+ * MeshOptimizer yields compact patches and each cluster is a single
+ * index range to draw.
+ */
+class MeshClusters {
+private:
+    MeshClusters();
+
+public:
+    static const int MAX_TRIANGLES = 124;
+    static const int MIN_TRIANGLES = 32;
+
+    /*
+     * Starts a cluster at MAX_TRIANGLES triangles, or after MIN_TRIANGLES
+     * at a triangle that shares no vertex with the cluster so far or faces
+     * too far from its average normal.
+     */
+    static std::vector<MeshCluster> build(
+            const std::vector<unsigned int>& indices,
+            const std::vector<glm::vec3>& vertices);
+
+    /*
+     * Tests the cluster against the frustum planes (normals pointing
+     * inward) and, with backface_culling, whether every triangle faces away
+     * from the camera. All in the space of the mesh.
+     */
+    static bool isVisible(const MeshCluster& cluster,
+            const glm::vec4* frustum, const glm::vec3& camera_position,
+            bool backface_culling);
+};
+
+}
+#endif
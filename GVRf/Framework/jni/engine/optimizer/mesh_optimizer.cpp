@@ -0,0 +1,329 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Reorders the triangles and vertices of a mesh for the GPU caches.
+ ***************************************************************************/
+
+#include "mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace gvr {
+static const float CACHE_DECAY_POWER = 1.5f;
+static const float LAST_TRIANGLE_SCORE = 0.75f;
+static const float VALENCE_BOOST_SCALE = 2.0f;
+static const float VALENCE_BOOST_POWER = 0.5f;
+static const unsigned int NO_VERTEX = static_cast<unsigned int>(-1);
+
+static void checkIndices(const std::vector<unsigned int>& indices,
+        int vertex_count, const char* method) {
+    for (auto it = indices.begin(); it != indices.end(); ++it) {
+        if (*it >= vertex_count) {
+            std::string error = std::string("MeshOptimizer::") + method
+                    + "() : index out of range";
+            throw error;
+        }
+    }
+}
+
+// Forsyth, "Linear-Speed Vertex Cache Optimisation"
+static float vertexScore(int cache_position, int valence) {
+    if (valence == 0) {
+        return -1.0f;
+    }
+    float score = 0.0f;
+    if (cache_position >= 0) {
+        if (cache_position < 3) {
+            // the last triangle's vertices, wherever it goes next
+            score = LAST_TRIANGLE_SCORE;
+        } else {
+            score = powf(
+                    1.0f
+                            - static_cast<float>(cache_position - 3)
+                                    / (MeshOptimizer::CACHE_SIZE - 3),
+                    CACHE_DECAY_POWER);
+        }
+    }
+    // favors finishing off vertices with few triangles left
+    return score
+            + VALENCE_BOOST_SCALE
+                    * powf(static_cast<float>(valence), -VALENCE_BOOST_POWER);
+}
+
+MeshOptimizer::CacheStatistics MeshOptimizer::analyzeVertexCache(
+        const std::vector<unsigned int>& indices, int vertex_count,
+        int cache_size) {
+    checkIndices(indices, vertex_count, "analyzeVertexCache");
+    CacheStatistics statistics = { 0.0f, 0.0f };
+    if (indices.size() < 3) {
+        return statistics;
+    }
+
+    // a vertex is in the cache while fewer than cache_size misses followed
+    // its own
+    std::vector<unsigned int> timestamps(vertex_count, 0);
+    unsigned int time = cache_size + 1;
+    int misses = 0;
+    int used_vertices = 0;
+    for (auto it = indices.begin(); it != indices.end(); ++it) {
+        if (timestamps[*it] == 0) {
+            ++used_vertices;
+        }
+        if (time - timestamps[*it] > cache_size) {
+            timestamps[*it] = time++;
+            ++misses;
+        }
+    }
+    statistics.acmr = static_cast<float>(misses) / (indices.size() / 3);
+    statistics.atvr = static_cast<float>(misses) / used_vertices;
+    return statistics;
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<unsigned int>& indices,
+        int vertex_count) {
+    checkIndices(indices, vertex_count, "optimizeVertexCache");
+    int triangle_count = indices.size() / 3;
+    if (triangle_count < 2) {
+        return;
+    }
+
+    // the triangles not yet emitted of each vertex, packed; valence is
+    // the length of each list
+    std::vector<int> valence(vertex_count, 0);
+    for (int i = 0; i < triangle_count * 3; ++i) {
+        ++valence[indices[i]];
+    }
+    std::vector<int> offsets(vertex_count + 1, 0);
+    for (int i = 0; i < vertex_count; ++i) {
+        offsets[i + 1] = offsets[i] + valence[i];
+    }
+    std::vector<int> vertex_triangles(triangle_count * 3);
+    std::vector<int> fill(offsets.begin(), offsets.end() - 1);
+    for (int i = 0; i < triangle_count * 3; ++i) {
+        vertex_triangles[fill[indices[i]]++] = i / 3;
+    }
+
+    std::vector<int> cache_positions(vertex_count, -1);
+    std::vector<float> vertex_scores(vertex_count);
+    for (int i = 0; i < vertex_count; ++i) {
+        vertex_scores[i] = vertexScore(-1, valence[i]);
+    }
+    std::vector<float> triangle_scores(triangle_count);
+    for (int i = 0; i < triangle_count; ++i) {
+        triangle_scores[i] = vertex_scores[indices[i * 3]]
+                + vertex_scores[indices[i * 3 + 1]]
+                + vertex_scores[indices[i * 3 + 2]];
+    }
+
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<unsigned int> result;
+    result.reserve(triangle_count * 3);
+    std::vector<unsigned int> cache;
+    std::vector<unsigned int> new_cache;
+    cache.reserve(CACHE_SIZE + 3);
+    new_cache.reserve(CACHE_SIZE + 3);
+    int best = -1;
+    int next = 0;
+    for (int count = 0; count < triangle_count; ++count) {
+        if (best < 0) {
+            // no cached vertex has triangles left; start over in file order
+            while (emitted[next]) {
+                ++next;
+            }
+            best = next;
+        }
+        emitted[best] = true;
+        const unsigned int* triangle = &indices[best * 3];
+        result.insert(result.end(), triangle, triangle + 3);
+
+        for (int j = 0; j < 3; ++j) {
+            int* begin = &vertex_triangles[offsets[triangle[j]]];
+            int* end = begin + valence[triangle[j]];
+            int* found = std::find(begin, end, best);
+            if (found != end) {
+                *found = *(end - 1);
+                --valence[triangle[j]];
+            }
+        }
+
+        new_cache.clear();
+        for (int j = 0; j < 3; ++j) {
+            if (std::find(new_cache.begin(), new_cache.end(), triangle[j])
+                    == new_cache.end()) {
+                new_cache.push_back(triangle[j]);
+            }
+        }
+        for (auto it = cache.begin(); it != cache.end(); ++it) {
+            if (*it != triangle[0] && *it != triangle[1]
+                    && *it != triangle[2]) {
+                new_cache.push_back(*it);
+            }
+        }
+
+        // vertices pushed past the end of the cache are rescored as
+        // evicted, then dropped
+        for (int i = 0; i < new_cache.size(); ++i) {
+            unsigned int vertex = new_cache[i];
+            cache_positions[vertex] = i < CACHE_SIZE ? i : -1;
+            float score = vertexScore(cache_positions[vertex], valence[vertex]);
+            float delta = score - vertex_scores[vertex];
+            vertex_scores[vertex] = score;
+            const int* live = &vertex_triangles[offsets[vertex]];
+            for (int k = 0; k < valence[vertex]; ++k) {
+                triangle_scores[live[k]] += delta;
+            }
+        }
+        if (new_cache.size() > CACHE_SIZE) {
+            new_cache.resize(CACHE_SIZE);
+        }
+        cache.swap(new_cache);
+
+        best = -1;
+        float best_score = -1.0f;
+        for (auto it = cache.begin(); it != cache.end(); ++it) {
+            const int* live = &vertex_triangles[offsets[*it]];
+            for (int k = 0; k < valence[*it]; ++k) {
+                if (triangle_scores[live[k]] > best_score) {
+                    best_score = triangle_scores[live[k]];
+                    best = live[k];
+                }
+            }
+        }
+    }
+
+    // a trailing partial triangle is kept as it was
+    result.insert(result.end(), indices.begin() + triangle_count * 3,
+            indices.end());
+    indices.swap(result);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<unsigned int>& indices,
+        const std::vector<glm::vec3>& vertices, float threshold) {
+    int vertex_count = vertices.size();
+    checkIndices(indices, vertex_count, "optimizeOverdraw");
+    int triangle_count = indices.size() / 3;
+    if (triangle_count < 2) {
+        return;
+    }
+    float mesh_acmr =
+            analyzeVertexCache(indices, vertex_count, CACHE_SIZE).acmr;
+
+    std::vector<int> cluster_starts;
+    std::vector<unsigned int> timestamps(vertex_count, 0);
+    unsigned int time = CACHE_SIZE + 1;
+    int cluster_misses = 0;
+    for (int i = 0; i < triangle_count; ++i) {
+        int misses = 0;
+        for (int j = 0; j < 3; ++j) {
+            unsigned int vertex = indices[i * 3 + j];
+            if (time - timestamps[vertex] > CACHE_SIZE) {
+                timestamps[vertex] = time++;
+                ++misses;
+            }
+        }
+        int cluster_size = cluster_starts.empty() ? 0 : i - cluster_starts.back();
+        if (cluster_starts.empty() || misses == 3
+                || (misses == 2
+                        && cluster_misses < threshold * mesh_acmr * cluster_size)) {
+            cluster_starts.push_back(i);
+            cluster_misses = 0;
+        }
+        cluster_misses += misses;
+    }
+    if (cluster_starts.size() < 2) {
+        return;
+    }
+    cluster_starts.push_back(triangle_count);
+
+    // area weighted, so slivers do not skew the centers and normals
+    glm::vec3 mesh_center;
+    float mesh_area = 0.0f;
+    std::vector<glm::vec3> cluster_centers(cluster_starts.size() - 1);
+    std::vector<glm::vec3> cluster_normals(cluster_starts.size() - 1);
+    for (int c = 0; c + 1 < cluster_starts.size(); ++c) {
+        glm::vec3 center;
+        glm::vec3 normal;
+        float area = 0.0f;
+        for (int i = cluster_starts[c]; i < cluster_starts[c + 1]; ++i) {
+            const glm::vec3& a = vertices[indices[i * 3]];
+            const glm::vec3& b = vertices[indices[i * 3 + 1]];
+            const glm::vec3& v = vertices[indices[i * 3 + 2]];
+            glm::vec3 cross = glm::cross(b - a, v - a);
+            float triangle_area = glm::length(cross);
+            center += (a + b + v) * (triangle_area / 3.0f);
+            normal += cross;
+            area += triangle_area;
+        }
+        mesh_center += center;
+        mesh_area += area;
+        cluster_centers[c] = area > 0.0f ? center / area : center;
+        cluster_normals[c] = normal;
+    }
+    if (mesh_area > 0.0f) {
+        mesh_center /= mesh_area;
+    }
+
+    // clusters facing out from the center go first; they tend to hide the
+    // ones facing in
+    std::vector<std::pair<float, int>> order;
+    order.reserve(cluster_centers.size());
+    for (int c = 0; c < cluster_centers.size(); ++c) {
+        float length = glm::length(cluster_normals[c]);
+        float key = length > 0.0f ?
+                glm::dot(cluster_centers[c] - mesh_center,
+                        cluster_normals[c] / length) :
+                0.0f;
+        order.push_back(std::make_pair(-key, c));
+    }
+    std::stable_sort(order.begin(), order.end());
+
+    std::vector<unsigned int> result;
+    result.reserve(indices.size());
+    for (auto it = order.begin(); it != order.end(); ++it) {
+        result.insert(result.end(),
+                indices.begin() + cluster_starts[it->second] * 3,
+                indices.begin() + cluster_starts[it->second + 1] * 3);
+    }
+    result.insert(result.end(), indices.begin() + triangle_count * 3,
+            indices.end());
+    indices.swap(result);
+}
+
+std::vector<unsigned int> MeshOptimizer::optimizeVertexFetch(
+        std::vector<unsigned int>& indices, int vertex_count) {
+    checkIndices(indices, vertex_count, "optimizeVertexFetch");
+    std::vector<unsigned int> remap(vertex_count, NO_VERTEX);
+    std::vector<unsigned int> order;
+    order.reserve(vertex_count);
+    for (auto it = indices.begin(); it != indices.end(); ++it) {
+        if (remap[*it] == NO_VERTEX) {
+            remap[*it] = order.size();
+            order.push_back(*it);
+        }
+        *it = remap[*it];
+    }
+    for (int i = 0; i < vertex_count; ++i) {
+        if (remap[i] == NO_VERTEX) {
+            order.push_back(i);
+        }
+    }
+    return order;
+}
+
+}
@@ -0,0 +1,80 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Reorders the triangles and vertices of a mesh for the GPU caches.
+ ***************************************************************************/
+
+#ifndef MESH_OPTIMIZER_H_
+#define MESH_OPTIMIZER_H_
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace gvr {
+
+/*
+ * The three passes are meant to run in order: vertex cache ordering of the
+ * triangles (Forsyth), then overdraw ordering of clusters of those
+ * triangles (after Sander et al., "Fast Triangle Reordering for Vertex
+ * Locality and Reduced Overdraw"), then vertex fetch ordering, which
+ * renumbers the vertices in the order the triangles first use them.
+ */
+class MeshOptimizer {
+private:
+    MeshOptimizer();
+
+public:
+    // post-transform cache entries assumed by the passes
+    static const int CACHE_SIZE = 32;
+
+    struct CacheStatistics {
+        // cache misses per triangle; 0.5 is ideal on a large regular mesh
+        float acmr;
+        // cache misses per vertex; 1 is ideal
+        float atvr;
+    };
+
+    // simulates a FIFO post-transform cache of cache_size entries
+    static CacheStatistics analyzeVertexCache(
+            const std::vector<unsigned int>& indices, int vertex_count,
+            int cache_size);
+
+    static void optimizeVertexCache(std::vector<unsigned int>& indices,
+            int vertex_count);
+
+    /*
+     * Splits the triangles into clusters and draws the clusters facing away
+     * from the mesh center first. A cluster ends where the cache order
+     * starts over, at a triangle missing all three vertices, or at one
+     * missing two while the cluster's ACMR is under threshold times the
+     * mesh's. Higher thresholds give smaller clusters, less overdraw and
+     * more cache misses; 0 keeps only the first kind of split.
+     */
+    static void optimizeOverdraw(std::vector<unsigned int>& indices,
+            const std::vector<glm::vec3>& vertices, float threshold);
+
+    /*
+     * Renumbers the indices in order of first use and returns the old
+     * index of each new vertex. Vertices no triangle uses go last.
+     */
+    static std::vector<unsigned int> optimizeVertexFetch(
+            std::vector<unsigned int>& indices, int vertex_count);
+};
+
+}
+#endif
@@ -0,0 +1,603 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Reduces the triangle count of a mesh by quadric error edge collapses.
+ ***************************************************************************/
+
+#include "mesh_simplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace gvr {
+
+// the plane quadrics of the triangles around a vertex, weighted by area:
+// the upper triangle of a symmetric 4x4 matrix
+struct Quadric {
+    double a[10];
+    double weight;
+
+    Quadric() :
+            weight(0.0) {
+        std::fill(a, a + 10, 0.0);
+    }
+
+    void addPlane(const glm::dvec3& normal, double distance, double area) {
+        double plane[4] = { normal.x, normal.y, normal.z, distance };
+        int k = 0;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = i; j < 4; ++j) {
+                a[k++] += area * plane[i] * plane[j];
+            }
+        }
+        weight += area;
+    }
+
+    void add(const Quadric& quadric) {
+        for (int i = 0; i < 10; ++i) {
+            a[i] += quadric.a[i];
+        }
+        weight += quadric.weight;
+    }
+
+    // the mean squared distance from point to the planes
+    double error(const glm::vec3& point) const {
+        if (weight <= 0.0) {
+            return 0.0;
+        }
+        double p[4] = { point.x, point.y, point.z, 1.0 };
+        double sum = 0.0;
+        int k = 0;
+        for (int i = 0; i < 4; ++i) {
+            for (int j = i; j < 4; ++j) {
+                sum += (i == j ? 1.0 : 2.0) * a[k++] * p[i] * p[j];
+            }
+        }
+        return std::max(sum / weight, 0.0);
+    }
+};
+
+struct Collapse {
+    unsigned int from;
+    unsigned int to;
+    // the other side of a seam moves along with from; NO_VERTEX elsewhere
+    unsigned int seam_from;
+    unsigned int seam_to;
+    // the error plus the attribute cost
+    float cost;
+    float error;
+
+    bool operator<(const Collapse& other) const {
+        return cost < other.cost;
+    }
+};
+
+static const unsigned int NO_VERTEX = ~0u;
+
+/*
+ * How a vertex may move. Border vertices slide along their border, and
+ * seam vertices, one of the two vertices an attribute seam splits a
+ * position into, slide along the seam together with the other one.
+ */
+enum VertexKind {
+    MANIFOLD, BORDER, SEAM, LOCKED
+};
+
+static bool lessPosition(const glm::vec3& a, const glm::vec3& b) {
+    if (a.x != b.x) {
+        return a.x < b.x;
+    } else if (a.y != b.y) {
+        return a.y < b.y;
+    }
+    return a.z < b.z;
+}
+
+// maps each vertex to the first vertex at the same position
+static std::vector<unsigned int> findPositions(
+        const std::vector<glm::vec3>& vertices) {
+    std::vector<unsigned int> order(vertices.size());
+    for (int i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(),
+            [&vertices](unsigned int a, unsigned int b) {
+                return lessPosition(vertices[a], vertices[b]);
+            });
+
+    std::vector<unsigned int> positions(vertices.size());
+    for (int i = 0; i < order.size(); ++i) {
+        if (i > 0 && vertices[order[i]] == vertices[order[i - 1]]) {
+            positions[order[i]] = positions[order[i - 1]];
+        } else {
+            positions[order[i]] = order[i];
+        }
+    }
+    return positions;
+}
+
+// links the vertices of each position into a ring
+static std::vector<unsigned int> findWedges(
+        const std::vector<unsigned int>& positions) {
+    std::vector<unsigned int> wedges(positions.size());
+    for (int i = 0; i < positions.size(); ++i) {
+        wedges[i] = i;
+    }
+    for (int i = 0; i < positions.size(); ++i) {
+        if (positions[i] != i) {
+            wedges[i] = wedges[positions[i]];
+            wedges[positions[i]] = i;
+        }
+    }
+    return wedges;
+}
+
+static unsigned long long edgeKey(unsigned int a, unsigned int b) {
+    return static_cast<unsigned long long>(a) << 32 | b;
+}
+
+/*
+ * The directed edges of the triangles, by vertex, sorted. An edge whose
+ * reverse is missing is open: it lies on a border or a seam.
+ */
+static void findHalfEdges(const std::vector<unsigned int>& indices,
+        std::vector<unsigned long long>& half_edges) {
+    half_edges.clear();
+    for (int i = 0; i + 2 < indices.size(); i += 3) {
+        for (int j = 0; j < 3; ++j) {
+            half_edges.push_back(
+                    edgeKey(indices[i + j], indices[i + (j + 1) % 3]));
+        }
+    }
+    std::sort(half_edges.begin(), half_edges.end());
+}
+
+static bool hasHalfEdge(const std::vector<unsigned long long>& half_edges,
+        unsigned int a, unsigned int b) {
+    return std::binary_search(half_edges.begin(), half_edges.end(),
+            edgeKey(a, b));
+}
+
+static bool isOpenEdge(const std::vector<unsigned long long>& half_edges,
+        unsigned int a, unsigned int b) {
+    return hasHalfEdge(half_edges, a, b) != hasHalfEdge(half_edges, b, a);
+}
+
+/*
+ * Open borders and seams keep their shape: a border vertex needs exactly
+ * two border edges, and a seam position exactly two vertices with two open
+ * edges each and no border edges. Anything else at a split position, and the ends of
+ * non-manifold edges, is locked.
+ */
+static std::vector<VertexKind> classifyVertices(
+        const std::vector<unsigned int>& indices,
+        const std::vector<unsigned int>& positions,
+        const std::vector<unsigned int>& wedges,
+        const std::vector<unsigned long long>& half_edges) {
+    int vertex_count = positions.size();
+    std::vector<int> open_edges(vertex_count, 0);
+    for (auto it = half_edges.begin(); it != half_edges.end(); ++it) {
+        unsigned int a = *it >> 32;
+        unsigned int b = *it & 0xffffffffu;
+        if (!hasHalfEdge(half_edges, b, a)) {
+            ++open_edges[a];
+            ++open_edges[b];
+        }
+    }
+
+    std::vector<int> border_edges(vertex_count, 0);
+    std::vector<bool> non_manifold(vertex_count, false);
+    std::vector<std::pair<unsigned int, unsigned int>> edges;
+    edges.reserve(indices.size());
+    for (int i = 0; i + 2 < indices.size(); i += 3) {
+        for (int j = 0; j < 3; ++j) {
+            unsigned int a = positions[indices[i + j]];
+            unsigned int b = positions[indices[i + (j + 1) % 3]];
+            edges.push_back(std::make_pair(std::min(a, b), std::max(a, b)));
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (int i = 0; i < edges.size();) {
+        int j = i + 1;
+        while (j < edges.size() && edges[j] == edges[i]) {
+            ++j;
+        }
+        if (j - i == 1) {
+            ++border_edges[edges[i].first];
+            ++border_edges[edges[i].second];
+        } else if (j - i > 2) {
+            non_manifold[edges[i].first] = true;
+            non_manifold[edges[i].second] = true;
+        }
+        i = j;
+    }
+
+    std::vector<VertexKind> kinds(vertex_count, LOCKED);
+    for (int i = 0; i < vertex_count; ++i) {
+        unsigned int position = positions[i];
+        if (non_manifold[position]) {
+            continue;
+        }
+        if (wedges[i] == i) {
+            // the neighbours may be split, but this vertex moves as a whole
+            if (border_edges[position] == 0) {
+                kinds[i] = MANIFOLD;
+            } else if (border_edges[position] == 2) {
+                kinds[i] = BORDER;
+            }
+        } else if (wedges[wedges[i]] == i && border_edges[position] == 0
+                && open_edges[i] == 2 && open_edges[wedges[i]] == 2) {
+            kinds[i] = SEAM;
+        }
+    }
+    return kinds;
+}
+
+/*
+ * Whether from may move onto to along the edge between them, and for a
+ * seam vertex, the collapse of the other side of the seam that goes with
+ * it. Returns false if the collapse would tear a border or a seam.
+ */
+static bool findCollapse(unsigned int from, unsigned int to,
+        const std::vector<VertexKind>& kinds,
+        const std::vector<unsigned int>& positions,
+        const std::vector<unsigned int>& wedges,
+        const std::vector<unsigned long long>& half_edges,
+        const std::vector<unsigned long long>& position_half_edges,
+        unsigned int& seam_from, unsigned int& seam_to) {
+    seam_from = NO_VERTEX;
+    seam_to = NO_VERTEX;
+    if (positions[from] == positions[to]) {
+        return false;
+    }
+    switch (kinds[from]) {
+    case MANIFOLD:
+        return true;
+    case BORDER:
+        return (kinds[to] == BORDER || kinds[to] == LOCKED)
+                && isOpenEdge(position_half_edges, positions[from],
+                        positions[to]);
+    case SEAM:
+        if ((kinds[to] != SEAM && kinds[to] != LOCKED)
+                || !isOpenEdge(half_edges, from, to)) {
+            return false;
+        }
+        // the vertex at the position of to that the other side reaches
+        for (unsigned int other = wedges[to]; other != to;
+                other = wedges[other]) {
+            if (isOpenEdge(half_edges, wedges[from], other)) {
+                seam_from = wedges[from];
+                seam_to = other;
+                return true;
+            }
+        }
+        return false;
+    default:
+        return false;
+    }
+}
+
+/*
+ * The planes of the triangles around each vertex. Open edges add a plane
+ * upright on their triangle, so borders and seams that slide keep their
+ * course.
+ */
+static std::vector<Quadric> computeQuadrics(
+        const std::vector<unsigned int>& indices,
+        const std::vector<glm::vec3>& vertices,
+        const std::vector<unsigned long long>& half_edges) {
+    std::vector<Quadric> quadrics(vertices.size());
+    for (int i = 0; i + 2 < indices.size(); i += 3) {
+        glm::dvec3 p0(vertices[indices[i]]);
+        glm::dvec3 p1(vertices[indices[i + 1]]);
+        glm::dvec3 p2(vertices[indices[i + 2]]);
+        glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+        double length = glm::length(normal);
+        if (length == 0.0) {
+            continue;
+        }
+        normal /= length;
+        Quadric quadric;
+        quadric.addPlane(normal, -glm::dot(normal, p0), length * 0.5);
+        for (int j = 0; j < 3; ++j) {
+            quadrics[indices[i + j]].add(quadric);
+        }
+
+        for (int j = 0; j < 3; ++j) {
+            unsigned int a = indices[i + j];
+            unsigned int b = indices[i + (j + 1) % 3];
+            if (hasHalfEdge(half_edges, b, a)) {
+                continue;
+            }
+            glm::dvec3 edge = glm::dvec3(vertices[b]) - glm::dvec3(vertices[a]);
+            glm::dvec3 side = glm::cross(edge, normal);
+            double side_length = glm::length(side);
+            if (side_length == 0.0) {
+                continue;
+            }
+            side /= side_length;
+            Quadric border;
+            border.addPlane(side, -glm::dot(side, glm::dvec3(vertices[a])),
+                    glm::dot(edge, edge));
+            quadrics[a].add(border);
+            quadrics[b].add(border);
+        }
+    }
+    return quadrics;
+}
+
+// the triangles around each position, as offsets into a shared list
+static void buildAdjacency(const std::vector<unsigned int>& indices,
+        const std::vector<unsigned int>& positions,
+        std::vector<unsigned int>& offsets,
+        std::vector<unsigned int>& triangles) {
+    offsets.assign(positions.size() + 1, 0);
+    for (int i = 0; i < indices.size(); ++i) {
+        ++offsets[positions[indices[i]] + 1];
+    }
+    for (int i = 0; i < positions.size(); ++i) {
+        offsets[i + 1] += offsets[i];
+    }
+    triangles.resize(indices.size());
+    std::vector<unsigned int> next(offsets.begin(), offsets.end() - 1);
+    for (int i = 0; i < indices.size(); ++i) {
+        triangles[next[positions[indices[i]]]++] = i / 3;
+    }
+}
+
+static bool hasPosition(const unsigned int* triangle,
+        const std::vector<unsigned int>& positions, unsigned int position) {
+    return positions[triangle[0]] == position
+            || positions[triangle[1]] == position
+            || positions[triangle[2]] == position;
+}
+
+/*
+ * Checks that moving collapse.from onto collapse.to flips no triangle, and
+ * that the two share no neighbor besides the third vertices of the
+ * triangles the collapse removes, which would otherwise pinch the surface.
+ * Returns the number of triangles removed, or -1 if the collapse is not
+ * allowed.
+ */
+static int checkCollapse(const Collapse& collapse,
+        const std::vector<unsigned int>& indices,
+        const std::vector<glm::vec3>& vertices,
+        const std::vector<unsigned int>& positions,
+        const std::vector<unsigned int>& offsets,
+        const std::vector<unsigned int>& triangles,
+        std::vector<unsigned int>& marks, unsigned int mark) {
+    unsigned int from = positions[collapse.from];
+    unsigned int to = positions[collapse.to];
+    const glm::vec3& target = vertices[collapse.to];
+
+    int removed = 0;
+    for (int i = offsets[from]; i < offsets[from + 1]; ++i) {
+        const unsigned int* triangle = &indices[triangles[i] * 3];
+        if (hasPosition(triangle, positions, to)) {
+            ++removed;
+            continue;
+        }
+        glm::vec3 corners[3];
+        for (int j = 0; j < 3; ++j) {
+            corners[j] = vertices[triangle[j]];
+        }
+        glm::vec3 before = glm::cross(corners[1] - corners[0],
+                corners[2] - corners[0]);
+        for (int j = 0; j < 3; ++j) {
+            if (positions[triangle[j]] == from) {
+                corners[j] = target;
+            }
+        }
+        glm::vec3 after = glm::cross(corners[1] - corners[0],
+                corners[2] - corners[0]);
+        if (glm::dot(before, after) <= 0.0f) {
+            return -1;
+        }
+    }
+
+    for (int i = offsets[from]; i < offsets[from + 1]; ++i) {
+        const unsigned int* triangle = &indices[triangles[i] * 3];
+        for (int j = 0; j < 3; ++j) {
+            marks[positions[triangle[j]]] = mark;
+        }
+    }
+    int shared = 0;
+    for (int i = offsets[to]; i < offsets[to + 1]; ++i) {
+        const unsigned int* triangle = &indices[triangles[i] * 3];
+        for (int j = 0; j < 3; ++j) {
+            unsigned int position = positions[triangle[j]];
+            if (position != from && position != to
+                    && marks[position] == mark) {
+                marks[position] = mark + 1;
+                ++shared;
+            }
+        }
+    }
+    return shared == removed ? removed : -1;
+}
+
+float MeshSimplifier::simplify(std::vector<unsigned int>& indices,
+        const std::vector<glm::vec3>& vertices,
+        const std::vector<glm::vec3>& normals,
+        const std::vector<glm::vec2>& tex_coords, int target_index_count,
+        float attribute_weight) {
+    int vertex_count = vertices.size();
+    for (auto it = indices.begin(); it != indices.end(); ++it) {
+        if (*it >= vertex_count) {
+            std::string error =
+                    "MeshSimplifier::simplify() : index out of range";
+            throw error;
+        }
+    }
+    indices.resize(indices.size() - indices.size() % 3);
+
+    bool has_normals = normals.size() == vertex_count;
+    bool has_tex_coords = tex_coords.size() == vertex_count;
+    std::vector<unsigned int> positions = findPositions(vertices);
+    std::vector<unsigned int> wedges = findWedges(positions);
+    std::vector<unsigned long long> half_edges;
+    std::vector<unsigned long long> position_half_edges;
+    std::vector<unsigned int> position_indices(indices.size());
+    findHalfEdges(indices, half_edges);
+    std::vector<VertexKind> kinds = classifyVertices(indices, positions,
+            wedges, half_edges);
+    std::vector<Quadric> quadrics = computeQuadrics(indices, vertices,
+            half_edges);
+
+    std::vector<unsigned int> offsets;
+    std::vector<unsigned int> triangles;
+    std::vector<Collapse> collapses;
+    std::vector<unsigned int> remap(vertex_count);
+    std::vector<bool> touched(vertex_count);
+    std::vector<unsigned int> marks(vertex_count, 0);
+    unsigned int mark = 0;
+    double max_error = 0.0;
+
+    // each pass collapses the cheapest edges that do not touch each other,
+    // then rebuilds the topology for the next
+    while (indices.size() > target_index_count) {
+        buildAdjacency(indices, positions, offsets, triangles);
+        // collapses move borders and seams, so their edges are found anew
+        findHalfEdges(indices, half_edges);
+        for (int i = 0; i < indices.size(); ++i) {
+            position_indices[i] = positions[indices[i]];
+        }
+        position_indices.resize(indices.size());
+        findHalfEdges(position_indices, position_half_edges);
+
+        collapses.clear();
+        for (int i = 0; i < indices.size(); i += 3) {
+            for (int j = 0; j < 3; ++j) {
+                unsigned int a = indices[i + j];
+                unsigned int b = indices[i + (j + 1) % 3];
+                for (int k = 0; k < 2; ++k) {
+                    unsigned int seam_a;
+                    unsigned int seam_b;
+                    if (findCollapse(a, b, kinds, positions, wedges,
+                            half_edges, position_half_edges, seam_a, seam_b)) {
+                        Quadric quadric = quadrics[a];
+                        quadric.add(quadrics[b]);
+                        if (seam_a != NO_VERTEX) {
+                            quadric.add(quadrics[seam_a]);
+                            quadric.add(quadrics[seam_b]);
+                        }
+                        double error = quadric.error(vertices[b]);
+                        double cost = error;
+                        if (attribute_weight > 0.0f) {
+                            float change = 0.0f;
+                            if (has_normals) {
+                                glm::vec3 d = normals[a] - normals[b];
+                                change += glm::dot(d, d);
+                            }
+                            if (has_tex_coords) {
+                                glm::vec2 d = tex_coords[a] - tex_coords[b];
+                                change += glm::dot(d, d);
+                            }
+                            glm::vec3 edge = vertices[a] - vertices[b];
+                            cost += attribute_weight * change
+                                    * glm::dot(edge, edge);
+                        }
+                        Collapse collapse = { a, b, seam_a, seam_b,
+                                static_cast<float>(cost),
+                                static_cast<float>(error) };
+                        collapses.push_back(collapse);
+                    }
+                    std::swap(a, b);
+                }
+            }
+        }
+        std::sort(collapses.begin(), collapses.end());
+
+        for (int i = 0; i < vertex_count; ++i) {
+            remap[i] = i;
+        }
+        std::fill(touched.begin(), touched.end(), false);
+        int triangle_count = indices.size() / 3;
+        int done = 0;
+        for (auto it = collapses.begin(); it != collapses.end()
+                && triangle_count * 3 > target_index_count; ++it) {
+            if (touched[it->from] || touched[it->to]
+                    || (it->seam_from != NO_VERTEX
+                            && (touched[it->seam_from]
+                                    || touched[it->seam_to]))) {
+                continue;
+            }
+            mark += 2;
+            int removed = checkCollapse(*it, indices, vertices, positions,
+                    offsets, triangles, marks, mark);
+            if (removed < 0) {
+                continue;
+            }
+
+            remap[it->from] = it->to;
+            quadrics[it->to].add(quadrics[it->from]);
+            if (it->seam_from != NO_VERTEX) {
+                remap[it->seam_from] = it->seam_to;
+                quadrics[it->seam_to].add(quadrics[it->seam_from]);
+                touched[it->seam_to] = true;
+            }
+            max_error = std::max(max_error, static_cast<double>(it->error));
+            triangle_count -= removed;
+            ++done;
+
+            // the triangles around from change, so none of their vertices
+            // can collapse again in this pass
+            unsigned int from = positions[it->from];
+            touched[it->to] = true;
+            for (int j = offsets[from]; j < offsets[from + 1]; ++j) {
+                const unsigned int* triangle = &indices[triangles[j] * 3];
+                for (int k = 0; k < 3; ++k) {
+                    touched[triangle[k]] = true;
+                }
+            }
+        }
+        if (done == 0) {
+            break;
+        }
+
+        int write = 0;
+        for (int i = 0; i < indices.size(); i += 3) {
+            unsigned int a = remap[indices[i]];
+            unsigned int b = remap[indices[i + 1]];
+            unsigned int c = remap[indices[i + 2]];
+            if (positions[a] != positions[b] && positions[b] != positions[c]
+                    && positions[c] != positions[a]) {
+                indices[write++] = a;
+                indices[write++] = b;
+                indices[write++] = c;
+            }
+        }
+        indices.resize(write);
+    }
+
+    return sqrt(max_error);
+}
+
+void MeshSimplifier::weldVertices(std::vector<unsigned int>& indices,
+        const std::vector<glm::vec3>& vertices) {
+    std::vector<unsigned int> positions = findPositions(vertices);
+    for (auto it = indices.begin(); it != indices.end(); ++it) {
+        if (*it >= vertices.size()) {
+            std::string error =
+                    "MeshSimplifier::weldVertices() : index out of range";
+            throw error;
+        }
+        *it = positions[*it];
+    }
+}
+
+}
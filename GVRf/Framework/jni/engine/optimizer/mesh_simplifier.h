@@ -0,0 +1,74 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Reduces the triangle count of a mesh by quadric error edge collapses.
+ ***************************************************************************/
+
+#ifndef MESH_SIMPLIFIER_H_
+#define MESH_SIMPLIFIER_H_
+
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace gvr {
+
+/*
+ * Collapses edges into one of their end vertices, cheapest first, after
+ * Garland and Heckbert, "Surface Simplification Using Quadric Error
+ * Metrics". Only the indices change: every level keeps the vertices of the
+ * source mesh, so no new attribute values are ever made up.
+ *
+ * Vertices on open borders only collapse along the border, and the two
+ * vertices an attribute seam splits a position into only collapse along the
+ * seam, together, so holes and seams keep their shape. Where more seams
+ * meet, and at non-manifold edges, vertices are locked. A collapse that
+ * would flip a triangle is skipped.
+ */
+class MeshSimplifier {
+private:
+    MeshSimplifier();
+
+public:
+    /*
+     * Simplifies the triangles until at most target_index_count indices are
+     * left, or no collapse is possible. normals and tex_coords may be
+     * empty; where they are not, a collapse also costs attribute_weight
+     * times the squared attribute change times the squared edge length, so
+     * edges across creases and texture stretches go last.
+     *
+     * Returns the geometric error, in mesh units: the largest RMS distance
+     * from a collapsed vertex to the planes of the source triangles around
+     * it.
+     */
+    static float simplify(std::vector<unsigned int>& indices,
+            const std::vector<glm::vec3>& vertices,
+            const std::vector<glm::vec3>& normals,
+            const std::vector<glm::vec2>& tex_coords, int target_index_count,
+            float attribute_weight);
+
+    /*
+     * Points every index at the first vertex with the same position, so
+     * the seams of meshes whose attributes no longer matter do not hold
+     * their vertices back.
+     */
+    static void weldVertices(std::vector<unsigned int>& indices,
+            const std::vector<glm::vec3>& vertices);
+};
+
+}
+#endif
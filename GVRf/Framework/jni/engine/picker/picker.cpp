@@ -30,6 +30,7 @@
 #include "objects/scene.h"
 #include "objects/scene_object.h"
 #include "objects/components/camera_rig.h"
+#include "objects/components/component_registry.h"
 #include "objects/components/eye_pointee_holder.h"
 
 namespace gvr {
@@ -43,14 +44,18 @@ Picker::~Picker() {
 std::vector<std::shared_ptr<EyePointeeHolder>> Picker::pickScene(
         const std::shared_ptr<Scene>& scene, float ox, float oy, float oz,
         float dx, float dy, float dz) {
-    std::vector < std::shared_ptr < SceneObject >> scene_objects =
-            scene->getWholeSceneObjects();
+    const ComponentPool<EyePointeeHolder>& eye_pointee_holder_pool =
+            ComponentRegistry::pool<EyePointeeHolder>();
     std::vector < std::shared_ptr < EyePointeeHolder >> eye_pointee_holders;
-    for (auto it = scene_objects.begin(); it != scene_objects.end(); ++it) {
-        std::shared_ptr<EyePointeeHolder> eye_pointee_holder =
-                (*it)->eye_pointee_holder();
-        if (eye_pointee_holder != 0 && eye_pointee_holder->enable()) {
-            eye_pointee_holders.push_back(eye_pointee_holder);
+    for (int i = 0; i < eye_pointee_holder_pool.size(); ++i) {
+        int entity = eye_pointee_holder_pool.entity(i);
+        if (ComponentRegistry::scene(entity) == scene.get()
+                && ComponentRegistry::active(entity)) {
+            const std::shared_ptr<EyePointeeHolder>& eye_pointee_holder =
+                    eye_pointee_holder_pool.component(i);
+            if (eye_pointee_holder->enable()) {
+                eye_pointee_holders.push_back(eye_pointee_holder);
+            }
         }
     }
 
@@ -92,7 +97,7 @@ float Picker::pickSceneObject(const std::shared_ptr<SceneObject>& scene_object,
         const std::shared_ptr<CameraRig>& camera_rig) {
     glm::mat4 view_matrix = glm::affineInverse(
             camera_rig->owner_object()->transform()->getModelMatrix());
-    if (scene_object->eye_pointee_holder() != 0) {
+    if (scene_object->active() && scene_object->eye_pointee_holder() != 0) {
         std::shared_ptr<EyePointeeHolder> eye_pointee_holder =
                 scene_object->eye_pointee_holder();
         if (eye_pointee_holder->enable()) {
@@ -23,10 +23,12 @@
 
 #include "eglextension/tiledrendering/tiled_rendering_enhancer.h"
 #include "objects/material.h"
+#include "objects/mesh.h"
 #include "objects/post_effect_data.h"
 #include "objects/scene.h"
 #include "objects/scene_object.h"
 #include "objects/components/camera.h"
+#include "objects/components/component_registry.h"
 #include "objects/components/eye_pointee_holder.h"
 #include "objects/components/render_data.h"
 #include "objects/textures/render_texture.h"
@@ -37,6 +39,69 @@
 
 namespace gvr {
 
+static bool compareSnapshotEntries(const SceneSnapshot::Entry* i,
+        const SceneSnapshot::Entry* j) {
+    return i->rendering_order < j->rendering_order;
+}
+
+// world space planes of the view frustum, normals pointing inward
+static void extractFrustum(const glm::mat4& vp_matrix, glm::vec4* frustum) {
+    glm::mat4 rows = glm::transpose(vp_matrix);
+    frustum[0] = rows[3] + rows[0];
+    frustum[1] = rows[3] - rows[0];
+    frustum[2] = rows[3] + rows[1];
+    frustum[3] = rows[3] - rows[1];
+    frustum[4] = rows[3] + rows[2];
+    frustum[5] = rows[3] - rows[2];
+    for (int i = 0; i < 6; ++i) {
+        frustum[i] /= glm::length(glm::vec3(frustum[i]));
+    }
+}
+
+/*
+ * Tests the bounding sphere of the entry's mesh against the frustum, and
+ * estimates the fraction of the viewport height it covers.
+ */
+static bool isInFrustum(const SceneSnapshot::Entry& entry,
+        const glm::vec4* frustum, const glm::mat4& vp_matrix,
+        float projection_scale, float* screen_size) {
+    const glm::vec4& sphere = entry.mesh->getBoundingSphere();
+    const glm::mat4& model_matrix = entry.model_matrix;
+    glm::vec3 center(model_matrix * glm::vec4(glm::vec3(sphere), 1.0f));
+    float scale = std::max(glm::length(glm::vec3(model_matrix[0])),
+            std::max(glm::length(glm::vec3(model_matrix[1])),
+                    glm::length(glm::vec3(model_matrix[2]))));
+    float radius = sphere.w * scale;
+    for (int i = 0; i < 6; ++i) {
+        if (glm::dot(glm::vec3(frustum[i]), center) + frustum[i].w
+                < -radius) {
+            return false;
+        }
+    }
+
+    float w = (vp_matrix * glm::vec4(center, 1.0f)).w;
+    *screen_size =
+            w > 0.0f ? std::min(1.0f, radius * projection_scale / w) : 1.0f;
+    return true;
+}
+
+// an object has something to draw when any of its descendants has
+static void markDrawable(const SceneSnapshot& snapshot, int entity) {
+    while (entity >= 0 && snapshot.contains(entity)
+            && ComponentRegistry::markDrawable(entity)) {
+        entity = snapshot.entry(entity).parent;
+    }
+}
+
+// an object is visible when any of its descendants is
+static void markVisible(const SceneSnapshot& snapshot, int entity,
+        float screen_size) {
+    while (entity >= 0 && snapshot.contains(entity)
+            && ComponentRegistry::markVisible(entity, screen_size)) {
+        entity = snapshot.entry(entity).parent;
+    }
+}
+
 void Renderer::renderCamera(std::shared_ptr<Scene> scene,
         std::shared_ptr<Camera> camera, int framebufferId, int viewportX,
         int viewportY, int viewportWidth, int viewportHeight,
@@ -50,23 +115,48 @@ void Renderer::renderCamera(std::shared_ptr<Scene> scene,
     // bone/weight/joint and other assimp data, we will put general model conversion
     // on hold and do this kind of conversion fist
     if (scene->getSceneDirtyFlag()) {
-        std::vector < std::shared_ptr < SceneObject >> scene_objects =
-                scene->getWholeSceneObjects();
-        std::vector < std::shared_ptr < RenderData >> render_data_vector;
-        for (auto it = scene_objects.begin(); it != scene_objects.end(); ++it) {
-            std::shared_ptr<RenderData> render_data = (*it)->render_data();
-            if (render_data != 0) {
-                if (render_data->material() != 0) {
-                    render_data_vector.push_back(render_data);
-                }
-            }
-        }
-        std::sort(render_data_vector.begin(), render_data_vector.end(),
-                compareRenderData);
+        // publish after the camera rig has been predicted so objects parented
+        // to it do not lag a frame, then draw from the immutable snapshot
+        scene->publishSnapshot();
+        std::shared_ptr<const SceneSnapshot> snapshot = scene->snapshot();
 
         glm::mat4 view_matrix = camera->getViewMatrix();
         glm::mat4 projection_matrix = camera->getProjectionMatrix();
         glm::mat4 vp_matrix = glm::mat4(projection_matrix * view_matrix);
+        glm::vec4 frustum[6];
+        extractFrustum(vp_matrix, frustum);
+        glm::vec3 camera_position(glm::affineInverse(view_matrix)[3]);
+
+        // what passes the frustum test is recorded for update culling
+        std::vector<const SceneSnapshot::Entry*> render_entries;
+        for (int i = 0; i < snapshot->chunk_count(); ++i) {
+            const SceneSnapshot::Chunk* chunk = snapshot->chunk(i);
+            if (chunk == 0) {
+                continue;
+            }
+            for (int j = 0; j < SceneSnapshot::CHUNK_SIZE; ++j) {
+                const SceneSnapshot::Entry& entry = chunk->entries[j];
+                if (!entry.in_scene || !entry.active || !entry.render_data
+                        || !entry.material || !entry.mesh) {
+                    continue;
+                }
+                int entity = i * SceneSnapshot::CHUNK_SIZE + j;
+                markDrawable(*snapshot, entity);
+                // without frustum culling the bounds need not hold what the
+                // shader draws, so the entry is drawn and counts as all seen
+                float screen_size = 1.0f;
+                if ((entry.render_mask & camera->render_mask())
+                        && (!entry.frustum_culling
+                                || isInFrustum(entry, frustum, vp_matrix,
+                                        projection_matrix[1][1],
+                                        &screen_size))) {
+                    markVisible(*snapshot, entity, screen_size);
+                    render_entries.push_back(&entry);
+                }
+            }
+        }
+        std::sort(render_entries.begin(), render_entries.end(),
+                compareSnapshotEntries);
 
         std::vector < std::shared_ptr < PostEffectData >> post_effects =
                 camera->post_effect_data();
@@ -90,10 +180,10 @@ void Renderer::renderCamera(std::shared_ptr<Scene> scene,
 
             glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
 
-            for (auto it = render_data_vector.begin();
-                    it != render_data_vector.end(); ++it) {
-                renderRenderData(*it, vp_matrix, camera->render_mask(),
-                        shader_manager);
+            for (auto it = render_entries.begin(); it != render_entries.end();
+                    ++it) {
+                renderRenderData(**it, vp_matrix, camera_position,
+                        camera->render_mask(), shader_manager);
             }
         } else {
             std::shared_ptr<RenderTexture> texture_render_texture =
@@ -106,10 +196,10 @@ void Renderer::renderCamera(std::shared_ptr<Scene> scene,
                     texture_render_texture->height());
             glClear(GL_DEPTH_BUFFER_BIT | GL_COLOR_BUFFER_BIT);
 
-            for (auto it = render_data_vector.begin();
-                    it != render_data_vector.end(); ++it) {
-                renderRenderData(*it, vp_matrix, camera->render_mask(),
-                        shader_manager);
+            for (auto it = render_entries.begin(); it != render_entries.end();
+                    ++it) {
+                renderRenderData(**it, vp_matrix, camera_position,
+                        camera->render_mask(), shader_manager);
             }
 
             glDisable(GL_DEPTH_TEST);
@@ -186,80 +276,105 @@ void Renderer::renderCamera(std::shared_ptr<Scene> scene,
             post_effect_render_texture_a, post_effect_render_texture_b);
 }
 
-void Renderer::renderRenderData(std::shared_ptr<RenderData> render_data,
-        const glm::mat4& vp_matrix, int render_mask,
+void Renderer::renderRenderData(const SceneSnapshot::Entry& entry,
+        const glm::mat4& vp_matrix,
+        const glm::vec3& camera_position, int render_mask,
         std::shared_ptr<ShaderManager> shader_manager) {
-    if (render_mask & render_data->render_mask()) {
-        if (!render_data->cull_test()) {
+    const glm::mat4& model_matrix = entry.model_matrix;
+    if (render_mask & entry.render_mask) {
+        if (!entry.cull_test) {
             glDisable (GL_CULL_FACE);
         }
-        if (render_data->offset()) {
+        if (entry.offset) {
             glEnable (GL_POLYGON_OFFSET_FILL);
-            glPolygonOffset(render_data->offset_factor(),
-                    render_data->offset_units());
+            glPolygonOffset(entry.offset_factor,
+                    entry.offset_units);
         }
-        if (!render_data->depth_test()) {
+        if (!entry.depth_test) {
             glDisable (GL_DEPTH_TEST);
         }
-        if (!render_data->alpha_blend()) {
+        if (!entry.alpha_blend) {
             glDisable (GL_BLEND);
         }
-        if (render_data->mesh() != 0) {
-            glm::mat4 model_matrix(
-                    render_data->owner_object()->transform()->getModelMatrix());
-            glm::mat4 mvp_matrix(vp_matrix * model_matrix);
+        if (entry.mesh != 0) {
+            // per eye, in mesh space; a mirroring transform turns front
+            // faces into back faces, so those keep all their clusters
+            const std::shared_ptr<Mesh>& mesh = entry.mesh;
+            if (mesh->clustered() && entry.frustum_culling) {
+                glm::vec4 frustum[6];
+                extractFrustum(vp_matrix * model_matrix, frustum);
+                glm::vec3 mesh_camera_position(
+                        glm::affineInverse(model_matrix)
+                                * glm::vec4(camera_position, 1.0f));
+                mesh->cullClusters(frustum, mesh_camera_position,
+                        entry.cull_test
+                                && glm::determinant(glm::mat3(model_matrix))
+                                        > 0.0f);
+            }
+            bool lines = mesh->primitive_type() == Mesh::LINES
+                    || mesh->primitive_type() == Mesh::LINE_STRIP;
+            if (lines && entry.line_width != 1.0f) {
+                glLineWidth(entry.line_width);
+            }
+            // quantized positions are decoded by the matrix, for every shader
+            glm::mat4 mvp_matrix(
+                    vp_matrix * model_matrix
+                            * mesh->getDequantizationMatrix());
             try {
                 bool right = render_mask & RenderData::RenderMaskBit::Right;
-                switch (render_data->material()->shader_type()) {
+                switch (entry.material->shader_type()) {
                 case Material::ShaderType::UNLIT_SHADER:
                     shader_manager->getUnlitShader()->render(mvp_matrix,
-                            render_data);
+                            entry);
                     break;
                 case Material::ShaderType::UNLIT_HORIZONTAL_STEREO_SHADER:
                     shader_manager->getUnlitHorizontalStereoShader()->render(
-                            mvp_matrix, render_data, right);
+                            mvp_matrix, entry, right);
                     break;
                 case Material::ShaderType::UNLIT_VERTICAL_STEREO_SHADER:
                     shader_manager->getUnlitVerticalStereoShader()->render(
-                            mvp_matrix, render_data, right);
+                            mvp_matrix, entry, right);
                     break;
                 case Material::ShaderType::OES_SHADER:
                     shader_manager->getOESShader()->render(mvp_matrix,
-                            render_data);
+                            entry);
                     break;
                 case Material::ShaderType::OES_HORIZONTAL_STEREO_SHADER:
                     shader_manager->getOESHorizontalStereoShader()->render(
-                            mvp_matrix, render_data, right);
+                            mvp_matrix, entry, right);
                     break;
                 case Material::ShaderType::OES_VERTICAL_STEREO_SHADER:
                     shader_manager->getOESVerticalStereoShader()->render(
-                            mvp_matrix, render_data, right);
+                            mvp_matrix, entry, right);
                     break;
                 default:
                     shader_manager->getCustomShader(
-                            render_data->material()->shader_type())->render(
-                            mvp_matrix, render_data, right);
+                            entry.material->shader_type())->render(
+                            mvp_matrix, entry, right);
                     break;
                 }
             } catch (std::string error) {
                 LOGE(
                         "Error detected in Renderer::renderRenderData; name : %s, error : %s",
-                        render_data->owner_object()->name().c_str(),
+                        entry.render_data->owner_object()->name().c_str(),
                         error.c_str());
                 shader_manager->getErrorShader()->render(mvp_matrix,
-                        render_data);
+                        entry);
+            }
+            if (lines && entry.line_width != 1.0f) {
+                glLineWidth(1.0f);
             }
         }
-        if (!render_data->cull_test()) {
+        if (!entry.cull_test) {
             glEnable (GL_CULL_FACE);
         }
-        if (render_data->offset()) {
+        if (entry.offset) {
             glDisable (GL_POLYGON_OFFSET_FILL);
         }
-        if (!render_data->depth_test()) {
+        if (!entry.depth_test) {
             glEnable (GL_DEPTH_TEST);
         }
-        if (!render_data->alpha_blend()) {
+        if (!entry.alpha_blend) {
             glEnable (GL_BLEND);
         }
     }
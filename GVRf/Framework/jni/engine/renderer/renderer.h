@@ -34,6 +34,7 @@
 #include "glm/glm.hpp"
 
 #include "objects/eye_type.h"
+#include "objects/scene_snapshot.h"
 
 namespace gvr {
 class Camera;
@@ -85,8 +86,9 @@ public:
             glm::mat4 vp_matrix);
 
 private:
-    static void renderRenderData(std::shared_ptr<RenderData> render_data,
-            const glm::mat4& vp_matrix, int render_mask,
+    static void renderRenderData(const SceneSnapshot::Entry& entry,
+            const glm::mat4& vp_matrix,
+            const glm::vec3& camera_position, int render_mask,
             std::shared_ptr<ShaderManager> shader_manager);
     static void renderPostEffectData(
             std::shared_ptr<RenderTexture> render_texture,
@@ -0,0 +1,226 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Replays camera paths through a WorldStreamer on the host.
+ ***************************************************************************/
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <set>
+#include <unistd.h>
+#include <vector>
+
+#include "engine/importer/scene_file.h"
+#include "engine/streaming/world_streamer.h"
+#include "objects/mutation_queue.h"
+#include "objects/scene.h"
+#include "objects/scene_object.h"
+#include "objects/components/transform.h"
+
+using namespace gvr;
+
+int __android_log_print(int priority, const char* tag, const char* format,
+        ...) {
+    return 0;
+}
+
+static const int CELL_COUNT = 10;
+static const float CELL_SIZE = 20.0f;
+
+static glm::vec3 cellCenter(int cell) {
+    return glm::vec3(cell * CELL_SIZE + CELL_SIZE * 0.5f, 0.0f, 0.0f);
+}
+
+// a row of cells along +x, each holding one object
+static void writeCells(const std::string& directory) {
+    for (int i = 0; i < CELL_COUNT; ++i) {
+        std::shared_ptr<Scene> scene(new Scene());
+        std::shared_ptr<SceneObject> scene_object(new SceneObject());
+        scene_object->attachTransform(scene_object,
+                std::shared_ptr<Transform>(new Transform()));
+        scene_object->transform()->set_position(cellCenter(i));
+        scene->addSceneObject(scene_object);
+        char path[256];
+        snprintf(path, sizeof(path), "%s/cell_%d.gvrs", directory.c_str(),
+                i);
+        SceneFile::writeToFile(scene.get(), path);
+    }
+}
+
+static std::shared_ptr<WorldStreamer> createStreamer(
+        const std::shared_ptr<Scene>& scene, const std::string& directory) {
+    std::shared_ptr<WorldStreamer> streamer(new WorldStreamer(scene));
+    for (int i = 0; i < CELL_COUNT; ++i) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/cell_%d.gvrs", directory.c_str(),
+                i);
+        streamer->addCell(path, cellCenter(i), CELL_SIZE * 0.5f);
+    }
+    streamer->set_load_distance(15.0f);
+    streamer->set_unload_distance(25.0f);
+    // one step per frame, so the order of the steps is observable
+    streamer->set_frame_budget(0);
+    return streamer;
+}
+
+static std::set<int> residentCells(const WorldStreamer& streamer) {
+    std::set<int> resident;
+    for (int i = 0; i < streamer.cell_count(); ++i) {
+        if (streamer.cell_state(i) == WorldStreamer::RESIDENT) {
+            resident.insert(i);
+        }
+    }
+    return resident;
+}
+
+/*
+ * Updates from one point of the path until no cell is in flight, appending
+ * the cells that leave the scene to evictions in the order they leave.
+ */
+static void settle(WorldStreamer& streamer, const Scene& scene,
+        const glm::vec3& position, const glm::vec3& forward,
+        std::vector<int>& evictions) {
+    std::set<int> resident = residentCells(streamer);
+    for (int frame = 0; frame < 10000; ++frame) {
+        streamer.update(position, forward);
+
+        std::set<int> now_resident = residentCells(streamer);
+        for (auto it = resident.begin(); it != resident.end(); ++it) {
+            if (now_resident.count(*it) == 0) {
+                evictions.push_back(*it);
+            }
+        }
+        resident.swap(now_resident);
+        assert(scene.scene_objects().size() == resident.size());
+
+        bool in_flight = false;
+        for (int i = 0; i < streamer.cell_count(); ++i) {
+            WorldStreamer::CellState state = streamer.cell_state(i);
+            in_flight |= state == WorldStreamer::REQUESTED
+                    || state == WorldStreamer::LOADED;
+        }
+        if (!in_flight) {
+            return;
+        }
+        usleep(1000);
+    }
+    assert(!"WorldStreamer never settled");
+}
+
+static std::set<int> cells(int a, int b, int c = -1) {
+    std::set<int> result;
+    result.insert(a);
+    result.insert(b);
+    if (c >= 0) {
+        result.insert(c);
+    }
+    return result;
+}
+
+static void testForwardAndBack(const std::string& directory) {
+    std::shared_ptr<Scene> scene(new Scene());
+    std::shared_ptr<WorldStreamer> streamer = createStreamer(scene,
+            directory);
+    glm::vec3 ahead(1.0f, 0.0f, 0.0f);
+    std::vector<int> evictions;
+
+    settle(*streamer, *scene, cellCenter(0), ahead, evictions);
+    assert(residentCells(*streamer) == cells(0, 1));
+
+    settle(*streamer, *scene, cellCenter(2), ahead, evictions);
+    assert(residentCells(*streamer) == cells(1, 2, 3));
+
+    // cell 1 is past the load distance but inside the unload distance, so
+    // it stays; cell 4 is not close enough to load
+    settle(*streamer, *scene, cellCenter(2) + glm::vec3(12.0f, 0.0f, 0.0f),
+            ahead, evictions);
+    assert(residentCells(*streamer) == cells(1, 2, 3));
+
+    settle(*streamer, *scene, cellCenter(4), ahead, evictions);
+    assert(residentCells(*streamer) == cells(3, 4, 5));
+
+    settle(*streamer, *scene, cellCenter(0), -ahead, evictions);
+    assert(residentCells(*streamer) == cells(0, 1));
+
+    // farthest first within one point of the path
+    static const int EXPECTED_EVICTIONS[] = { 0, 1, 2, 5, 4, 3 };
+    assert(evictions.size() == 6);
+    assert(std::equal(evictions.begin(), evictions.end(), EXPECTED_EVICTIONS));
+
+    // the cells still in the scene leave through the mutation queue
+    streamer.reset();
+    assert(scene->scene_objects().size() == 2);
+    MutationQueue::apply();
+    assert(scene->scene_objects().empty());
+}
+
+static void testMaxResidentCells(const std::string& directory) {
+    std::shared_ptr<Scene> scene(new Scene());
+    std::shared_ptr<WorldStreamer> streamer = createStreamer(scene,
+            directory);
+    streamer->set_max_resident_cells(2);
+    std::vector<int> evictions;
+
+    // cells 1 and 3 are as close, but 3 is ahead
+    settle(*streamer, *scene, cellCenter(2), glm::vec3(1.0f, 0.0f, 0.0f),
+            evictions);
+    assert(residentCells(*streamer) == cells(2, 3));
+    settle(*streamer, *scene, cellCenter(2), glm::vec3(-1.0f, 0.0f, 0.0f),
+            evictions);
+    assert(residentCells(*streamer) == cells(1, 2));
+    assert(evictions.size() == 1 && evictions[0] == 3);
+
+    streamer.reset();
+    MutationQueue::apply();
+    assert(scene->scene_objects().empty());
+}
+
+static void testMissingCell(const std::string& directory) {
+    std::shared_ptr<Scene> scene(new Scene());
+    std::shared_ptr<WorldStreamer> streamer(new WorldStreamer(scene));
+    int missing = streamer->addCell(directory + "/missing.gvrs",
+            glm::vec3(0.0f), 1.0f);
+    std::vector<int> evictions;
+
+    settle(*streamer, *scene, glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f),
+            evictions);
+    assert(streamer->cell_state(missing) == WorldStreamer::FAILED);
+    assert(scene->scene_objects().empty());
+}
+
+int main() {
+    char directory[] = "/tmp/world_streamer_test_XXXXXX";
+    if (mkdtemp(directory) == 0) {
+        perror("mkdtemp");
+        return 1;
+    }
+    writeCells(directory);
+
+    testForwardAndBack(directory);
+    testMaxResidentCells(directory);
+    testMissingCell(directory);
+
+    for (int i = 0; i < CELL_COUNT; ++i) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/cell_%d.gvrs", directory, i);
+        unlink(path);
+    }
+    rmdir(directory);
+    printf("world_streamer_test: passed\n");
+    return 0;
+}
@@ -0,0 +1,319 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Streams the cells of a large world in and out around the camera.
+ ***************************************************************************/
+
+#include "world_streamer.h"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "engine/importer/scene_file.h"
+#include "objects/mutation_queue.h"
+#include "objects/scene.h"
+#include "objects/scene_object.h"
+#include "objects/components/camera_rig.h"
+#include "objects/components/transform.h"
+#include "util/gvr_log.h"
+#include "util/gvr_time.h"
+
+namespace gvr {
+std::mutex WorldStreamer::streamers_mutex_;
+std::vector<WorldStreamer*> WorldStreamer::streamers_;
+
+static const float DEFAULT_LOAD_DISTANCE = 50.0f;
+static const float DEFAULT_UNLOAD_DISTANCE = 60.0f;
+static const long long DEFAULT_FRAME_BUDGET = 2000000;
+static const int DEFAULT_MAX_RESIDENT_CELLS = 16;
+
+// returns false if the file cannot be read
+static bool readFile(const std::string& path, std::vector<char>& data) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0) {
+        close(fd);
+        return false;
+    }
+    data.resize(file_stat.st_size);
+    size_t offset = 0;
+    while (offset < data.size()) {
+        ssize_t count = read(fd, data.data() + offset, data.size() - offset);
+        if (count <= 0) {
+            close(fd);
+            return false;
+        }
+        offset += count;
+    }
+    close(fd);
+    return true;
+}
+
+WorldStreamer::WorldStreamer(const std::shared_ptr<Scene>& scene) :
+        HybridObject(), scene_(scene), cells_(), load_distance_(
+                DEFAULT_LOAD_DISTANCE), unload_distance_(
+                DEFAULT_UNLOAD_DISTANCE), frame_budget_(DEFAULT_FRAME_BUDGET), max_resident_cells_(
+                DEFAULT_MAX_RESIDENT_CELLS), mutex_(), condition_(), requests_(), completed_(), loading_cell_(
+                -1), stopping_(false), worker_() {
+    worker_ = std::thread(&WorldStreamer::workerLoop, this);
+    std::lock_guard<std::mutex> lock(streamers_mutex_);
+    streamers_.push_back(this);
+}
+
+WorldStreamer::~WorldStreamer() {
+    {
+        std::lock_guard<std::mutex> lock(streamers_mutex_);
+        streamers_.erase(
+                std::find(streamers_.begin(), streamers_.end(), this));
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    condition_.notify_one();
+    worker_.join();
+
+    std::unique_ptr<MutationQueue::Batch> batch(new MutationQueue::Batch());
+    batch->next = 0;
+    for (auto it = cells_.begin(); it != cells_.end(); ++it) {
+        for (int i = 0; i < it->added_roots; ++i) {
+            MutationQueue::Command command;
+            command.opcode = MutationQueue::REMOVE_SCENE_OBJECT;
+            command.target = scene_;
+            command.argument = it->roots[i];
+            batch->commands.push_back(command);
+        }
+    }
+    if (!batch->commands.empty()) {
+        MutationQueue::submit(batch.release());
+    }
+}
+
+int WorldStreamer::addCell(const std::string& path, const glm::vec3& center,
+        float radius) {
+    Cell cell;
+    cell.path = path;
+    cell.center = center;
+    cell.radius = radius;
+    cell.state = UNLOADED;
+    cell.priority = 0.0f;
+    cell.added_roots = 0;
+    std::lock_guard<std::mutex> lock(mutex_);
+    cells_.push_back(cell);
+    return cells_.size() - 1;
+}
+
+int WorldStreamer::cell_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cells_.size();
+}
+
+WorldStreamer::CellState WorldStreamer::cell_state(int cell) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return cells_[cell].state;
+}
+
+float WorldStreamer::priority(const glm::vec3& center, float radius,
+        const glm::vec3& position, const glm::vec3& forward) {
+    glm::vec3 offset = center - position;
+    float length = glm::length(offset);
+    float distance = std::max(length - radius, 0.0f);
+    if (length <= 0.0f) {
+        return distance;
+    }
+    // scales the distance from 0.5 straight ahead to 1.5 straight behind
+    float facing = glm::dot(offset / length, forward);
+    return distance * (1.0f - 0.5f * facing);
+}
+
+void WorldStreamer::update(const glm::vec3& position,
+        const glm::vec3& forward) {
+    long long start_time = getCurrentTime();
+
+    std::vector<std::pair<int, std::vector<char>>> completed;
+    std::vector<int> order;
+    // cells never move, so these stay valid once the lock is released
+    std::vector<Cell*> evictions;
+    std::vector<Cell*> loads;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        completed.swap(completed_);
+        for (auto it = completed.begin(); it != completed.end(); ++it) {
+            Cell& cell = cells_[it->first];
+            if (it->second.empty()) {
+                LOGE("WorldStreamer::update() : cannot read %s",
+                        cell.path.c_str());
+                cell.state = FAILED;
+            } else {
+                cell.data.swap(it->second);
+                cell.state = LOADED;
+            }
+        }
+
+        order.reserve(cells_.size());
+        for (int i = 0; i < cells_.size(); ++i) {
+            Cell& cell = cells_[i];
+            if (cell.state != FAILED) {
+                cell.priority = priority(cell.center, cell.radius, position,
+                        forward);
+                order.push_back(i);
+            }
+        }
+        std::sort(order.begin(), order.end(),
+                [this](int i, int j) {
+                    return cells_[i].priority < cells_[j].priority;
+                });
+
+        // the best cells in load range are wanted; the ones already loaded
+        // are kept until they leave the unload range
+        requests_.clear();
+        int wanted_count = 0;
+        for (auto it = order.begin(); it != order.end(); ++it) {
+            Cell& cell = cells_[*it];
+            float distance = std::max(
+                    glm::length(cell.center - position) - cell.radius, 0.0f);
+            bool loaded = cell.state == LOADED || cell.state == RESIDENT;
+            bool wanted = wanted_count < max_resident_cells_
+                    && (distance <= load_distance_
+                            || (loaded && distance <= unload_distance_));
+            if (wanted) {
+                ++wanted_count;
+                if (cell.state == UNLOADED) {
+                    cell.state = REQUESTED;
+                }
+                if (cell.state == REQUESTED && *it != loading_cell_) {
+                    requests_.push_back(*it);
+                } else if (cell.state == LOADED) {
+                    loads.push_back(&cell);
+                }
+            } else if (cell.state == REQUESTED && *it != loading_cell_) {
+                cell.state = UNLOADED;
+            } else if (cell.state == LOADED || cell.state == RESIDENT) {
+                evictions.push_back(&cell);
+            }
+        }
+    }
+    condition_.notify_one();
+
+    // the worst cells go first, the best cells come first
+    bool progressed = false;
+    for (auto it = evictions.rbegin(); it != evictions.rend(); ++it) {
+        if (progressed && getCurrentTime() - start_time >= frame_budget_) {
+            return;
+        }
+        evict(**it);
+        progressed = true;
+    }
+    for (auto it = loads.begin(); it != loads.end(); ++it) {
+        while ((*it)->state == LOADED) {
+            if (progressed
+                    && getCurrentTime() - start_time >= frame_budget_) {
+                return;
+            }
+            instantiateStep(**it);
+            progressed = true;
+        }
+    }
+}
+
+void WorldStreamer::update() {
+    std::shared_ptr<CameraRig> camera_rig = scene_->main_camera_rig();
+    if (!camera_rig) {
+        return;
+    }
+    std::shared_ptr<SceneObject> owner_object = camera_rig->owner_object();
+    if (!owner_object || !owner_object->transform()) {
+        return;
+    }
+    glm::mat4 model_matrix = owner_object->transform()->getModelMatrix();
+    // the camera looks down -z
+    update(glm::vec3(model_matrix[3]),
+            glm::normalize(-glm::vec3(model_matrix[2])));
+}
+
+void WorldStreamer::updateAll() {
+    std::lock_guard<std::mutex> lock(streamers_mutex_);
+    for (auto it = streamers_.begin(); it != streamers_.end(); ++it) {
+        (*it)->update();
+    }
+}
+
+void WorldStreamer::instantiateStep(Cell& cell) {
+    // the objects register with the scene graph on creation, so parsing
+    // stays on the GL thread
+    if (!cell.data.empty()) {
+        try {
+            cell.roots = SceneFile::read(cell.data.data(), cell.data.size());
+        } catch (std::string error) {
+            LOGE("WorldStreamer::instantiateStep() : %s, %s",
+                    cell.path.c_str(), error.c_str());
+            cell.roots.clear();
+            cell.state = FAILED;
+        }
+        std::vector<char>().swap(cell.data);
+    } else if (cell.added_roots < cell.roots.size()) {
+        scene_->addSceneObject(cell.roots[cell.added_roots]);
+        ++cell.added_roots;
+    }
+    if (cell.state == LOADED && cell.added_roots == cell.roots.size()) {
+        cell.state = RESIDENT;
+    }
+}
+
+void WorldStreamer::evict(Cell& cell) {
+    for (int i = 0; i < cell.added_roots; ++i) {
+        scene_->removeSceneObject(cell.roots[i]);
+    }
+    cell.roots.clear();
+    cell.added_roots = 0;
+    std::vector<char>().swap(cell.data);
+    cell.state = UNLOADED;
+}
+
+void WorldStreamer::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        condition_.wait(lock, [this] {
+            return stopping_ || !requests_.empty();
+        });
+        if (stopping_) {
+            return;
+        }
+        int index = requests_.front();
+        requests_.erase(requests_.begin());
+        std::string path = cells_[index].path;
+        loading_cell_ = index;
+
+        lock.unlock();
+        std::vector<char> data;
+        if (!readFile(path, data)) {
+            data.clear();
+        }
+        lock.lock();
+
+        completed_.push_back(std::make_pair(index, std::vector<char>()));
+        completed_.back().second.swap(data);
+        loading_cell_ = -1;
+    }
+}
+
+}
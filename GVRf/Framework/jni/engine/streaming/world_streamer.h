@@ -0,0 +1,160 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Streams the cells of a large world in and out around the camera.
+ ***************************************************************************/
+
+#ifndef WORLD_STREAMER_H_
+#define WORLD_STREAMER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "objects/hybrid_object.h"
+
+namespace gvr {
+class Scene;
+class SceneObject;
+
+/*
+ * The world is split offline into cells, each a scene file with a bounding
+ * sphere. A worker thread reads the files of the cells nearest the camera;
+ * the GL thread then evicts the cells that fell behind and instantiates the
+ * loaded ones in steps, parsing a cell in one step and adding one of its
+ * roots to the scene per step after that. Steps stop once the frame budget
+ * is spent, but at least one is taken per frame. Cells ahead of the camera
+ * are preferred over cells behind it at the same distance.
+ */
+class WorldStreamer: public HybridObject {
+public:
+    enum CellState {
+        UNLOADED = 0, REQUESTED = 1, LOADED = 2, RESIDENT = 3, FAILED = 4
+    };
+
+    explicit WorldStreamer(const std::shared_ptr<Scene>& scene);
+    // may run on any thread, so the cells in the scene are removed through
+    // the mutation queue
+    ~WorldStreamer();
+
+    // returns the index of the cell
+    int addCell(const std::string& path, const glm::vec3& center,
+            float radius);
+
+    int cell_count() const;
+    CellState cell_state(int cell) const;
+
+    float load_distance() const {
+        return load_distance_;
+    }
+
+    // the distance is measured from the camera to the cell bounds
+    void set_load_distance(float load_distance) {
+        load_distance_ = load_distance;
+    }
+
+    float unload_distance() const {
+        return unload_distance_;
+    }
+
+    // should exceed the load distance, so cells at the edge do not thrash
+    void set_unload_distance(float unload_distance) {
+        unload_distance_ = unload_distance;
+    }
+
+    long long frame_budget() const {
+        return frame_budget_;
+    }
+
+    // in nanoseconds
+    void set_frame_budget(long long frame_budget) {
+        frame_budget_ = frame_budget;
+    }
+
+    int max_resident_cells() const {
+        return max_resident_cells_;
+    }
+
+    void set_max_resident_cells(int max_resident_cells) {
+        max_resident_cells_ = max_resident_cells;
+    }
+
+    // lower is sooner
+    static float priority(const glm::vec3& center, float radius,
+            const glm::vec3& position, const glm::vec3& forward);
+
+    // GL thread only
+    void update(const glm::vec3& position, const glm::vec3& forward);
+    // follows the main camera rig of the scene
+    void update();
+
+    static void updateAll();
+
+private:
+    struct Cell {
+        std::string path;
+        glm::vec3 center;
+        float radius;
+        CellState state;
+        float priority;
+        std::vector<char> data;
+        std::vector<std::shared_ptr<SceneObject>> roots;
+        // the first added_roots roots are in the scene
+        int added_roots;
+    };
+
+    void instantiateStep(Cell& cell);
+    void evict(Cell& cell);
+    void workerLoop();
+
+    WorldStreamer(const WorldStreamer& world_streamer);
+    WorldStreamer(WorldStreamer&& world_streamer);
+    WorldStreamer& operator=(const WorldStreamer& world_streamer);
+    WorldStreamer& operator=(WorldStreamer&& world_streamer);
+
+private:
+    std::shared_ptr<Scene> scene_;
+    // written by the GL thread only, under mutex_; a deque so cells stay in
+    // place while addCell appends
+    std::deque<Cell> cells_;
+    float load_distance_;
+    float unload_distance_;
+    long long frame_budget_;
+    int max_resident_cells_;
+
+    // shared with the worker
+    mutable std::mutex mutex_;
+    std::condition_variable condition_;
+    // best first; replaced on every update
+    std::vector<int> requests_;
+    std::vector<std::pair<int, std::vector<char>>> completed_;
+    int loading_cell_;
+    bool stopping_;
+    std::thread worker_;
+
+    static std::mutex streamers_mutex_;
+    static std::vector<WorldStreamer*> streamers_;
+};
+
+}
+#endif
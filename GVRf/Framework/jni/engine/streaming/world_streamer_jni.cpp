@@ -0,0 +1,124 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "world_streamer.h"
+
+#include "objects/scene.h"
+#include "util/gvr_jni.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeWorldStreamer_ctor(JNIEnv * env,
+        jobject obj, jlong jscene);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeWorldStreamer_addCell(JNIEnv * env,
+        jobject obj, jlong jworld_streamer, jstring path, jfloat x, jfloat y,
+        jfloat z, jfloat radius);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeWorldStreamer_getCellState(JNIEnv * env,
+        jobject obj, jlong jworld_streamer, jint cell);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeWorldStreamer_setLoadDistance(JNIEnv * env,
+        jobject obj, jlong jworld_streamer, jfloat load_distance);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeWorldStreamer_setUnloadDistance(JNIEnv * env,
+        jobject obj, jlong jworld_streamer, jfloat unload_distance);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeWorldStreamer_setFrameBudget(JNIEnv * env,
+        jobject obj, jlong jworld_streamer, jlong frame_budget);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeWorldStreamer_setMaxResidentCells(JNIEnv * env,
+        jobject obj, jlong jworld_streamer, jint max_resident_cells);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeWorldStreamer_updateAll(JNIEnv * env,
+        jobject obj);
+}
+;
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeWorldStreamer_ctor(JNIEnv * env,
+        jobject obj, jlong jscene) {
+    std::shared_ptr<Scene> scene =
+            *reinterpret_cast<std::shared_ptr<Scene>*>(jscene);
+    return reinterpret_cast<jlong>(new std::shared_ptr<WorldStreamer>(
+            new WorldStreamer(scene)));
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeWorldStreamer_addCell(JNIEnv * env,
+        jobject obj, jlong jworld_streamer, jstring path, jfloat x, jfloat y,
+        jfloat z, jfloat radius) {
+    std::shared_ptr<WorldStreamer> world_streamer = *reinterpret_cast<std::shared_ptr<
+            WorldStreamer>*>(jworld_streamer);
+    const char* native_path = env->GetStringUTFChars(path, 0);
+    int cell = world_streamer->addCell(std::string(native_path),
+            glm::vec3(x, y, z), radius);
+    env->ReleaseStringUTFChars(path, native_path);
+    return cell;
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeWorldStreamer_getCellState(JNIEnv * env,
+        jobject obj, jlong jworld_streamer, jint cell) {
+    std::shared_ptr<WorldStreamer> world_streamer = *reinterpret_cast<std::shared_ptr<
+            WorldStreamer>*>(jworld_streamer);
+    return world_streamer->cell_state(cell);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeWorldStreamer_setLoadDistance(JNIEnv * env,
+        jobject obj, jlong jworld_streamer, jfloat load_distance) {
+    std::shared_ptr<WorldStreamer> world_streamer = *reinterpret_cast<std::shared_ptr<
+            WorldStreamer>*>(jworld_streamer);
+    world_streamer->set_load_distance(load_distance);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeWorldStreamer_setUnloadDistance(JNIEnv * env,
+        jobject obj, jlong jworld_streamer, jfloat unload_distance) {
+    std::shared_ptr<WorldStreamer> world_streamer = *reinterpret_cast<std::shared_ptr<
+            WorldStreamer>*>(jworld_streamer);
+    world_streamer->set_unload_distance(unload_distance);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeWorldStreamer_setFrameBudget(JNIEnv * env,
+        jobject obj, jlong jworld_streamer, jlong frame_budget) {
+    std::shared_ptr<WorldStreamer> world_streamer = *reinterpret_cast<std::shared_ptr<
+            WorldStreamer>*>(jworld_streamer);
+    world_streamer->set_frame_budget(frame_budget);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeWorldStreamer_setMaxResidentCells(JNIEnv * env,
+        jobject obj, jlong jworld_streamer, jint max_resident_cells) {
+    std::shared_ptr<WorldStreamer> world_streamer = *reinterpret_cast<std::shared_ptr<
+            WorldStreamer>*>(jworld_streamer);
+    world_streamer->set_max_resident_cells(max_resident_cells);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeWorldStreamer_updateAll(JNIEnv * env,
+        jobject obj) {
+    WorldStreamer::updateAll();
+}
+
+}
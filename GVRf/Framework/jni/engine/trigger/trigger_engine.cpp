@@ -0,0 +1,286 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Finds the trigger volumes of a scene that start or stop overlapping.
+ ***************************************************************************/
+
+#include "trigger_engine.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "objects/scene.h"
+#include "objects/components/component_registry.h"
+#include "objects/components/transform.h"
+#include "objects/components/trigger_volume.h"
+
+namespace gvr {
+static const float DEFAULT_CELL_SIZE = 2.0f;
+// volumes spanning more cells go to the brute-force list
+static const int MAX_CELLS_PER_VOLUME = 64;
+// keeps the separating axis test robust for nearly parallel edges
+static const float AXIS_EPSILON = 1.0e-6f;
+
+static inline uint32_t hashCell(int x, int y, int z) {
+    return static_cast<uint32_t>(x) * 73856093u
+            ^ static_cast<uint32_t>(y) * 19349663u
+            ^ static_cast<uint32_t>(z) * 83492791u;
+}
+
+TriggerEngine::TriggerEngine(const std::shared_ptr<Scene>& scene) :
+        HybridObject(), scene_(scene), cell_size_(DEFAULT_CELL_SIZE), volumes_(), large_volumes_(), cells_(), candidates_(), pairs_(), previous_pairs_(), events_() {
+}
+
+TriggerEngine::~TriggerEngine() {
+}
+
+void TriggerEngine::collectVolumes() {
+    volumes_.clear();
+    const ComponentPool<TriggerVolume>& volume_pool = ComponentRegistry::pool<
+            TriggerVolume>();
+    for (int i = 0; i < volume_pool.size(); ++i) {
+        const EntityHotData& hot_data = ComponentRegistry::hot_data(
+                volume_pool.entity(i));
+        if (hot_data.scene != scene_.get() || !hot_data.active
+                || hot_data.transform == 0) {
+            continue;
+        }
+
+        const std::shared_ptr<TriggerVolume>& volume = volume_pool.component(
+                i);
+        glm::mat4 model_matrix = hot_data.transform->getModelMatrix();
+        glm::vec3 scale(glm::length(glm::vec3(model_matrix[0])),
+                glm::length(glm::vec3(model_matrix[1])),
+                glm::length(glm::vec3(model_matrix[2])));
+
+        WorldVolume world_volume;
+        world_volume.volume = &volume;
+        world_volume.sphere = volume->shape() == TriggerVolume::SPHERE;
+        world_volume.center = glm::vec3(
+                model_matrix * glm::vec4(volume->center(), 1.0f));
+        glm::vec3 extent;
+        if (world_volume.sphere) {
+            world_volume.radius = volume->radius()
+                    * std::max(scale.x, std::max(scale.y, scale.z));
+            extent = glm::vec3(world_volume.radius);
+        } else {
+            for (int axis = 0; axis < 3; ++axis) {
+                world_volume.axes[axis] =
+                        scale[axis] > 0.0f ?
+                                glm::vec3(model_matrix[axis]) / scale[axis] :
+                                glm::vec3();
+            }
+            world_volume.half_extents = volume->half_extents() * scale;
+            for (int axis = 0; axis < 3; ++axis) {
+                extent += glm::abs(world_volume.axes[axis])
+                        * world_volume.half_extents[axis];
+            }
+        }
+        world_volume.min = world_volume.center - extent;
+        world_volume.max = world_volume.center + extent;
+        volumes_.push_back(world_volume);
+    }
+}
+
+void TriggerEngine::findCandidates() {
+    cells_.clear();
+    large_volumes_.clear();
+    candidates_.clear();
+
+    float inverse_cell_size = 1.0f / cell_size_;
+    for (int i = 0; i < volumes_.size(); ++i) {
+        glm::vec3 low = glm::floor(volumes_[i].min * inverse_cell_size);
+        glm::vec3 high = glm::floor(volumes_[i].max * inverse_cell_size);
+        glm::vec3 span = high - low + glm::vec3(1.0f);
+        if (span.x * span.y * span.z > MAX_CELLS_PER_VOLUME) {
+            large_volumes_.push_back(i);
+            continue;
+        }
+        for (int x = low.x; x <= high.x; ++x) {
+            for (int y = low.y; y <= high.y; ++y) {
+                for (int z = low.z; z <= high.z; ++z) {
+                    cells_.push_back(std::make_pair(hashCell(x, y, z), i));
+                }
+            }
+        }
+    }
+    std::sort(cells_.begin(), cells_.end());
+
+    for (int begin = 0; begin < cells_.size();) {
+        int end = begin + 1;
+        while (end < cells_.size() && cells_[end].first == cells_[begin].first) {
+            ++end;
+        }
+        for (int i = begin; i < end; ++i) {
+            for (int j = i + 1; j < end; ++j) {
+                // two cells of one volume may share a hash
+                if (cells_[i].second != cells_[j].second) {
+                    candidates_.push_back(
+                            std::make_pair(cells_[i].second,
+                                    cells_[j].second));
+                }
+            }
+        }
+        begin = end;
+    }
+    for (auto it = large_volumes_.begin(); it != large_volumes_.end(); ++it) {
+        for (int i = 0; i < volumes_.size(); ++i) {
+            if (i != *it) {
+                candidates_.push_back(
+                        std::make_pair(std::min(i, *it), std::max(i, *it)));
+            }
+        }
+    }
+
+    // volumes sharing several cells, or two large volumes, repeat a pair
+    std::sort(candidates_.begin(), candidates_.end());
+    candidates_.erase(std::unique(candidates_.begin(), candidates_.end()),
+            candidates_.end());
+}
+
+static bool overlapsSphereBox(const glm::vec3& center, float radius,
+        const glm::vec3& box_center, const glm::mat3& axes,
+        const glm::vec3& half_extents) {
+    glm::vec3 offset = center - box_center;
+    float distance_squared = 0.0f;
+    for (int axis = 0; axis < 3; ++axis) {
+        float local = glm::dot(offset, axes[axis]);
+        float excess = std::fabs(local) - half_extents[axis];
+        if (excess > 0.0f) {
+            distance_squared += excess * excess;
+        }
+    }
+    return distance_squared <= radius * radius;
+}
+
+// separating axis test on the 15 candidate axes of two boxes
+static bool overlapsBoxBox(const glm::vec3& center_a, const glm::mat3& axes_a,
+        const glm::vec3& a, const glm::vec3& center_b,
+        const glm::mat3& axes_b, const glm::vec3& b) {
+    float r[3][3];
+    float abs_r[3][3];
+    for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            r[i][j] = glm::dot(axes_a[i], axes_b[j]);
+            abs_r[i][j] = std::fabs(r[i][j]) + AXIS_EPSILON;
+        }
+    }
+    glm::vec3 offset = center_b - center_a;
+    float t[3] = { glm::dot(offset, axes_a[0]), glm::dot(offset, axes_a[1]),
+            glm::dot(offset, axes_a[2]) };
+
+    for (int i = 0; i < 3; ++i) {
+        float rb = b[0] * abs_r[i][0] + b[1] * abs_r[i][1]
+                + b[2] * abs_r[i][2];
+        if (std::fabs(t[i]) > a[i] + rb) {
+            return false;
+        }
+    }
+    for (int j = 0; j < 3; ++j) {
+        float ra = a[0] * abs_r[0][j] + a[1] * abs_r[1][j]
+                + a[2] * abs_r[2][j];
+        if (std::fabs(t[0] * r[0][j] + t[1] * r[1][j] + t[2] * r[2][j])
+                > ra + b[j]) {
+            return false;
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        int i1 = (i + 1) % 3;
+        int i2 = (i + 2) % 3;
+        for (int j = 0; j < 3; ++j) {
+            int j1 = (j + 1) % 3;
+            int j2 = (j + 2) % 3;
+            float ra = a[i1] * abs_r[i2][j] + a[i2] * abs_r[i1][j];
+            float rb = b[j1] * abs_r[i][j2] + b[j2] * abs_r[i][j1];
+            if (std::fabs(t[i2] * r[i1][j] - t[i1] * r[i2][j]) > ra + rb) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool TriggerEngine::overlaps(const WorldVolume& a, const WorldVolume& b) {
+    if (a.sphere && b.sphere) {
+        float radius = a.radius + b.radius;
+        glm::vec3 offset = a.center - b.center;
+        return glm::dot(offset, offset) <= radius * radius;
+    } else if (a.sphere) {
+        return overlapsSphereBox(a.center, a.radius, b.center, b.axes,
+                b.half_extents);
+    } else if (b.sphere) {
+        return overlapsSphereBox(b.center, b.radius, a.center, a.axes,
+                a.half_extents);
+    } else {
+        return overlapsBoxBox(a.center, a.axes, a.half_extents, b.center,
+                b.axes, b.half_extents);
+    }
+}
+
+const std::vector<TriggerEngine::Event>& TriggerEngine::update() {
+    collectVolumes();
+    findCandidates();
+
+    previous_pairs_.swap(pairs_);
+    pairs_.clear();
+    for (auto it = candidates_.begin(); it != candidates_.end(); ++it) {
+        const WorldVolume& a = volumes_[it->first];
+        const WorldVolume& b = volumes_[it->second];
+        if (glm::any(glm::lessThan(a.max, b.min))
+                || glm::any(glm::lessThan(b.max, a.min)) || !overlaps(a, b)) {
+            continue;
+        }
+        Pair pair;
+        if (a.volume->get() < b.volume->get()) {
+            pair.first = *a.volume;
+            pair.second = *b.volume;
+        } else {
+            pair.first = *b.volume;
+            pair.second = *a.volume;
+        }
+        pairs_.push_back(pair);
+    }
+    std::sort(pairs_.begin(), pairs_.end());
+
+    events_.clear();
+    auto current = pairs_.begin();
+    auto previous = previous_pairs_.begin();
+    while (current != pairs_.end() || previous != previous_pairs_.end()) {
+        Event event;
+        if (previous == previous_pairs_.end()
+                || (current != pairs_.end() && *current < *previous)) {
+            event.enter = true;
+            event.first = current->first;
+            event.second = current->second;
+            events_.push_back(event);
+            ++current;
+        } else if (current == pairs_.end() || *previous < *current) {
+            event.enter = false;
+            event.first = previous->first;
+            event.second = previous->second;
+            events_.push_back(event);
+            ++previous;
+        } else {
+            ++current;
+            ++previous;
+        }
+    }
+    previous_pairs_.clear();
+    return events_;
+}
+
+}
@@ -0,0 +1,128 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Finds the trigger volumes of a scene that start or stop overlapping.
+ ***************************************************************************/
+
+#ifndef TRIGGER_ENGINE_H_
+#define TRIGGER_ENGINE_H_
+
+#include <memory>
+#include <stdint.h>
+#include <utility>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "objects/hybrid_object.h"
+
+namespace gvr {
+class Scene;
+class TriggerVolume;
+
+/*
+ * Once per frame, the world bounds of every active trigger volume are
+ * hashed into a uniform grid; the (hash, volume) pairs are sorted so each
+ * run of equal hashes lists the volumes sharing a cell. Candidate pairs
+ * from those runs are tested exactly, and the overlapping pairs are diffed
+ * against the previous frame to produce only enter and exit events. The
+ * working arrays are kept between frames, so a steady frame does not
+ * allocate.
+ */
+class TriggerEngine: public HybridObject {
+public:
+    struct Event {
+        bool enter;
+        std::shared_ptr<TriggerVolume> first;
+        std::shared_ptr<TriggerVolume> second;
+    };
+
+    explicit TriggerEngine(const std::shared_ptr<Scene>& scene);
+    ~TriggerEngine();
+
+    float cell_size() const {
+        return cell_size_;
+    }
+
+    // about the size of a typical volume works best
+    void set_cell_size(float cell_size) {
+        cell_size_ = cell_size;
+    }
+
+    // GL thread only; the events stay valid until the next update
+    const std::vector<Event>& update();
+
+    // number of overlapping pairs after the last update
+    int overlap_count() const {
+        return pairs_.size();
+    }
+
+private:
+    struct WorldVolume {
+        // into the component pool, which does not change during update
+        const std::shared_ptr<TriggerVolume>* volume;
+        bool sphere;
+        glm::vec3 center;
+        // unit axes of a box, in columns
+        glm::mat3 axes;
+        glm::vec3 half_extents;
+        float radius;
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    struct Pair {
+        bool operator<(const Pair& pair) const {
+            return first.get() < pair.first.get()
+                    || (first.get() == pair.first.get()
+                            && second.get() < pair.second.get());
+        }
+
+        bool operator==(const Pair& pair) const {
+            return first == pair.first && second == pair.second;
+        }
+
+        std::shared_ptr<TriggerVolume> first;
+        std::shared_ptr<TriggerVolume> second;
+    };
+
+    void collectVolumes();
+    void findCandidates();
+    static bool overlaps(const WorldVolume& a, const WorldVolume& b);
+
+    TriggerEngine(const TriggerEngine& trigger_engine);
+    TriggerEngine(TriggerEngine&& trigger_engine);
+    TriggerEngine& operator=(const TriggerEngine& trigger_engine);
+    TriggerEngine& operator=(TriggerEngine&& trigger_engine);
+
+private:
+    std::shared_ptr<Scene> scene_;
+    float cell_size_;
+
+    std::vector<WorldVolume> volumes_;
+    // volumes too large for the grid are tested against every other one
+    std::vector<int> large_volumes_;
+    std::vector<std::pair<uint32_t, int>> cells_;
+    std::vector<std::pair<int, int>> candidates_;
+    // sorted; holding the volumes keeps their addresses from being reused
+    std::vector<Pair> pairs_;
+    std::vector<Pair> previous_pairs_;
+    std::vector<Event> events_;
+};
+
+}
+#endif
@@ -0,0 +1,97 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "trigger_engine.h"
+
+#include "objects/scene.h"
+#include "objects/components/trigger_volume.h"
+#include "util/gvr_jni.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeTriggerEngine_ctor(JNIEnv * env,
+        jobject obj, jlong jscene);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTriggerEngine_setCellSize(JNIEnv * env,
+        jobject obj, jlong jtrigger_engine, jfloat cell_size);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeTriggerEngine_getOverlapCount(JNIEnv * env,
+        jobject obj, jlong jtrigger_engine);
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeTriggerEngine_update(JNIEnv * env,
+        jobject obj, jlong jtrigger_engine);
+}
+;
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeTriggerEngine_ctor(JNIEnv * env,
+        jobject obj, jlong jscene) {
+    std::shared_ptr<Scene> scene =
+            *reinterpret_cast<std::shared_ptr<Scene>*>(jscene);
+    return reinterpret_cast<jlong>(new std::shared_ptr<TriggerEngine>(
+            new TriggerEngine(scene)));
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTriggerEngine_setCellSize(JNIEnv * env,
+        jobject obj, jlong jtrigger_engine, jfloat cell_size) {
+    std::shared_ptr<TriggerEngine> trigger_engine = *reinterpret_cast<std::shared_ptr<
+            TriggerEngine>*>(jtrigger_engine);
+    trigger_engine->set_cell_size(cell_size);
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeTriggerEngine_getOverlapCount(JNIEnv * env,
+        jobject obj, jlong jtrigger_engine) {
+    std::shared_ptr<TriggerEngine> trigger_engine = *reinterpret_cast<std::shared_ptr<
+            TriggerEngine>*>(jtrigger_engine);
+    return trigger_engine->overlap_count();
+}
+
+// one (enter, first, second) triple per event; null when nothing changed
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeTriggerEngine_update(JNIEnv * env,
+        jobject obj, jlong jtrigger_engine) {
+    std::shared_ptr<TriggerEngine> trigger_engine = *reinterpret_cast<std::shared_ptr<
+            TriggerEngine>*>(jtrigger_engine);
+    const std::vector<TriggerEngine::Event>& events = trigger_engine->update();
+    if (events.empty()) {
+        return 0;
+    }
+
+    std::vector<jlong> long_events;
+    long_events.reserve(events.size() * 3);
+    for (auto it = events.begin(); it != events.end(); ++it) {
+        long_events.push_back(it->enter ? 1 : 0);
+        long_events.push_back(
+                reinterpret_cast<jlong>(new std::shared_ptr<TriggerVolume>(
+                        it->first)));
+        long_events.push_back(
+                reinterpret_cast<jlong>(new std::shared_ptr<TriggerVolume>(
+                        it->second)));
+    }
+    jlongArray jevents = env->NewLongArray(long_events.size());
+    env->SetLongArrayRegion(jevents, 0, long_events.size(),
+            long_events.data());
+    return jevents;
+}
+
+}
@@ -38,6 +38,12 @@ public:
         return id_;
     }
 
+    // for a lost context, which took the buffer with it: the id may
+    // already name a buffer of the new context
+    void abandon() {
+        id_ = 0;
+    }
+
 private:
     GLBuffer(const GLBuffer& gl_buffer);
     GLBuffer(GLBuffer&& gl_buffer);
@@ -0,0 +1,122 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * A ring buffer for uploading changed data to GL buffers without stalls.
+ ***************************************************************************/
+
+#include "gl_stream_buffer.h"
+
+#include <cstring>
+
+#include "util/gvr_log.h"
+
+namespace gvr {
+// a second; a fence that old is a lost context, not a busy GPU
+static const GLuint64 FENCE_TIMEOUT = 1000000000ULL;
+// big enough for a few procedural meshes a frame; larger updates bypass it
+static const int CURRENT_SIZE = 4 * 1024 * 1024;
+
+std::unique_ptr<GLStreamBuffer> GLStreamBuffer::current_;
+
+GLStreamBuffer::GLStreamBuffer(int size) :
+        buffer_(), segment_size_((size / SEGMENT_COUNT) & ~3), segment_(0), position_(
+                0) {
+    for (int i = 0; i < SEGMENT_COUNT; ++i) {
+        fences_[i] = 0;
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer_.id());
+    glBufferData(GL_COPY_READ_BUFFER, segment_size_ * SEGMENT_COUNT, 0,
+            GL_STREAM_DRAW);
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+}
+
+GLStreamBuffer::~GLStreamBuffer() {
+    for (int i = 0; i < SEGMENT_COUNT; ++i) {
+        if (fences_[i] != 0) {
+            glDeleteSync(fences_[i]);
+        }
+    }
+}
+
+void GLStreamBuffer::enterSegment(int segment) {
+    fences_[segment_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (fences_[segment] != 0) {
+        GLenum result = glClientWaitSync(fences_[segment],
+                GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT);
+        if (result == GL_TIMEOUT_EXPIRED || result == GL_WAIT_FAILED) {
+            LOGW("GLStreamBuffer::enterSegment() : fence wait failed");
+        }
+        glDeleteSync(fences_[segment]);
+        fences_[segment] = 0;
+    }
+    segment_ = segment;
+    position_ = segment * segment_size_;
+}
+
+void GLStreamBuffer::upload(GLuint target, GLintptr offset, const void* data,
+        GLsizeiptr size) {
+    if (size <= 0) {
+        return;
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, target);
+    if (size > segment_size_) {
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        return;
+    }
+
+    // an upload never spans two segments
+    if (position_ + size > (segment_ + 1) * segment_size_) {
+        enterSegment((segment_ + 1) % SEGMENT_COUNT);
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer_.id());
+    void* mapped = glMapBufferRange(GL_COPY_READ_BUFFER, position_, size,
+            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+                    | GL_MAP_UNSYNCHRONIZED_BIT);
+    if (mapped != 0) {
+        memcpy(mapped, data, size);
+        glUnmapBuffer(GL_COPY_READ_BUFFER);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                position_, offset, size);
+    } else {
+        glBufferSubData(GL_COPY_WRITE_BUFFER, offset, size, data);
+    }
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    position_ = (position_ + size + 3) & ~3;
+}
+
+GLStreamBuffer& GLStreamBuffer::current() {
+    if (!current_) {
+        current_.reset(new GLStreamBuffer(CURRENT_SIZE));
+    }
+    return *current_;
+}
+
+void GLStreamBuffer::onContextCreated() {
+    if (current_) {
+        current_->buffer_.abandon();
+        for (int i = 0; i < SEGMENT_COUNT; ++i) {
+            current_->fences_[i] = 0;
+        }
+        current_.reset();
+    }
+}
+
+}
@@ -0,0 +1,76 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * A ring buffer for uploading changed data to GL buffers without stalls.
+ ***************************************************************************/
+
+#ifndef GL_STREAM_BUFFER_H_
+#define GL_STREAM_BUFFER_H_
+
+#include <memory>
+
+#include "GLES3/gl3.h"
+
+#include "gl/gl_buffer.h"
+
+namespace gvr {
+
+/*
+ * The ring is split into SEGMENT_COUNT segments. Data is written into the
+ * ring with unsynchronized maps, then copied on the GPU to its target, so
+ * the CPU never waits for a draw using the target. A fence goes behind
+ * each segment as the writes leave it, and is waited on only when the
+ * writes come back around to it, normally long after the GPU is done.
+ */
+class GLStreamBuffer {
+public:
+    static const int SEGMENT_COUNT = 4;
+
+    explicit GLStreamBuffer(int size);
+    ~GLStreamBuffer();
+
+    // GL thread only; uploads larger than a segment go straight to target
+    void upload(GLuint target, GLintptr offset, const void* data,
+            GLsizeiptr size);
+
+    // the ring of the current GL context, created on first use
+    static GLStreamBuffer& current();
+    // call with each new GL context; the ring of the previous one went
+    // with it, so it is forgotten rather than deleted
+    static void onContextCreated();
+
+private:
+    GLStreamBuffer(const GLStreamBuffer& gl_stream_buffer);
+    GLStreamBuffer(GLStreamBuffer&& gl_stream_buffer);
+    GLStreamBuffer& operator=(const GLStreamBuffer& gl_stream_buffer);
+    GLStreamBuffer& operator=(GLStreamBuffer&& gl_stream_buffer);
+
+    void enterSegment(int segment);
+
+private:
+    GLBuffer buffer_;
+    int segment_size_;
+    int segment_;
+    int position_;
+    GLsync fences_[SEGMENT_COUNT];
+
+    static std::unique_ptr<GLStreamBuffer> current_;
+};
+
+}
+
+#endif
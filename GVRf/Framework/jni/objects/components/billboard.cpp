@@ -0,0 +1,273 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Turns its owner to face the main camera rig every frame.
+ ***************************************************************************/
+
+#include "billboard.h"
+
+#include <cmath>
+#include <vector>
+
+#if defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+#include "glm/gtx/quaternion.hpp"
+
+#include "objects/scene.h"
+#include "objects/scene_object.h"
+#include "objects/components/camera_rig.h"
+#include "objects/components/component_registry.h"
+#include "objects/components/transform.h"
+
+namespace gvr {
+// below this squared length a direction is treated as zero
+static const float EPSILON = 1.0e-12f;
+
+Billboard::Billboard() :
+        Component(), mode_(SPHERICAL), axis_(0.0f, 1.0f, 0.0f), axis_rotation_() {
+}
+
+Billboard::~Billboard() {
+}
+
+void Billboard::set_axis(const glm::vec3& axis) {
+    axis_ = glm::normalize(axis);
+    axis_rotation_ = glm::rotation(glm::vec3(0.0f, 1.0f, 0.0f), axis_);
+}
+
+/*
+ * Of (1 + cos) / 2 and (1 - cos) / 2, the larger is at least 1/2; its root
+ * gives one half-angle function accurately, and the other follows from
+ * sin = 2 sin(a / 2) cos(a / 2). Taking the root of the smaller one would
+ * lose half the precision near 0 and 180 degrees.
+ */
+static inline void halfAngle(float cosine, float sine, float& cos_half,
+        float& sin_half) {
+    if (cosine >= 0.0f) {
+        cos_half = std::sqrt((1.0f + cosine) * 0.5f);
+        sin_half = sine * 0.5f / cos_half;
+    } else {
+        sin_half = std::sqrt((1.0f - cosine) * 0.5f);
+        cos_half = std::fabs(sine) * 0.5f / sin_half;
+        if (sine < 0.0f) {
+            sin_half = -sin_half;
+        }
+    }
+}
+
+#if defined(__ARM_NEON__)
+static inline float32x4_t reciprocalSqrt(float32x4_t x) {
+    // the estimate has 8 bits; two Newton-Raphson steps bring it to float
+    float32x4_t estimate = vrsqrteq_f32(x);
+    estimate = vmulq_f32(estimate,
+            vrsqrtsq_f32(vmulq_f32(x, estimate), estimate));
+    estimate = vmulq_f32(estimate,
+            vrsqrtsq_f32(vmulq_f32(x, estimate), estimate));
+    return estimate;
+}
+
+static inline void halfAngle(float32x4_t cosine, float32x4_t sine,
+        float32x4_t& cos_half, float32x4_t& sin_half) {
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t half = vdupq_n_f32(0.5f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    uint32x4_t front = vcgeq_f32(cosine, zero);
+    float32x4_t larger = vmulq_f32(
+            vbslq_f32(front, vaddq_f32(one, cosine), vsubq_f32(one, cosine)),
+            half);
+    float32x4_t inverse_root = reciprocalSqrt(larger);
+    float32x4_t root = vmulq_f32(larger, inverse_root);
+    float32x4_t other = vmulq_f32(vmulq_f32(sine, half), inverse_root);
+    cos_half = vbslq_f32(front, root, vabsq_f32(other));
+    sin_half = vbslq_f32(front, other,
+            vbslq_f32(vcltq_f32(sine, zero), vnegq_f32(root), root));
+}
+#endif
+
+/*
+ * With d the unit direction and h its length in the xz plane, the yaw has
+ * cosine dz / h and sine dx / h, and the pitch cosine h and sine -dy. The
+ * half angles are derived from those, so no trigonometric function is
+ * evaluated.
+ */
+void Billboard::computeRotations(const float* dx, const float* dy,
+        const float* dz, float* qw, float* qx, float* qy, float* qz,
+        int count) {
+    int i = 0;
+#if defined(__ARM_NEON__)
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    const float32x4_t epsilon = vdupq_n_f32(EPSILON);
+    for (; i + 4 <= count; i += 4) {
+        float32x4_t x = vld1q_f32(dx + i);
+        float32x4_t y = vld1q_f32(dy + i);
+        float32x4_t z = vld1q_f32(dz + i);
+
+        float32x4_t horizontal = vmlaq_f32(vmulq_f32(x, x), z, z);
+        float32x4_t length = vmlaq_f32(horizontal, y, y);
+        uint32x4_t flat = vcltq_f32(horizontal, epsilon);
+        float32x4_t inverse_horizontal = reciprocalSqrt(
+                vmaxq_f32(horizontal, epsilon));
+        float32x4_t inverse_length = reciprocalSqrt(
+                vmaxq_f32(length, epsilon));
+
+        // straight above or below, or on top of the camera: no yaw
+        float32x4_t cos_yaw = vbslq_f32(flat, one,
+                vmulq_f32(z, inverse_horizontal));
+        float32x4_t sin_yaw = vbslq_f32(flat, zero,
+                vmulq_f32(x, inverse_horizontal));
+        float32x4_t cos_pitch = vmulq_f32(
+                vmulq_f32(horizontal, inverse_horizontal), inverse_length);
+        cos_pitch = vbslq_f32(flat,
+                vbslq_f32(vcltq_f32(length, epsilon), one, zero), cos_pitch);
+        float32x4_t sin_pitch = vnegq_f32(vmulq_f32(y, inverse_length));
+
+        float32x4_t cos_half_yaw, sin_half_yaw;
+        halfAngle(cos_yaw, sin_yaw, cos_half_yaw, sin_half_yaw);
+        float32x4_t cos_half_pitch, sin_half_pitch;
+        halfAngle(cos_pitch, sin_pitch, cos_half_pitch, sin_half_pitch);
+
+        vst1q_f32(qw + i, vmulq_f32(cos_half_yaw, cos_half_pitch));
+        vst1q_f32(qx + i, vmulq_f32(cos_half_yaw, sin_half_pitch));
+        vst1q_f32(qy + i, vmulq_f32(sin_half_yaw, cos_half_pitch));
+        vst1q_f32(qz + i,
+                vnegq_f32(vmulq_f32(sin_half_yaw, sin_half_pitch)));
+    }
+#endif
+    for (; i < count; ++i) {
+        float horizontal = dx[i] * dx[i] + dz[i] * dz[i];
+        float length = horizontal + dy[i] * dy[i];
+        float cos_yaw = 1.0f;
+        float sin_yaw = 0.0f;
+        float cos_pitch = length < EPSILON ? 1.0f : 0.0f;
+        float sin_pitch = length < EPSILON ? 0.0f : -dy[i] / std::sqrt(length);
+        if (horizontal >= EPSILON) {
+            float horizontal_length = std::sqrt(horizontal);
+            cos_yaw = dz[i] / horizontal_length;
+            sin_yaw = dx[i] / horizontal_length;
+            cos_pitch = horizontal_length / std::sqrt(length);
+        }
+
+        float cos_half_yaw, sin_half_yaw;
+        halfAngle(cos_yaw, sin_yaw, cos_half_yaw, sin_half_yaw);
+        float cos_half_pitch, sin_half_pitch;
+        halfAngle(cos_pitch, sin_pitch, cos_half_pitch, sin_half_pitch);
+
+        qw[i] = cos_half_yaw * cos_half_pitch;
+        qx[i] = cos_half_yaw * sin_half_pitch;
+        qy[i] = sin_half_yaw * cos_half_pitch;
+        qz[i] = -sin_half_yaw * sin_half_pitch;
+    }
+}
+
+void Billboard::updateAll(Scene* scene) {
+    const ComponentPool<Billboard>& billboard_pool = ComponentRegistry::pool<
+            Billboard>();
+    if (billboard_pool.size() == 0) {
+        return;
+    }
+    std::shared_ptr<CameraRig> camera_rig = scene->main_camera_rig();
+    if (!camera_rig) {
+        return;
+    }
+    std::shared_ptr<SceneObject> camera_object = camera_rig->owner_object();
+    if (!camera_object || !camera_object->transform()) {
+        return;
+    }
+    glm::vec3 camera_position(
+            camera_object->transform()->getModelMatrix()[3]);
+
+    // kept between frames so the batch does not allocate
+    static std::vector<int> indices;
+    static std::vector<float> directions;
+    static std::vector<float> rotations;
+
+    indices.clear();
+    for (int i = 0; i < billboard_pool.size(); ++i) {
+        int entity = billboard_pool.entity(i);
+        const EntityHotData& hot_data = ComponentRegistry::hot_data(entity);
+        if (hot_data.scene == scene && hot_data.active
+                && hot_data.transform != 0
+                && ComponentRegistry::shouldUpdate(entity)) {
+            indices.push_back(i);
+        }
+    }
+    int count = indices.size();
+    int padded_count = (count + 3) & ~3;
+    directions.resize(3 * padded_count);
+    rotations.resize(4 * padded_count);
+    float* dx = directions.data();
+    float* dy = dx + padded_count;
+    float* dz = dy + padded_count;
+
+    for (int i = 0; i < count; ++i) {
+        const Billboard* billboard = billboard_pool.component(indices[i]).get();
+        Transform* transform = ComponentRegistry::hot_data(
+                billboard_pool.entity(indices[i])).transform;
+        glm::vec3 direction = camera_position
+                - glm::vec3(transform->getModelMatrix()[3]);
+        if (billboard->mode_ == AXIS_LOCKED) {
+            direction = glm::conjugate(billboard->axis_rotation_) * direction;
+            direction.y = 0.0f;
+        }
+        dx[i] = direction.x;
+        dy[i] = direction.y;
+        dz[i] = direction.z;
+    }
+    for (int i = count; i < padded_count; ++i) {
+        dx[i] = 0.0f;
+        dy[i] = 0.0f;
+        dz[i] = 1.0f;
+    }
+
+    float* qw = rotations.data();
+    float* qx = qw + padded_count;
+    float* qy = qx + padded_count;
+    float* qz = qy + padded_count;
+    computeRotations(dx, dy, dz, qw, qx, qy, qz, padded_count);
+
+    for (int i = 0; i < count; ++i) {
+        const Billboard* billboard = billboard_pool.component(indices[i]).get();
+        const EntityHotData& hot_data = ComponentRegistry::hot_data(
+                billboard_pool.entity(indices[i]));
+        glm::quat rotation(qw[i], qx[i], qy[i], qz[i]);
+        if (billboard->mode_ == AXIS_LOCKED) {
+            rotation = billboard->axis_rotation_ * rotation;
+        }
+
+        // the rotation is in world space; undo the parent's
+        std::shared_ptr<SceneObject> parent =
+                hot_data.scene_object->parent();
+        if (parent && parent->transform()) {
+            glm::mat4 parent_matrix = parent->transform()->getModelMatrix();
+            glm::mat3 parent_rotation(glm::normalize(glm::vec3(parent_matrix[0])),
+                    glm::normalize(glm::vec3(parent_matrix[1])),
+                    glm::normalize(glm::vec3(parent_matrix[2])));
+            rotation = glm::inverse(glm::quat_cast(parent_rotation))
+                    * rotation;
+        }
+
+        // an unchanged rotation keeps the snapshot entry clean
+        if (rotation != hot_data.transform->rotation()) {
+            hot_data.transform->set_rotation(rotation);
+        }
+    }
+}
+
+}
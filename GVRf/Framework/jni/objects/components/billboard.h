@@ -0,0 +1,89 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Turns its owner to face the main camera rig every frame.
+ ***************************************************************************/
+
+#ifndef BILLBOARD_H_
+#define BILLBOARD_H_
+
+#include "glm/glm.hpp"
+#include "glm/gtc/quaternion.hpp"
+
+#include "objects/components/component.h"
+
+namespace gvr {
+class Scene;
+
+/*
+ * The +z axis of the owner is turned toward the camera rig. A spherical
+ * billboard also pitches; an axis-locked one only spins around its axis,
+ * given in world space. All the billboards of a scene are evaluated in one
+ * batch, four at a time with NEON, and the owner's transform rotation is
+ * overwritten.
+ */
+class Billboard: public Component {
+public:
+    enum Mode {
+        SPHERICAL = 0, AXIS_LOCKED = 1
+    };
+
+    Billboard();
+    ~Billboard();
+
+    Mode mode() const {
+        return mode_;
+    }
+
+    void set_mode(Mode mode) {
+        mode_ = mode;
+    }
+
+    const glm::vec3& axis() const {
+        return axis_;
+    }
+
+    void set_axis(const glm::vec3& axis);
+
+    // GL thread only, once per frame before the eyes are drawn; faces the
+    // position of the rig, which prediction does not change
+    static void updateAll(Scene* scene);
+
+    /*
+     * For each direction, writes the rotation taking +z to it, with yaw
+     * about +y applied after pitch about +x. The arrays hold count values
+     * padded to a multiple of 4.
+     */
+    static void computeRotations(const float* dx, const float* dy,
+            const float* dz, float* qw, float* qx, float* qy, float* qz,
+            int count);
+
+private:
+    Billboard(const Billboard& billboard);
+    Billboard(Billboard&& billboard);
+    Billboard& operator=(const Billboard& billboard);
+    Billboard& operator=(Billboard&& billboard);
+
+private:
+    Mode mode_;
+    glm::vec3 axis_;
+    // rotates +y onto axis_
+    glm::quat axis_rotation_;
+};
+
+}
+#endif
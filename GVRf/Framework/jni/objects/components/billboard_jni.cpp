@@ -0,0 +1,85 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "billboard.h"
+
+#include "objects/scene.h"
+#include "util/gvr_jni.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeBillboard_ctor(JNIEnv * env,
+        jobject obj);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeBillboard_getMode(JNIEnv * env,
+        jobject obj, jlong jbillboard);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeBillboard_setMode(JNIEnv * env,
+        jobject obj, jlong jbillboard, jint mode);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeBillboard_setAxis(JNIEnv * env,
+        jobject obj, jlong jbillboard, jfloat x, jfloat y, jfloat z);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeBillboard_updateAll(JNIEnv * env,
+        jobject obj, jlong jscene);
+}
+;
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeBillboard_ctor(JNIEnv * env,
+        jobject obj) {
+    return reinterpret_cast<jlong>(new std::shared_ptr<Billboard>(
+            new Billboard()));
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeBillboard_getMode(JNIEnv * env,
+        jobject obj, jlong jbillboard) {
+    std::shared_ptr<Billboard> billboard =
+            *reinterpret_cast<std::shared_ptr<Billboard>*>(jbillboard);
+    return billboard->mode();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeBillboard_setMode(JNIEnv * env,
+        jobject obj, jlong jbillboard, jint mode) {
+    std::shared_ptr<Billboard> billboard =
+            *reinterpret_cast<std::shared_ptr<Billboard>*>(jbillboard);
+    billboard->set_mode(static_cast<Billboard::Mode>(mode));
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeBillboard_setAxis(JNIEnv * env,
+        jobject obj, jlong jbillboard, jfloat x, jfloat y, jfloat z) {
+    std::shared_ptr<Billboard> billboard =
+            *reinterpret_cast<std::shared_ptr<Billboard>*>(jbillboard);
+    billboard->set_axis(glm::vec3(x, y, z));
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeBillboard_updateAll(JNIEnv * env,
+        jobject obj, jlong jscene) {
+    std::shared_ptr<Scene> scene =
+            *reinterpret_cast<std::shared_ptr<Scene>*>(jscene);
+    Billboard::updateAll(scene.get());
+}
+
+}
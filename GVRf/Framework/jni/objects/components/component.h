@@ -53,6 +53,10 @@ public:
         owner_object_.reset();
     }
 
+protected:
+    // queues the owner for the next scene snapshot
+    void markOwnerDirty();
+
 private:
     Component(const Component& component);
     Component(Component&& component);
@@ -29,6 +29,15 @@ extern "C" {
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeComponent_getOwnerObject(JNIEnv * env,
         jobject obj, jlong jcomponent);
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeComponent_isActive(JNIEnv * env,
+        jobject obj, jlong jcomponent);
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeComponent_shouldUpdate(JNIEnv * env,
+        jobject obj, jlong jcomponent);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeComponent_getUpdateState(JNIEnv * env,
+        jobject obj, jlong jcomponent);
 }
 ;
 
@@ -44,4 +53,34 @@ Java_org_gearvrf_NativeComponent_getOwnerObject(JNIEnv * env,
                     owner_object));
 }
 
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeComponent_isActive(JNIEnv * env,
+        jobject obj, jlong jcomponent) {
+    std::shared_ptr<Component> component = *reinterpret_cast<std::shared_ptr<
+            Component>*>(jcomponent);
+    std::shared_ptr<SceneObject> owner_object(component->owner_object());
+    return static_cast<jboolean>(
+            owner_object.get() == NULL || owner_object->active());
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeComponent_shouldUpdate(JNIEnv * env,
+        jobject obj, jlong jcomponent) {
+    std::shared_ptr<Component> component = *reinterpret_cast<std::shared_ptr<
+            Component>*>(jcomponent);
+    std::shared_ptr<SceneObject> owner_object(component->owner_object());
+    return static_cast<jboolean>(
+            owner_object.get() == NULL || owner_object->shouldUpdate());
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeComponent_getUpdateState(JNIEnv * env,
+        jobject obj, jlong jcomponent) {
+    std::shared_ptr<Component> component = *reinterpret_cast<std::shared_ptr<
+            Component>*>(jcomponent);
+    std::shared_ptr<SceneObject> owner_object(component->owner_object());
+    return owner_object.get() == NULL ?
+            SceneObject::UPDATE : owner_object->update_state();
+}
+
 }
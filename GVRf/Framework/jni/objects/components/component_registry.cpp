@@ -0,0 +1,144 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Stores the components of every scene object, one pool per type.
+ ***************************************************************************/
+
+#include "component_registry.h"
+
+#include <algorithm>
+
+namespace gvr {
+// below this fraction of the viewport height an entity is updated at half
+// rate; an entity nobody saw is only updated every INVISIBLE_INTERVAL frames,
+// so whatever moves it into view still does, a little late
+static const float SMALL_SCREEN_SIZE = 0.05f;
+static const int SMALL_INTERVAL = 2;
+static const int INVISIBLE_INTERVAL = 8;
+
+std::vector<EntityHotData> ComponentRegistry::hot_data_;
+std::vector<int> ComponentRegistry::name_ids_;
+std::vector<std::vector<int>> ComponentRegistry::tag_ids_;
+std::vector<EntityVisibility> ComponentRegistry::visibility_;
+int ComponentRegistry::frame_ = 0;
+std::vector<int> ComponentRegistry::free_entities_;
+
+int ComponentRegistry::createEntity(SceneObject* scene_object) {
+    int entity;
+    if (free_entities_.empty()) {
+        entity = hot_data_.size();
+        hot_data_.push_back(EntityHotData());
+        name_ids_.push_back(0);
+        tag_ids_.push_back(std::vector<int>());
+        visibility_.push_back(EntityVisibility());
+    } else {
+        entity = free_entities_.back();
+        free_entities_.pop_back();
+    }
+
+    EntityHotData& hot_data = hot_data_[entity];
+    hot_data.scene_object = scene_object;
+    hot_data.scene = 0;
+    hot_data.transform = 0;
+    hot_data.render_data = 0;
+    hot_data.active = true;
+
+    EntityVisibility& visibility = visibility_[entity];
+    visibility.drawable_frame = frame_;
+    visibility.visible_frame = frame_;
+    visibility.screen_size = 1.0f;
+    visibility.update_culling = true;
+    return entity;
+}
+
+void ComponentRegistry::destroyEntity(int entity) {
+    hot_data_[entity].scene_object = 0;
+    hot_data_[entity].scene = 0;
+    name_ids_[entity] = 0;
+    tag_ids_[entity].clear();
+    free_entities_.push_back(entity);
+}
+
+bool ComponentRegistry::addTag(int entity, int tag_id) {
+    std::vector<int>& tag_ids = tag_ids_[entity];
+    if (std::find(tag_ids.begin(), tag_ids.end(), tag_id) != tag_ids.end()) {
+        return false;
+    }
+    tag_ids.push_back(tag_id);
+    return true;
+}
+
+bool ComponentRegistry::removeTag(int entity, int tag_id) {
+    std::vector<int>& tag_ids = tag_ids_[entity];
+    auto it = std::find(tag_ids.begin(), tag_ids.end(), tag_id);
+    if (it == tag_ids.end()) {
+        return false;
+    }
+    tag_ids.erase(it);
+    return true;
+}
+
+bool ComponentRegistry::markDrawable(int entity) {
+    EntityVisibility& visibility = visibility_[entity];
+    if (visibility.drawable_frame == frame_) {
+        return false;
+    }
+    visibility.drawable_frame = frame_;
+    return true;
+}
+
+bool ComponentRegistry::markVisible(int entity, float screen_size) {
+    EntityVisibility& visibility = visibility_[entity];
+    if (visibility.visible_frame != frame_) {
+        visibility.visible_frame = frame_;
+        visibility.screen_size = screen_size;
+        return true;
+    } else if (screen_size > visibility.screen_size) {
+        visibility.screen_size = screen_size;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+int ComponentRegistry::updateInterval(int entity) {
+    const EntityVisibility& visibility = visibility_[entity];
+    // what draws nothing cannot be seen, so it is never culled
+    if (!visibility.update_culling || visibility.drawable_frame < frame_ - 1) {
+        return 1;
+    } else if (visibility.visible_frame < frame_ - 1) {
+        return INVISIBLE_INTERVAL;
+    } else if (visibility.screen_size < SMALL_SCREEN_SIZE) {
+        return SMALL_INTERVAL;
+    } else {
+        return 1;
+    }
+}
+
+template<>
+void ComponentRegistry::updateHotData<Transform>(int entity,
+        Transform* transform) {
+    hot_data_[entity].transform = transform;
+}
+
+template<>
+void ComponentRegistry::updateHotData<RenderData>(int entity,
+        RenderData* render_data) {
+    hot_data_[entity].render_data = render_data;
+}
+
+}
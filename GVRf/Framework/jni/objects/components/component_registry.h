@@ -0,0 +1,280 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Stores the components of every scene object, one pool per type.
+ ***************************************************************************/
+
+#ifndef COMPONENT_REGISTRY_H_
+#define COMPONENT_REGISTRY_H_
+
+#include <memory>
+#include <vector>
+
+namespace gvr {
+class RenderData;
+class Scene;
+class SceneObject;
+class Transform;
+
+/*
+ * A sparse set: components are packed in a contiguous array so systems can
+ * walk them linearly, and the sparse table maps an entity id to its slot.
+ */
+template<class T>
+class ComponentPool {
+public:
+    ComponentPool() :
+            components_(), entities_(), sparse_() {
+    }
+
+    int size() const {
+        return components_.size();
+    }
+
+    const std::shared_ptr<T>& component(int index) const {
+        return components_[index];
+    }
+
+    int entity(int index) const {
+        return entities_[index];
+    }
+
+    bool contains(int entity) const {
+        return entity < sparse_.size() && sparse_[entity] >= 0;
+    }
+
+    std::shared_ptr<T> get(int entity) const {
+        if (contains(entity)) {
+            return components_[sparse_[entity]];
+        } else {
+            return std::shared_ptr<T>();
+        }
+    }
+
+    void set(int entity, const std::shared_ptr<T>& component) {
+        if (entity >= sparse_.size()) {
+            sparse_.resize(entity + 1, -1);
+        }
+        if (sparse_[entity] >= 0) {
+            components_[sparse_[entity]] = component;
+        } else {
+            sparse_[entity] = components_.size();
+            components_.push_back(component);
+            entities_.push_back(entity);
+        }
+    }
+
+    void remove(int entity) {
+        if (!contains(entity)) {
+            return;
+        }
+        int index = sparse_[entity];
+        int last = components_.size() - 1;
+        if (index != last) {
+            components_[index] = std::move(components_[last]);
+            entities_[index] = entities_[last];
+            sparse_[entities_[index]] = index;
+        }
+        components_.pop_back();
+        entities_.pop_back();
+        sparse_[entity] = -1;
+    }
+
+private:
+    ComponentPool(const ComponentPool& component_pool);
+    ComponentPool(ComponentPool&& component_pool);
+    ComponentPool& operator=(const ComponentPool& component_pool);
+    ComponentPool& operator=(ComponentPool&& component_pool);
+
+private:
+    std::vector<std::shared_ptr<T>> components_;
+    std::vector<int> entities_;
+    std::vector<int> sparse_;
+};
+
+/*
+ * Per-entity data touched every frame. The raw pointers are owned by the
+ * transform and render data pools and are cleared on detach. active caches
+ * whether the entity and all of its ancestors are enabled.
+ */
+struct EntityHotData {
+    SceneObject* scene_object;
+    Scene* scene;
+    Transform* transform;
+    RenderData* render_data;
+    bool active;
+};
+
+/*
+ * What the renderer saw of an entity. drawable_frame is the last frame in
+ * which the entity, or one of its descendants, had render data to draw;
+ * visible_frame the last in which one was inside the view frustum of a
+ * camera; screen_size is the largest fraction of the viewport height its
+ * bounds covered in that frame.
+ */
+struct EntityVisibility {
+    int drawable_frame;
+    int visible_frame;
+    float screen_size;
+    bool update_culling;
+};
+
+class ComponentRegistry {
+private:
+    ComponentRegistry();
+
+public:
+    static int createEntity(SceneObject* scene_object);
+    static void destroyEntity(int entity);
+
+    template<class T>
+    static ComponentPool<T>& pool() {
+        static ComponentPool<T> pool;
+        return pool;
+    }
+
+    template<class T>
+    static std::shared_ptr<T> get(int entity) {
+        return pool<T>().get(entity);
+    }
+
+    template<class T>
+    static void attach(int entity, const std::shared_ptr<T>& component) {
+        pool<T>().set(entity, component);
+        updateHotData<T>(entity, component.get());
+    }
+
+    template<class T>
+    static void detach(int entity) {
+        pool<T>().remove(entity);
+        updateHotData<T>(entity, static_cast<T*>(0));
+    }
+
+    static const EntityHotData& hot_data(int entity) {
+        return hot_data_[entity];
+    }
+
+    static Scene* scene(int entity) {
+        return hot_data_[entity].scene;
+    }
+
+    static void set_scene(int entity, Scene* scene) {
+        hot_data_[entity].scene = scene;
+    }
+
+    static bool active(int entity) {
+        return hot_data_[entity].active;
+    }
+
+    static void set_active(int entity, bool active) {
+        hot_data_[entity].active = active;
+    }
+
+    static int name_id(int entity) {
+        return name_ids_[entity];
+    }
+
+    static void set_name_id(int entity, int name_id) {
+        name_ids_[entity] = name_id;
+    }
+
+    static const std::vector<int>& tag_ids(int entity) {
+        return tag_ids_[entity];
+    }
+
+    // return false if the entity already has, or does not have, the tag
+    static bool addTag(int entity, int tag_id);
+    static bool removeTag(int entity, int tag_id);
+
+    static int frame() {
+        return frame_;
+    }
+
+    // once per frame, before the scripts and animations run
+    static void nextFrame() {
+        ++frame_;
+    }
+
+    // renderer only; returns false if the entity was marked already
+    static bool markDrawable(int entity);
+
+    // renderer only; keeps the largest screen size of the frame, and
+    // returns false if that did not change anything
+    static bool markVisible(int entity, float screen_size);
+
+    // new entities count as visible until they have been rendered once
+    static bool visible_last_frame(int entity) {
+        return visibility_[entity].visible_frame >= frame_ - 1;
+    }
+
+    static float screen_size(int entity) {
+        return visible_last_frame(entity) ?
+                visibility_[entity].screen_size : 0.0f;
+    }
+
+    static bool update_culling(int entity) {
+        return visibility_[entity].update_culling;
+    }
+
+    static void set_update_culling(int entity, bool update_culling) {
+        visibility_[entity].update_culling = update_culling;
+    }
+
+    /*
+     * Every how many frames the entity needs updating: always 1 when update
+     * culling is off or nothing below it is drawn, such as a camera rig or
+     * an empty pivot, otherwise more the less of it was seen last frame.
+     */
+    static int updateInterval(int entity);
+
+    // staggers the updates of entities with the same interval
+    static bool shouldUpdate(int entity) {
+        return (frame_ + entity) % updateInterval(entity) == 0;
+    }
+
+private:
+    template<class T>
+    static void updateHotData(int entity, T* component) {
+    }
+
+    ComponentRegistry(const ComponentRegistry& component_registry);
+    ComponentRegistry(ComponentRegistry&& component_registry);
+    ComponentRegistry& operator=(const ComponentRegistry& component_registry);
+    ComponentRegistry& operator=(ComponentRegistry&& component_registry);
+
+private:
+    // hot: read by the renderer and the picker every frame
+    static std::vector<EntityHotData> hot_data_;
+    // cold: only read on demand; names and tags are StringTable ids
+    static std::vector<int> name_ids_;
+    static std::vector<std::vector<int>> tag_ids_;
+    // warm: written by the renderer, read by the systems that cull updates
+    static std::vector<EntityVisibility> visibility_;
+    static int frame_;
+    static std::vector<int> free_entities_;
+};
+
+template<>
+void ComponentRegistry::updateHotData<Transform>(int entity,
+        Transform* transform);
+
+template<>
+void ComponentRegistry::updateHotData<RenderData>(int entity,
+        RenderData* render_data);
+
+}
+#endif
@@ -0,0 +1,67 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Containing data about how to render an object.
+ ***************************************************************************/
+
+#include "render_data.h"
+
+#include "objects/point_cloud.h"
+
+namespace gvr {
+int RenderData::next_instance_group_ = 1;
+
+int RenderData::joinInstanceGroup() {
+    if (instance_group_ == 0) {
+        instance_group_ = next_instance_group_++;
+    }
+    return instance_group_;
+}
+
+void RenderData::set_point_cloud(
+        const std::shared_ptr<PointCloud>& point_cloud) {
+    set_mesh(point_cloud->mesh());
+    point_cloud_ = point_cloud;
+}
+
+void RenderData::copyFrom(RenderData& render_data) {
+    mesh_ = render_data.mesh_;
+    material_ = render_data.material_;
+    render_mask_ = render_data.render_mask_;
+    rendering_order_ = render_data.rendering_order_;
+    cull_test_ = render_data.cull_test_;
+    offset_ = render_data.offset_;
+    offset_factor_ = render_data.offset_factor_;
+    offset_units_ = render_data.offset_units_;
+    depth_test_ = render_data.depth_test_;
+    alpha_blend_ = render_data.alpha_blend_;
+    line_width_ = render_data.line_width_;
+    point_size_ = render_data.point_size_;
+    frustum_culling_ = render_data.frustum_culling_;
+    // a point cloud is chosen for the view of each copy, so it has its own
+    if (render_data.point_cloud_) {
+        point_cloud_ = render_data.point_cloud_->clone();
+        mesh_ = point_cloud_->mesh();
+        instance_group_ = 0;
+    } else {
+        point_cloud_.reset();
+        instance_group_ = render_data.joinInstanceGroup();
+    }
+    markOwnerDirty();
+}
+
+}
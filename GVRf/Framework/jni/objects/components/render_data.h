@@ -31,6 +31,7 @@
 namespace gvr {
 class Mesh;
 class Material;
+class PointCloud;
 
 class RenderData: public Component {
 public:
@@ -47,7 +48,9 @@ public:
                     DEFAULT_RENDER_MASK), rendering_order_(
                     DEFAULT_RENDERING_ORDER), cull_test_(true), offset_(false), offset_factor_(
                     0.0f), offset_units_(0.0f), depth_test_(true), alpha_blend_(
-                    true) {
+                    true), line_width_(1.0f), point_size_(1.0f), frustum_culling_(
+                    true), point_cloud_(), instance_group_(
+                    0) {
     }
 
     ~RenderData() {
@@ -63,6 +66,9 @@ public:
 
     void set_mesh(const std::shared_ptr<Mesh>& mesh) {
         mesh_ = mesh;
+        point_cloud_.reset();
+        instance_group_ = 0;
+        markOwnerDirty();
     }
 
     std::shared_ptr<Material> material() {
@@ -75,6 +81,8 @@ public:
 
     void set_material(const std::shared_ptr<Material>& material) {
         material_ = material;
+        instance_group_ = 0;
+        markOwnerDirty();
     }
 
     int render_mask() const {
@@ -83,6 +91,8 @@ public:
 
     void set_render_mask(int render_mask) {
         render_mask_ = render_mask;
+        instance_group_ = 0;
+        markOwnerDirty();
     }
 
     int rendering_order() const {
@@ -91,6 +101,8 @@ public:
 
     void set_rendering_order(int rendering_order) {
         rendering_order_ = rendering_order;
+        instance_group_ = 0;
+        markOwnerDirty();
     }
 
     bool cull_test() const {
@@ -99,6 +111,8 @@ public:
 
     void set_cull_test(bool cull_test) {
         cull_test_ = cull_test;
+        instance_group_ = 0;
+        markOwnerDirty();
     }
 
     bool offset() const {
@@ -107,6 +121,8 @@ public:
 
     void set_offset(bool offset) {
         offset_ = offset;
+        instance_group_ = 0;
+        markOwnerDirty();
     }
 
     float offset_factor() const {
@@ -115,6 +131,8 @@ public:
 
     void set_offset_factor(float offset_factor) {
         offset_factor_ = offset_factor;
+        instance_group_ = 0;
+        markOwnerDirty();
     }
 
     float offset_units() const {
@@ -123,6 +141,8 @@ public:
 
     void set_offset_units(float offset_units) {
         offset_units_ = offset_units;
+        instance_group_ = 0;
+        markOwnerDirty();
     }
 
     bool depth_test() const {
@@ -131,6 +151,8 @@ public:
 
     void set_depth_test(bool depth_test) {
         depth_test_ = depth_test;
+        instance_group_ = 0;
+        markOwnerDirty();
     }
 
     bool alpha_blend() const {
@@ -139,8 +161,68 @@ public:
 
     void set_alpha_blend(bool alpha_blend) {
         alpha_blend_ = alpha_blend;
+        instance_group_ = 0;
+        markOwnerDirty();
     }
 
+    // for meshes of lines, passed to glLineWidth()
+    float line_width() const {
+        return line_width_;
+    }
+
+    void set_line_width(float line_width) {
+        line_width_ = line_width;
+        instance_group_ = 0;
+        markOwnerDirty();
+    }
+
+    // for meshes of points, passed to the u_point_size uniform of custom
+    // shaders, which set gl_PointSize from it
+    float point_size() const {
+        return point_size_;
+    }
+
+    void set_point_size(float point_size) {
+        point_size_ = point_size;
+        instance_group_ = 0;
+        markOwnerDirty();
+    }
+
+    // whether the renderer skips the mesh when its bounds are out of view;
+    // turn it off for shaders that move vertices or ignore u_mvp
+    bool frustum_culling() const {
+        return frustum_culling_;
+    }
+
+    void set_frustum_culling(bool frustum_culling) {
+        frustum_culling_ = frustum_culling;
+        instance_group_ = 0;
+        markOwnerDirty();
+    }
+
+    const std::shared_ptr<PointCloud>& point_cloud() const {
+        return point_cloud_;
+    }
+
+    // draws the mesh of point_cloud, which is updated once per frame;
+    // setting another mesh drops the point cloud, and copyFrom() clones it
+    void set_point_cloud(const std::shared_ptr<PointCloud>& point_cloud);
+
+    /*
+     * Render data in the same non-zero instance group share their mesh,
+     * material and render state, so they can be batched or instanced.
+     * Clones join the group of their source; any setter leaves the group.
+     */
+    int instance_group() const {
+        return instance_group_;
+    }
+
+    int joinInstanceGroup();
+
+    // copies everything but the owner, and joins the instance group of
+    // render_data
+    void copyFrom(RenderData& render_data);
+
 private:
     RenderData(const RenderData& render_data);
     RenderData(RenderData&& render_data);
@@ -160,6 +242,13 @@ private:
     float offset_units_;
     bool depth_test_;
     bool alpha_blend_;
+    float line_width_;
+    float point_size_;
+    bool frustum_culling_;
+    std::shared_ptr<PointCloud> point_cloud_;
+    int instance_group_;
+
+    static int next_instance_group_;
 };
 
 inline bool compareRenderData(std::shared_ptr<RenderData> i,
@@ -24,6 +24,7 @@
 
 #include "objects/mesh.h"
 #include "objects/material.h"
+#include "objects/point_cloud.h"
 
 namespace gvr {
 
@@ -101,6 +102,33 @@ Java_org_gearvrf_NativeRenderData_getAlphaBlend(JNIEnv * env,
 JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeRenderData_setAlphaBlend(JNIEnv * env,
         jobject obj, jlong jrender_data, jboolean alpha_blend);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeRenderData_getInstanceGroup(JNIEnv * env,
+        jobject obj, jlong jrender_data);
+JNIEXPORT jfloat JNICALL
+Java_org_gearvrf_NativeRenderData_getLineWidth(JNIEnv * env,
+        jobject obj, jlong jrender_data);
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_setLineWidth(JNIEnv * env,
+        jobject obj, jlong jrender_data, jfloat line_width);
+JNIEXPORT jfloat JNICALL
+Java_org_gearvrf_NativeRenderData_getPointSize(JNIEnv * env,
+        jobject obj, jlong jrender_data);
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_setPointSize(JNIEnv * env,
+        jobject obj, jlong jrender_data, jfloat point_size);
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeRenderData_getFrustumCulling(JNIEnv * env,
+        jobject obj, jlong jrender_data);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_setFrustumCulling(JNIEnv * env,
+        jobject obj, jlong jrender_data, jboolean frustum_culling);
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_setPointCloud(JNIEnv * env,
+        jobject obj, jlong jrender_data, jlong jpoint_cloud);
 }
 ;
 
@@ -278,4 +306,71 @@ Java_org_gearvrf_NativeRenderData_setAlphaBlend(JNIEnv * env,
             RenderData>*>(jrender_data);
     render_data->set_alpha_blend(static_cast<bool>(alpha_blend));
 }
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeRenderData_getInstanceGroup(JNIEnv * env,
+        jobject obj, jlong jrender_data) {
+    std::shared_ptr<RenderData> render_data = *reinterpret_cast<std::shared_ptr<
+            RenderData>*>(jrender_data);
+    return render_data->instance_group();
+}
+
+JNIEXPORT jfloat JNICALL
+Java_org_gearvrf_NativeRenderData_getLineWidth(JNIEnv * env,
+        jobject obj, jlong jrender_data) {
+    std::shared_ptr<RenderData> render_data = *reinterpret_cast<std::shared_ptr<
+            RenderData>*>(jrender_data);
+    return render_data->line_width();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_setLineWidth(JNIEnv * env,
+        jobject obj, jlong jrender_data, jfloat line_width) {
+    std::shared_ptr<RenderData> render_data = *reinterpret_cast<std::shared_ptr<
+            RenderData>*>(jrender_data);
+    render_data->set_line_width(line_width);
+}
+
+JNIEXPORT jfloat JNICALL
+Java_org_gearvrf_NativeRenderData_getPointSize(JNIEnv * env,
+        jobject obj, jlong jrender_data) {
+    std::shared_ptr<RenderData> render_data = *reinterpret_cast<std::shared_ptr<
+            RenderData>*>(jrender_data);
+    return render_data->point_size();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_setPointSize(JNIEnv * env,
+        jobject obj, jlong jrender_data, jfloat point_size) {
+    std::shared_ptr<RenderData> render_data = *reinterpret_cast<std::shared_ptr<
+            RenderData>*>(jrender_data);
+    render_data->set_point_size(point_size);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeRenderData_getFrustumCulling(JNIEnv * env,
+        jobject obj, jlong jrender_data) {
+    std::shared_ptr<RenderData> render_data = *reinterpret_cast<std::shared_ptr<
+            RenderData>*>(jrender_data);
+    return static_cast<jboolean>(render_data->frustum_culling());
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_setFrustumCulling(JNIEnv * env,
+        jobject obj, jlong jrender_data, jboolean frustum_culling) {
+    std::shared_ptr<RenderData> render_data = *reinterpret_cast<std::shared_ptr<
+            RenderData>*>(jrender_data);
+    render_data->set_frustum_culling(static_cast<bool>(frustum_culling));
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeRenderData_setPointCloud(JNIEnv * env,
+        jobject obj, jlong jrender_data, jlong jpoint_cloud) {
+    std::shared_ptr<RenderData> render_data = *reinterpret_cast<std::shared_ptr<
+            RenderData>*>(jrender_data);
+    std::shared_ptr<PointCloud> point_cloud = *reinterpret_cast<std::shared_ptr<
+            PointCloud>*>(jpoint_cloud);
+    render_data->set_point_cloud(point_cloud);
+}
+
 }
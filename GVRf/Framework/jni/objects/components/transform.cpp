@@ -29,19 +29,21 @@ Transform::Transform() :
         Component(), position_(glm::vec3(0.0f, 0.0f, 0.0f)), rotation_(
                 glm::quat(1.0f, 0.0f, 0.0f, 0.0f)), scale_(
                 glm::vec3(1.0f, 1.0f, 1.0f)), model_matrix_(
-                Lazy<glm::mat4>(glm::mat4())) {
+                Lazy<glm::mat4>(glm::mat4())), model_matrix_version_(0) {
 }
 
 Transform::~Transform() {
 }
 
 void Transform::invalidate() {
+    // an invalid matrix has not been read since the version last changed
     if (model_matrix_.isValid()) {
         model_matrix_.invalidate();
-        std::vector < std::shared_ptr
-                < SceneObject >> children(owner_object()->children());
-        for (auto it = children.begin(); it != children.end(); ++it) {
-            (*it)->transform()->invalidate();
+        ++model_matrix_version_;
+        markOwnerDirty();
+        for (SceneObject* child = owner_object()->first_child().get();
+                child != 0; child = child->next_sibling().get()) {
+            child->transform()->invalidate();
         }
     }
 }
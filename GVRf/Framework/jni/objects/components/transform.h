@@ -169,6 +169,12 @@ public:
 
     void invalidate();
     glm::mat4 getModelMatrix();
+
+    // changes whenever the model matrix does, including through a parent
+    unsigned int model_matrix_version() const {
+        return model_matrix_version_;
+    }
+
     void translate(float x, float y, float z);
     void setRotationByAxis(float angle, float x, float y, float z);
     void rotate(float w, float x, float y, float z);
@@ -191,6 +197,7 @@ private:
     glm::vec3 scale_;
 
     Lazy<glm::mat4> model_matrix_;
+    unsigned int model_matrix_version_;
 };
 
 }
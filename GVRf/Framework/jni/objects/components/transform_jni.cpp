@@ -107,6 +107,9 @@ Java_org_gearvrf_NativeTransform_setScaleZ(JNIEnv * env,
 JNIEXPORT jfloatArray JNICALL
 Java_org_gearvrf_NativeTransform_getModelMatrix(JNIEnv * env,
         jobject obj, jlong jtransform);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTransform_fillModelMatrix(JNIEnv * env,
+        jobject obj, jlong jtransform, jfloatArray jmatrix);
 
 JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeTransform_setModelMatrix(JNIEnv * env,
@@ -337,6 +340,15 @@ Java_org_gearvrf_NativeTransform_getModelMatrix(JNIEnv * env,
     return jmatrix;
 }
 
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTransform_fillModelMatrix(JNIEnv * env,
+        jobject obj, jlong jtransform, jfloatArray jmatrix) {
+    std::shared_ptr<Transform> transform = *reinterpret_cast<std::shared_ptr<
+            Transform>*>(jtransform);
+    glm::mat4 matrix = transform->getModelMatrix();
+    env->SetFloatArrayRegion(jmatrix, 0, 16, glm::value_ptr(matrix));
+}
+
 JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeTransform_setModelMatrix(JNIEnv * env,
 		jobject obj, jlong jtransform, jfloatArray mat){
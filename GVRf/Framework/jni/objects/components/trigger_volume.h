@@ -0,0 +1,92 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * A sphere or box that reports when it starts and stops overlapping others.
+ ***************************************************************************/
+
+#ifndef TRIGGER_VOLUME_H_
+#define TRIGGER_VOLUME_H_
+
+#include "glm/glm.hpp"
+
+#include "objects/components/component.h"
+
+namespace gvr {
+
+/*
+ * The volume is given in the space of its owner and follows the owner's
+ * transform; scale is taken into account, shear is not.
+ */
+class TriggerVolume: public Component {
+public:
+    enum Shape {
+        SPHERE = 0, BOX = 1
+    };
+
+    TriggerVolume() :
+            Component(), shape_(SPHERE), center_(), radius_(0.5f), half_extents_(
+                    0.5f) {
+    }
+
+    ~TriggerVolume() {
+    }
+
+    Shape shape() const {
+        return shape_;
+    }
+
+    const glm::vec3& center() const {
+        return center_;
+    }
+
+    void set_center(const glm::vec3& center) {
+        center_ = center;
+    }
+
+    float radius() const {
+        return radius_;
+    }
+
+    const glm::vec3& half_extents() const {
+        return half_extents_;
+    }
+
+    void setSphere(float radius) {
+        shape_ = SPHERE;
+        radius_ = radius;
+    }
+
+    void setBox(const glm::vec3& half_extents) {
+        shape_ = BOX;
+        half_extents_ = half_extents;
+    }
+
+private:
+    TriggerVolume(const TriggerVolume& trigger_volume);
+    TriggerVolume(TriggerVolume&& trigger_volume);
+    TriggerVolume& operator=(const TriggerVolume& trigger_volume);
+    TriggerVolume& operator=(TriggerVolume&& trigger_volume);
+
+private:
+    Shape shape_;
+    glm::vec3 center_;
+    float radius_;
+    glm::vec3 half_extents_;
+};
+
+}
+#endif
@@ -0,0 +1,84 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "trigger_volume.h"
+
+#include "util/gvr_jni.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeTriggerVolume_ctor(JNIEnv * env,
+        jobject obj);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeTriggerVolume_getShape(JNIEnv * env,
+        jobject obj, jlong jtrigger_volume);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTriggerVolume_setSphere(JNIEnv * env,
+        jobject obj, jlong jtrigger_volume, jfloat radius);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTriggerVolume_setBox(JNIEnv * env,
+        jobject obj, jlong jtrigger_volume, jfloat x, jfloat y, jfloat z);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTriggerVolume_setCenter(JNIEnv * env,
+        jobject obj, jlong jtrigger_volume, jfloat x, jfloat y, jfloat z);
+}
+;
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeTriggerVolume_ctor(JNIEnv * env,
+        jobject obj) {
+    return reinterpret_cast<jlong>(new std::shared_ptr<TriggerVolume>(
+            new TriggerVolume()));
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeTriggerVolume_getShape(JNIEnv * env,
+        jobject obj, jlong jtrigger_volume) {
+    std::shared_ptr<TriggerVolume> trigger_volume =
+            *reinterpret_cast<std::shared_ptr<TriggerVolume>*>(jtrigger_volume);
+    return trigger_volume->shape();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTriggerVolume_setSphere(JNIEnv * env,
+        jobject obj, jlong jtrigger_volume, jfloat radius) {
+    std::shared_ptr<TriggerVolume> trigger_volume =
+            *reinterpret_cast<std::shared_ptr<TriggerVolume>*>(jtrigger_volume);
+    trigger_volume->setSphere(radius);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTriggerVolume_setBox(JNIEnv * env,
+        jobject obj, jlong jtrigger_volume, jfloat x, jfloat y, jfloat z) {
+    std::shared_ptr<TriggerVolume> trigger_volume =
+            *reinterpret_cast<std::shared_ptr<TriggerVolume>*>(jtrigger_volume);
+    trigger_volume->setBox(glm::vec3(x, y, z));
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTriggerVolume_setCenter(JNIEnv * env,
+        jobject obj, jlong jtrigger_volume, jfloat x, jfloat y, jfloat z) {
+    std::shared_ptr<TriggerVolume> trigger_volume =
+            *reinterpret_cast<std::shared_ptr<TriggerVolume>*>(jtrigger_volume);
+    trigger_volume->set_center(glm::vec3(x, y, z));
+}
+
+}
@@ -149,6 +149,30 @@ public:
         mat4s_[key] = matrix;
     }
 
+    const std::map<std::string, std::shared_ptr<Texture>>& textures() const {
+        return textures_;
+    }
+
+    const std::map<std::string, float>& floats() const {
+        return floats_;
+    }
+
+    const std::map<std::string, glm::vec2>& vec2s() const {
+        return vec2s_;
+    }
+
+    const std::map<std::string, glm::vec3>& vec3s() const {
+        return vec3s_;
+    }
+
+    const std::map<std::string, glm::vec4>& vec4s() const {
+        return vec4s_;
+    }
+
+    const std::map<std::string, glm::mat4>& mat4s() const {
+        return mat4s_;
+    }
+
 private:
     Material(const Material& material);
     Material(Material&& material);
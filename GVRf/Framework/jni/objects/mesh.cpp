@@ -20,46 +20,258 @@
 
 #include "mesh.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
 #include <limits>
+#include <thread>
+#include <unordered_set>
+
+#if defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
 
 #include "assimp/Importer.hpp"
 #include "assimp/mesh.h"
 #include "assimp/postprocess.h"
 #include "assimp/scene.h"
+#include "engine/optimizer/mesh_optimizer.h"
+#include "engine/optimizer/mesh_simplifier.h"
+#include "gl/gl_stream_buffer.h"
 #include "util/gvr_log.h"
 #include "util/gvr_gl.h"
 
 namespace gvr {
-std::shared_ptr<Mesh> Mesh::getBoundingBox() const {
+static const unsigned long long FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const unsigned long long FNV_PRIME = 1099511628211ULL;
+// how much level of detail simplification avoids creases and texture
+// stretches, next to the geometric error
+static const float LOD_ATTRIBUTE_WEIGHT = 1.0f;
+// generateLods shares the cores with the render and GL threads
+static const int MAX_LOD_WORKERS = 4;
+
+static unsigned long long hashBytes(unsigned long long hash, const void* data,
+        size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+template<class T>
+static unsigned long long hashVector(unsigned long long hash,
+        const std::vector<T>& vector) {
+    unsigned int size = vector.size();
+    hash = hashBytes(hash, &size, sizeof(size));
+    if (size > 0) {
+        hash = hashBytes(hash, vector.data(), size * sizeof(T));
+    }
+    return hash;
+}
+
+unsigned long long Mesh::getContentHash() const {
+    unsigned long long hash = FNV_OFFSET_BASIS;
+    hash = hashVector(hash, vertices_);
+    hash = hashVector(hash, normals_);
+    hash = hashVector(hash, tex_coords_);
+    if (getIndexType() == GL_UNSIGNED_INT) {
+        hash = hashVector(hash, triangles_);
+    } else {
+        // as the hash was before 32-bit indices, so saved hashes still match
+        std::vector<unsigned short> triangles(triangles_.begin(),
+                triangles_.end());
+        hash = hashVector(hash, triangles);
+    }
+    return hash;
+}
+
+template<class T>
+static unsigned long long hashVectors(unsigned long long hash,
+        const std::map<std::string, std::vector<T>>& vectors) {
+    for (auto it = vectors.begin(); it != vectors.end(); ++it) {
+        hash = hashBytes(hash, it->first.c_str(), it->first.size() + 1);
+        hash = hashVector(hash, it->second);
+    }
+    return hash;
+}
+
+unsigned long long Mesh::getCheckHash() const {
+    static const char SEED[] = "Mesh::getCheckHash";
+    unsigned long long hash = hashBytes(FNV_OFFSET_BASIS, SEED, sizeof(SEED));
+    hash = hashBytes(hash, &primitive_type_, sizeof(primitive_type_));
+    hash = hashVector(hash, vertices_);
+    hash = hashVector(hash, normals_);
+    hash = hashVector(hash, tex_coords_);
+    hash = hashVector(hash, triangles_);
+    hash = hashVectors(hash, float_vectors_);
+    hash = hashVectors(hash, vec2_vectors_);
+    hash = hashVectors(hash, vec3_vectors_);
+    hash = hashVectors(hash, vec4_vectors_);
+    return hash;
+}
+
+bool Mesh::hasSameContent(const Mesh& mesh) const {
+    return vertices_ == mesh.vertices_ && normals_ == mesh.normals_
+            && tex_coords_ == mesh.tex_coords_
+            && triangles_ == mesh.triangles_
+            && float_vectors_ == mesh.float_vectors_
+            && vec2_vectors_ == mesh.vec2_vectors_
+            && vec3_vectors_ == mesh.vec3_vectors_
+            && vec4_vectors_ == mesh.vec4_vectors_
+            && primitive_type_ == mesh.primitive_type_;
+}
+
+template<class T>
+static long long vectorsSize(
+        const std::map<std::string, std::vector<T>>& vectors) {
+    long long size = 0;
+    for (auto it = vectors.begin(); it != vectors.end(); ++it) {
+        size += it->second.size() * sizeof(T);
+    }
+    return size;
+}
+
+long long Mesh::getDataSize() const {
+    GLenum index_type = getIndexType();
+    int index_size = index_type == GL_UNSIGNED_BYTE ? 1 :
+            index_type == GL_UNSIGNED_SHORT ? 2 : 4;
+    return vertices_.size() * sizeof(glm::vec3)
+            + normals_.size() * sizeof(glm::vec3)
+            + tex_coords_.size() * sizeof(glm::vec2)
+            + vectorsSize(float_vectors_) + vectorsSize(vec2_vectors_)
+            + vectorsSize(vec3_vectors_) + vectorsSize(vec4_vectors_)
+            + static_cast<long long>(triangles_.size()) * index_size;
+}
+
+GLenum Mesh::getIndexType() const {
+    unsigned int vertex_count = vertices_.size();
+    for (auto it = triangles_.begin(); it != triangles_.end(); ++it) {
+        vertex_count = std::max(vertex_count, *it + 1);
+    }
+    if (vertex_count <= 256) {
+        return GL_UNSIGNED_BYTE;
+    } else if (vertex_count <= 65536) {
+        return GL_UNSIGNED_SHORT;
+    } else {
+        return GL_UNSIGNED_INT;
+    }
+}
+
+template<class T>
+static std::vector<T> gatherVertices(const std::vector<T>& source,
+        const std::vector<unsigned int>& indices) {
+    std::vector<T> vector;
+    if (source.empty()) {
+        return vector;
+    }
+    vector.reserve(indices.size());
+    for (auto it = indices.begin(); it != indices.end(); ++it) {
+        vector.push_back(*it < source.size() ? source[*it] : T());
+    }
+    return vector;
+}
+
+template<class T>
+static void gatherVectors(std::map<std::string, std::vector<T>>& part,
+        const std::map<std::string, std::vector<T>>& source,
+        const std::vector<unsigned int>& indices) {
+    for (auto it = source.begin(); it != source.end(); ++it) {
+        part[it->first] = gatherVertices(it->second, indices);
+    }
+}
+
+// takes the triangles, already indexing into part_vertices
+std::shared_ptr<Mesh> Mesh::createPart(
+        const std::vector<unsigned int>& part_vertices,
+        std::vector<unsigned int>& part_triangles) const {
     Mesh* mesh = new Mesh();
-    float min_x = std::numeric_limits<float>::infinity();
-    float max_x = -std::numeric_limits<float>::infinity();
-    float min_y = std::numeric_limits<float>::infinity();
-    float max_y = -std::numeric_limits<float>::infinity();
-    float min_z = std::numeric_limits<float>::infinity();
-    float max_z = -std::numeric_limits<float>::infinity();
+    mesh->vertices_ = gatherVertices(vertices_, part_vertices);
+    mesh->normals_ = gatherVertices(normals_, part_vertices);
+    mesh->tex_coords_ = gatherVertices(tex_coords_, part_vertices);
+    gatherVectors(mesh->float_vectors_, float_vectors_, part_vertices);
+    gatherVectors(mesh->vec2_vectors_, vec2_vectors_, part_vertices);
+    gatherVectors(mesh->vec3_vectors_, vec3_vectors_, part_vertices);
+    gatherVectors(mesh->vec4_vectors_, vec4_vectors_, part_vertices);
+    mesh->triangles_.swap(part_triangles);
+    part_triangles.clear();
+    mesh->primitive_type_ = primitive_type_;
+    mesh->texture_repeat_ = texture_repeat_;
+    mesh->quantized_ = quantized_;
+    return std::shared_ptr<Mesh>(mesh);
+}
 
-    for (auto it = vertices_.begin(); it != vertices_.end(); ++it) {
-        if (it->x < min_x) {
-            min_x = it->x;
-        }
-        if (it->x > max_x) {
-            max_x = it->x;
-        }
-        if (it->y < min_y) {
-            min_y = it->y;
+std::vector<std::shared_ptr<Mesh>> Mesh::split(int max_vertices) const {
+    std::vector<std::shared_ptr<Mesh>> meshes;
+    if (primitive_type_ == LINE_STRIP) {
+        std::string error = "Mesh::split() : line strips cannot be split";
+        throw error;
+    }
+    int size = primitive_type_ == TRIANGLES ? 3 :
+            primitive_type_ == LINES ? 2 : 1;
+    if (max_vertices < size) {
+        std::string error = "Mesh::split() : max_vertices too small for a primitive";
+        throw error;
+    }
+
+    // greedily fills each part with primitives in order, so the parts keep
+    // the locality of the source index order
+    std::vector<int> remap(vertices_.size(), -1);
+    std::vector<unsigned int> part_vertices;
+    std::vector<unsigned int> part_triangles;
+    for (int i = 0; i + size - 1 < triangles_.size(); i += size) {
+        const unsigned int* triangle = &triangles_[i];
+        if (*std::max_element(triangle, triangle + size) >= remap.size()) {
+            continue;
         }
-        if (it->y > max_y) {
-            max_y = it->y;
+        int new_vertices = 0;
+        for (int j = 0; j < size; ++j) {
+            if (remap[triangle[j]] == -1
+                    && (j == 0 || triangle[j] != triangle[0])
+                    && (j < 2 || triangle[j] != triangle[1])) {
+                ++new_vertices;
+            }
         }
-        if (it->z < min_z) {
-            min_z = it->z;
+        if (part_vertices.size() + new_vertices > max_vertices) {
+            meshes.push_back(createPart(part_vertices, part_triangles));
+
+            for (auto it = part_vertices.begin(); it != part_vertices.end();
+                    ++it) {
+                remap[*it] = -1;
+            }
+            part_vertices.clear();
         }
-        if (it->z > max_z) {
-            max_z = it->z;
+        for (int j = 0; j < size; ++j) {
+            if (remap[triangle[j]] == -1) {
+                remap[triangle[j]] = part_vertices.size();
+                part_vertices.push_back(triangle[j]);
+            }
+            part_triangles.push_back(remap[triangle[j]]);
         }
     }
 
+    if (!part_triangles.empty()) {
+        meshes.push_back(createPart(part_vertices, part_triangles));
+    }
+    return meshes;
+}
+
+std::shared_ptr<Mesh> Mesh::getBoundingBox() const {
+    updateBounds();
+    if (bounding_box_) {
+        return bounding_box_;
+    }
+
+    Mesh* mesh = new Mesh();
+    float min_x = bounds_min_.x;
+    float max_x = bounds_max_.x;
+    float min_y = bounds_min_.y;
+    float max_y = bounds_max_.y;
+    float min_z = bounds_min_.z;
+    float max_z = bounds_max_.z;
+
     mesh->vertices_.push_back(glm::vec3(min_x, min_y, min_z));
     mesh->vertices_.push_back(glm::vec3(max_x, min_y, min_z));
     mesh->vertices_.push_back(glm::vec3(min_x, max_y, min_z));
@@ -111,114 +323,557 @@ std::shared_ptr<Mesh> Mesh::getBoundingBox() const {
     mesh->triangles_.push_back(6);
     mesh->triangles_.push_back(7);
 
-    return std::shared_ptr < Mesh > (mesh);
+    bounding_box_.reset(mesh);
+    return bounding_box_;
 }
 
-// generate vertex array object
-void Mesh::generateVAO() {
-#if _GVRF_USE_GLES3_
-    GLuint tmpID;
+#if defined(__ARM_NEON__)
+static inline float horizontalMin(float32x4_t v) {
+    float32x2_t pair = vpmin_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpmin_f32(pair, pair), 0);
+}
 
-    if (vaoID_)
-    {
-        // already initialized
+static inline float horizontalMax(float32x4_t v) {
+    float32x2_t pair = vpmax_f32(vget_low_f32(v), vget_high_f32(v));
+    return vget_lane_f32(vpmax_f32(pair, pair), 0);
+}
+#endif
+
+// the sphere is centered on the box; not minimal, but one more pass
+void Mesh::computeBounds() const {
+    bounds_dirty_ = false;
+    bounding_box_.reset();
+    if (vertices_.empty()) {
+        bounds_min_ = bounds_max_ = glm::vec3();
+        bounding_sphere_ = glm::vec4();
         return;
     }
 
-    if (vertices_.size() == 0 && normals_.size() == 0 && tex_coords_.size()==0)
-    {
-        std::string error = "no vertex data yet, shouldn't call here. ";
+    int count = vertices_.size();
+    int i = 0;
+    glm::vec3 min(std::numeric_limits<float>::infinity());
+    glm::vec3 max(-std::numeric_limits<float>::infinity());
+#if defined(__ARM_NEON__)
+    // four vertices at a time, split into x, y and z lanes by the load
+    if (count >= 4) {
+        const float* data = reinterpret_cast<const float*>(vertices_.data());
+        float32x4x3_t first = vld3q_f32(data);
+        float32x4_t min_x = first.val[0], max_x = first.val[0];
+        float32x4_t min_y = first.val[1], max_y = first.val[1];
+        float32x4_t min_z = first.val[2], max_z = first.val[2];
+        for (i = 4; i + 4 <= count; i += 4) {
+            float32x4x3_t v = vld3q_f32(data + i * 3);
+            min_x = vminq_f32(min_x, v.val[0]);
+            max_x = vmaxq_f32(max_x, v.val[0]);
+            min_y = vminq_f32(min_y, v.val[1]);
+            max_y = vmaxq_f32(max_y, v.val[1]);
+            min_z = vminq_f32(min_z, v.val[2]);
+            max_z = vmaxq_f32(max_z, v.val[2]);
+        }
+        min = glm::vec3(horizontalMin(min_x), horizontalMin(min_y),
+                horizontalMin(min_z));
+        max = glm::vec3(horizontalMax(max_x), horizontalMax(max_y),
+                horizontalMax(max_z));
+    }
+#endif
+    for (; i < count; ++i) {
+        min = glm::min(min, vertices_[i]);
+        max = glm::max(max, vertices_[i]);
+    }
+    bounds_min_ = min;
+    bounds_max_ = max;
+
+    glm::vec3 center = (min + max) * 0.5f;
+    float radius_squared = 0.0f;
+    i = 0;
+#if defined(__ARM_NEON__)
+    if (count >= 4) {
+        float32x4_t center_x = vdupq_n_f32(center.x);
+        float32x4_t center_y = vdupq_n_f32(center.y);
+        float32x4_t center_z = vdupq_n_f32(center.z);
+        float32x4_t max_squared = vdupq_n_f32(0.0f);
+        for (; i + 4 <= count; i += 4) {
+            float32x4x3_t v = vld3q_f32(data + i * 3);
+            float32x4_t x = vsubq_f32(v.val[0], center_x);
+            float32x4_t y = vsubq_f32(v.val[1], center_y);
+            float32x4_t z = vsubq_f32(v.val[2], center_z);
+            float32x4_t squared = vmulq_f32(x, x);
+            squared = vmlaq_f32(squared, y, y);
+            squared = vmlaq_f32(squared, z, z);
+            max_squared = vmaxq_f32(max_squared, squared);
+        }
+        radius_squared = horizontalMax(max_squared);
+    }
+#endif
+    for (; i < count; ++i) {
+        glm::vec3 offset = vertices_[i] - center;
+        radius_squared = std::max(radius_squared, glm::dot(offset, offset));
+    }
+    bounding_sphere_ = glm::vec4(center, std::sqrt(radius_squared));
+}
+
+// how a source array is written to the vertex buffers
+enum AttributeEncoding {
+    FLOAT_ENCODING, POSITION_ENCODING, NORMAL_ENCODING, TEX_COORD_ENCODING
+};
+
+// a source array of an attribute of the layout, and its vertex count
+struct Mesh::AttributeSource {
+    const float* data;
+    int count;
+    int size;
+    AttributeEncoding encoding;
+
+    static void add(VertexLayout& layout,
+            std::vector<AttributeSource>& sources,
+            std::vector<VertexBindings::Source>& attributes,
+            VertexBindings::SourceType type, const std::string& key,
+            GLint size, const float* data, int count,
+            AttributeEncoding encoding, const VertexQuantization& quantization);
+    void encode(int vertex, const VertexQuantization& quantization,
+            unsigned char* destination) const;
+};
+
+void Mesh::AttributeSource::add(VertexLayout& layout,
+        std::vector<AttributeSource>& sources,
+        std::vector<VertexBindings::Source>& attributes,
+        VertexBindings::SourceType type, const std::string& key, GLint size,
+        const float* data, int count, AttributeEncoding encoding,
+        const VertexQuantization& quantization) {
+    if (count == 0) {
+        return;
+    }
+    switch (encoding) {
+    case POSITION_ENCODING:
+        layout.add(4, GL_SHORT, GL_TRUE);
+        break;
+    case NORMAL_ENCODING:
+        layout.add(4, GL_INT_2_10_10_10_REV, GL_TRUE);
+        break;
+    case TEX_COORD_ENCODING:
+        layout.add(2, quantization.tex_coord_type(),
+                quantization.tex_coord_type() == GL_UNSIGNED_SHORT);
+        break;
+    default:
+        layout.add(size);
+        break;
+    }
+    AttributeSource source = { data, count, size, encoding };
+    sources.push_back(source);
+    VertexBindings::Source attribute = { type, key };
+    attributes.push_back(attribute);
+}
+
+void Mesh::AttributeSource::encode(int vertex,
+        const VertexQuantization& quantization,
+        unsigned char* destination) const {
+    const float* source = data + vertex * size;
+    switch (encoding) {
+    case POSITION_ENCODING: {
+        GLshort encoded[4];
+        quantization.encodePosition(
+                glm::vec3(source[0], source[1], source[2]), encoded);
+        memcpy(destination, encoded, sizeof(encoded));
+        break;
+    }
+    case NORMAL_ENCODING: {
+        GLuint encoded = VertexQuantization::encodeNormal(
+                glm::vec3(source[0], source[1], source[2]));
+        memcpy(destination, &encoded, sizeof(encoded));
+        break;
+    }
+    case TEX_COORD_ENCODING: {
+        GLushort encoded[2];
+        quantization.encodeTexCoord(glm::vec2(source[0], source[1]),
+                encoded);
+        memcpy(destination, encoded, sizeof(encoded));
+        break;
+    }
+    default:
+        memcpy(destination, source, sizeof(float) * size);
+        break;
+    }
+}
+
+void Mesh::optimize(float overdraw_threshold) {
+    int vertex_count = vertices_.size();
+    if (primitive_type_ == TRIANGLES) {
+        MeshOptimizer::optimizeVertexCache(triangles_, vertex_count);
+        MeshOptimizer::optimizeOverdraw(triangles_, vertices_,
+                overdraw_threshold);
+    }
+    std::vector<unsigned int> order = MeshOptimizer::optimizeVertexFetch(
+            triangles_, vertex_count);
+
+    vertices_ = gatherVertices(vertices_, order);
+    normals_ = gatherVertices(normals_, order);
+    tex_coords_ = gatherVertices(tex_coords_, order);
+    gatherVectors(float_vectors_, float_vectors_, order);
+    gatherVectors(vec2_vectors_, vec2_vectors_, order);
+    gatherVectors(vec3_vectors_, vec3_vectors_, order);
+    gatherVectors(vec4_vectors_, vec4_vectors_, order);
+    client_indices_dirty_ = true;
+    clusters_dirty_ = true;
+    ++version_;
+    deleteVAO();
+}
+
+std::shared_ptr<Mesh> Mesh::simplify(float ratio, float& error) const {
+    if (primitive_type_ != TRIANGLES) {
+        std::string error = "Mesh::simplify() : only triangles can be simplified";
+        throw error;
+    }
+    int vertex_count = vertices_.size();
+    std::vector<unsigned int> indices(triangles_);
+    int target_index_count = static_cast<int>(indices.size() / 3
+            * std::max(std::min(ratio, 1.0f), 0.0f)) * 3;
+    error = MeshSimplifier::simplify(indices, vertices_, normals_,
+            tex_coords_, target_index_count, LOD_ATTRIBUTE_WEIGHT);
+
+    // the vertices the simplified triangles no longer use go last, and are
+    // left out of the copy
+    MeshOptimizer::optimizeVertexCache(indices, vertex_count);
+    std::vector<unsigned int> order = MeshOptimizer::optimizeVertexFetch(
+            indices, vertex_count);
+    unsigned int used = 0;
+    for (auto it = indices.begin(); it != indices.end(); ++it) {
+        used = std::max(used, *it + 1);
+    }
+    order.resize(used);
+    return createPart(order, indices);
+}
+
+std::vector<std::shared_ptr<Mesh>> Mesh::generateLods(
+        const std::vector<float>& ratios, std::vector<float>& errors) const {
+    std::vector<std::shared_ptr<Mesh>> lods(ratios.size());
+    errors.assign(ratios.size(), 0.0f);
+    std::vector<std::string> failures(ratios.size());
+
+    // a few workers take the levels in turn, however many levels there are
+    int worker_count = std::min(static_cast<int>(ratios.size()),
+            std::max(std::min(static_cast<int>(
+                    std::thread::hardware_concurrency()), MAX_LOD_WORKERS), 1));
+    std::atomic<int> next_level(0);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < worker_count; ++i) {
+        workers.push_back(std::thread([this, &ratios, &lods, &errors,
+                &failures, &next_level]() {
+            for (int level = next_level++; level < ratios.size();
+                    level = next_level++) {
+                try {
+                    lods[level] = simplify(ratios[level], errors[level]);
+                } catch (const std::string& error) {
+                    failures[level] = error;
+                }
+            }
+        }));
+    }
+    for (auto it = workers.begin(); it != workers.end(); ++it) {
+        it->join();
+    }
+
+    for (auto it = failures.begin(); it != failures.end(); ++it) {
+        if (!it->empty()) {
+            throw *it;
+        }
+    }
+    return lods;
+}
+
+std::shared_ptr<Mesh> Mesh::getWireframe() const {
+    if (primitive_type_ != TRIANGLES) {
+        std::string error = "Mesh::getWireframe() : the mesh has no triangles";
         throw error;
+    }
+
+    // an edge shared by two triangles is drawn once
+    std::unordered_set<unsigned long long> edges;
+    std::vector<unsigned int> lines;
+    for (int i = 0; i + 2 < triangles_.size(); i += 3) {
+        for (int j = 0; j < 3; ++j) {
+            unsigned int a = triangles_[i + j];
+            unsigned int b = triangles_[i + (j + 1) % 3];
+            if (a == b) {
+                continue;
+            }
+            unsigned long long key =
+                    static_cast<unsigned long long>(std::min(a, b)) << 32
+                            | std::max(a, b);
+            if (edges.insert(key).second) {
+                lines.push_back(a);
+                lines.push_back(b);
+            }
+        }
+    }
+
+    std::vector<unsigned int> order(vertices_.size());
+    for (int i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::shared_ptr<Mesh> mesh = createPart(order, lines);
+    mesh->primitive_type_ = LINES;
+    return mesh;
+}
+
+template<class T>
+static void uploadIndexData(const std::vector<unsigned int>& triangles,
+        GLenum usage) {
+    std::vector<T> indices(triangles.begin(), triangles.end());
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(T) * indices.size(),
+            indices.data(), usage);
+}
+
+// generate vertex array object
+// the vertex buffer usage for each Usage
+static const GLenum PRIMITIVE_MODES[] = { GL_TRIANGLES, GL_LINES,
+        GL_LINE_STRIP, GL_POINTS };
+
+static const GLenum BUFFER_USAGES[] = { GL_STATIC_DRAW, GL_DYNAMIC_DRAW,
+        GL_STREAM_DRAW };
+
+// every attribute the mesh has, in the order of its vertex buffers
+int Mesh::addAttributes(VertexLayout& layout,
+        std::vector<AttributeSource>& sources,
+        std::vector<VertexBindings::Source>& attributes) const {
+    const VertexQuantization& quantization = getQuantization();
+    AttributeSource::add(layout, sources, attributes, VertexBindings::POSITION,
+            std::string(), 3, reinterpret_cast<const float*>(vertices_.data()),
+            vertices_.size(), quantized_ ? POSITION_ENCODING : FLOAT_ENCODING,
+            quantization);
+    AttributeSource::add(layout, sources, attributes, VertexBindings::NORMAL,
+            std::string(), 3, reinterpret_cast<const float*>(normals_.data()),
+            normals_.size(), quantized_ ? NORMAL_ENCODING : FLOAT_ENCODING,
+            quantization);
+    AttributeSource::add(layout, sources, attributes, VertexBindings::TEX_COORD,
+            std::string(), 2,
+            reinterpret_cast<const float*>(tex_coords_.data()),
+            tex_coords_.size(),
+            quantized_ ? TEX_COORD_ENCODING : FLOAT_ENCODING, quantization);
+    for (auto it = float_vectors_.begin(); it != float_vectors_.end(); ++it) {
+        AttributeSource::add(layout, sources, attributes,
+                VertexBindings::FLOAT_VECTOR, it->first, 1, it->second.data(),
+                it->second.size(), FLOAT_ENCODING, quantization);
+    }
+    for (auto it = vec2_vectors_.begin(); it != vec2_vectors_.end(); ++it) {
+        AttributeSource::add(layout, sources, attributes,
+                VertexBindings::VEC2_VECTOR, it->first, 2,
+                reinterpret_cast<const float*>(it->second.data()),
+                it->second.size(), FLOAT_ENCODING, quantization);
+    }
+    for (auto it = vec3_vectors_.begin(); it != vec3_vectors_.end(); ++it) {
+        AttributeSource::add(layout, sources, attributes,
+                VertexBindings::VEC3_VECTOR, it->first, 3,
+                reinterpret_cast<const float*>(it->second.data()),
+                it->second.size(), FLOAT_ENCODING, quantization);
+    }
+    for (auto it = vec4_vectors_.begin(); it != vec4_vectors_.end(); ++it) {
+        AttributeSource::add(layout, sources, attributes,
+                VertexBindings::VEC4_VECTOR, it->first, 4,
+                reinterpret_cast<const float*>(it->second.data()),
+                it->second.size(), FLOAT_ENCODING, quantization);
+    }
+
+    // attributes shorter than the longest one are padded with zeros
+    int vertex_count = 0;
+    for (auto it = sources.begin(); it != sources.end(); ++it) {
+        vertex_count = std::max(vertex_count, it->count);
+    }
+    return vertex_count;
+}
+
+// the bytes of vertices [first, last) of one vertex buffer: the interleaved
+// one, or the one of the given attribute
+void Mesh::encodeVertices(const VertexLayout& layout,
+        const std::vector<AttributeSource>& sources, int attribute, int first,
+        int last, std::vector<unsigned char>& data) const {
+    const VertexQuantization& quantization = getQuantization();
+    const std::vector<VertexLayout::Attribute>& attributes =
+            layout.attributes();
+    int begin = layout.interleaved() ? 0 : attribute;
+    int end = layout.interleaved() ? attributes.size() : attribute + 1;
+    int stride =
+            layout.interleaved() ?
+                    layout.stride() :
+                    VertexLayout::attributeSize(attributes[attribute].size,
+                            attributes[attribute].type);
+    data.assign((last - first) * stride, 0);
+    for (int i = begin; i < end; ++i) {
+        unsigned char* destination = data.data()
+                + (layout.interleaved() ? attributes[i].offset : 0);
+        for (int vertex = first; vertex < std::min(last, sources[i].count);
+                ++vertex) {
+            sources[i].encode(vertex, quantization, destination);
+            destination += stride;
+        }
+    }
+}
+
+void Mesh::uploadIndices() {
+    index_type_ = getIndexType();
+    index_count_ = triangles_.size();
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer_->id());
+    if (index_type_ == GL_UNSIGNED_BYTE) {
+        uploadIndexData<unsigned char>(triangles_, BUFFER_USAGES[usage_]);
+    } else if (index_type_ == GL_UNSIGNED_SHORT) {
+        uploadIndexData<unsigned short>(triangles_, BUFFER_USAGES[usage_]);
+    } else {
+        uploadIndexData<unsigned int>(triangles_, BUFFER_USAGES[usage_]);
+    }
+    indices_dirty_ = false;
+}
+
+// fills the vertex buffers with every attribute; buffers of the same
+// layout are filled again in place, so the vertex array objects stay valid
+void Mesh::uploadVertices() {
+    VertexLayout layout(interleaved_);
+    std::vector<AttributeSource> sources;
+    std::vector<VertexBindings::Source> attributes;
+    int vertex_count = addAttributes(layout, sources, attributes);
+    int buffer_count = layout.interleaved() ?
+            std::min<int>(layout.attributes().size(), 1) :
+            layout.attributes().size();
+    if (vertex_buffers_.size() != buffer_count || !(layout == vertex_layout_)
+            || attributes != buffer_attributes_) {
+        deleteVertexArrays();
+        vertex_buffers_.clear();
+        for (int i = 0; i < buffer_count; ++i) {
+            vertex_buffers_.push_back(
+                    std::unique_ptr<GLBuffer>(new GLBuffer()));
+        }
+        vertex_layout_ = layout;
+        buffer_attributes_.swap(attributes);
+    }
+    buffers_quantized_ = quantized_;
+    buffer_vertex_count_ = vertex_count;
+
+    for (int i = 0; i < buffer_count; ++i) {
+        encodeVertices(layout, sources, i, 0, vertex_count, upload_data_);
+        glBindBuffer(GL_ARRAY_BUFFER, vertex_buffers_[i]->id());
+        glBufferData(GL_ARRAY_BUFFER, upload_data_.size(), upload_data_.data(),
+                BUFFER_USAGES[usage_]);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    vertices_dirty_begin_ = std::numeric_limits<int>::max();
+    vertices_dirty_end_ = 0;
+}
+
+// uploads what changed since the buffers were filled, once for all the
+// vertex array objects
+void Mesh::updateVAO() {
+    if (indices_dirty_) {
+        glBindVertexArray(0);
+        uploadIndices();
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+
+    if (vertices_dirty_end_ <= vertices_dirty_begin_) {
+        return;
+    }
+    if (usage_ == STATIC) {
+        uploadVertices();
         return;
     }
+    VertexLayout layout(interleaved_);
+    std::vector<AttributeSource> sources;
+    std::vector<VertexBindings::Source> attributes;
+    int vertex_count = addAttributes(layout, sources, attributes);
+    if (vertex_count != buffer_vertex_count_ || !(layout == vertex_layout_)
+            || attributes != buffer_attributes_) {
+        uploadVertices();
+        return;
+    }
+
+    // quantized positions move with the bounds, so all of them change
+    int first = quantized_ ? 0 : std::max(vertices_dirty_begin_, 0);
+    int last = quantized_ ?
+            vertex_count : std::min(vertices_dirty_end_, vertex_count);
+    const std::vector<VertexLayout::Attribute>& layout_attributes =
+            layout.attributes();
+    for (int i = 0; i < vertex_buffers_.size() && first < last; ++i) {
+        encodeVertices(layout, sources, i, first, last, upload_data_);
+        int stride =
+                layout.interleaved() ?
+                        layout.stride() :
+                        VertexLayout::attributeSize(layout_attributes[i].size,
+                                layout_attributes[i].type);
+        GLStreamBuffer::current().upload(vertex_buffers_[i]->id(),
+                first * stride, upload_data_.data(), upload_data_.size());
+    }
+    vertices_dirty_begin_ = std::numeric_limits<int>::max();
+    vertices_dirty_end_ = 0;
+}
+
+// generate vertex array object
+void Mesh::generateVAO(const VertexBindings& bindings) {
+#if _GVRF_USE_GLES3_
+    // the data of a released mesh is gone; reload() it to edit it
+    if (!vertex_buffers_.empty() && !released_
+            && (vertices_dirty_end_ > vertices_dirty_begin_ || indices_dirty_)) {
+        updateVAO();
+    }
+    int bindings_id = bindings.id();
+    for (auto it = vertex_arrays_.begin(); it != vertex_arrays_.end(); ++it) {
+        if (it->bindings_id == bindings_id) {
+            // already initialized
+            vertex_array_ = it->id;
+            return;
+        }
+    }
+    vertex_array_ = 0;
+
+    if (vertex_buffers_.empty()) {
+        if (released_) {
+            LOGE("Mesh::generateVAO() : data released, reload() it first");
+            return;
+        }
+
+        if (vertices_.size() == 0 && normals_.size() == 0
+                && tex_coords_.size() == 0) {
+            std::string error = "no vertex data yet, shouldn't call here. ";
+            throw error;
+        }
+    }
 
-    if (vertexLoc_ == -1 && normalLoc_== -1 && texCoordLoc_== -1)
-    {
+    if (bindings.empty()) {
         std::string error = "no attrib loc setup yet, please compile shader and set attribLoc first. ";
         throw error;
-        return;
     }
 
-    glGenVertexArrays(1, &vaoID_);
-    glBindVertexArray(vaoID_);
-
-    glGenBuffers(1, &tmpID);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, tmpID);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(unsigned short)*triangles_.size(), &triangles_[0], GL_STATIC_DRAW);
-
-    if (vertices_.size())
-    {
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec3)*vertices_.size(), &vertices_[0], GL_STATIC_DRAW);
-        glEnableVertexAttribArray(getVertexLoc());
-        glVertexAttribPointer(getVertexLoc(), 3, GL_FLOAT, 0, 0, 0);
-    }
-
-    if (normals_.size())
-    {
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec3)*normals_.size(), &normals_[0], GL_STATIC_DRAW);
-        glEnableVertexAttribArray(getNormalLoc());
-        glVertexAttribPointer(getNormalLoc(), 3, GL_FLOAT, 0, 0, 0);
-    }
-
-    if (tex_coords_.size())
-    {
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*tex_coords_.size(), &tex_coords_[0], GL_STATIC_DRAW);
-        glEnableVertexAttribArray(getTexCoordLoc());
-        glVertexAttribPointer(getTexCoordLoc(), 2, GL_FLOAT, 0, 0, 0);
-    }
-
-    for(auto it = attribute_float_keys_.begin(); it != attribute_float_keys_.end(); ++it)
-    {
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ARRAY_BUFFER,
-                sizeof(GLfloat)*getFloatVector(it->second).size(),
-                getFloatVector(it->second).data(),
-                GL_STATIC_DRAW);
-        glEnableVertexAttribArray(it->first);
-        glVertexAttribPointer(it->first, 1, GL_FLOAT, 0, 0, 0);
-    }
-
-    for(auto it = attribute_vec2_keys_.begin(); it != attribute_vec2_keys_.end(); ++it)
-    {
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ARRAY_BUFFER,
-                sizeof(glm::vec2)*getVec2Vector(it->second).size(),
-                getVec2Vector(it->second).data(),
-                GL_STATIC_DRAW);
-        glEnableVertexAttribArray(it->first);
-        glVertexAttribPointer(it->first, 2, GL_FLOAT, 0, 0, 0);
-    }
-
-    for(auto it = attribute_vec3_keys_.begin(); it != attribute_vec3_keys_.end(); ++it)
-    {
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ARRAY_BUFFER,
-                sizeof(glm::vec3)*getVec3Vector(it->second).size(),
-                getVec3Vector(it->second).data(),
-                GL_STATIC_DRAW);
-        glEnableVertexAttribArray(it->first);
-        glVertexAttribPointer(it->first, 3, GL_FLOAT, 0, 0, 0);
-    }
-
-    for(auto it = attribute_vec4_keys_.begin(); it != attribute_vec4_keys_.end(); ++it)
-    {
-        glGenBuffers(1, &tmpID);
-        glBindBuffer(GL_ARRAY_BUFFER, tmpID);
-        glBufferData(GL_ARRAY_BUFFER,
-                sizeof(glm::vec4)*getVec4Vector(it->second).size(),
-                getVec4Vector(it->second).data(),
-                GL_STATIC_DRAW);
-        glEnableVertexAttribArray(it->first);
-        glVertexAttribPointer(it->first, 4, GL_FLOAT, 0, 0, 0);
+    if (vertex_buffers_.empty()) {
+        uploadVertices();
+    }
+    if (!index_buffer_) {
+        index_buffer_.reset(new GLBuffer());
+        glBindVertexArray(0);
+        uploadIndices();
+    }
+
+    VertexArray vertex_array = { bindings_id, 0 };
+    glGenVertexArrays(1, &vertex_array.id);
+    glBindVertexArray(vertex_array.id);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer_->id());
+
+    // a location the mesh has no attribute for reads the default value
+    const std::vector<VertexBindings::Binding>& bound = bindings.bindings();
+    for (auto it = bound.begin(); it != bound.end(); ++it) {
+        for (int i = 0; i < buffer_attributes_.size(); ++i) {
+            if (buffer_attributes_[i] == it->source) {
+                vertex_layout_.apply(i, it->location,
+                        vertex_buffers_[vertex_layout_.interleaved() ? 0 : i]->id());
+                break;
+            }
+        }
+    }
+    vertex_arrays_.push_back(vertex_array);
+    vertex_array_ = vertex_array.id;
+
+    // a static mesh does not keep its staging copy; no mesh keeps its
+    // data if asked not to
+    if (usage_ == STATIC) {
+        std::vector<unsigned char>().swap(upload_data_);
+    }
+    if (residency_ != KEEP && !released_) {
+        releaseData();
     }
 
     // done generation
@@ -228,4 +883,289 @@ void Mesh::generateVAO() {
 #endif
 }
 
+void Mesh::set_quantized(bool quantized) {
+    if (quantized == quantized_) {
+        return;
+    }
+    quantized_ = quantized;
+    if (released_) {
+        return;
+    }
+    deleteVAO();
+    if (quantized_) {
+        const VertexQuantization& quantization = getQuantization();
+        LOGD("Mesh::set_quantized() : position error %f, normal error %f degrees, tex coord error %f",
+                quantization.position_error(), quantization.normal_error(),
+                quantization.tex_coord_error());
+    }
+}
+
+const VertexQuantization& Mesh::getQuantization() const {
+    if (quantization_dirty_) {
+        quantization_dirty_ = false;
+        quantization_.analyze(vertices_, normals_, tex_coords_);
+    }
+    return quantization_;
+}
+
+const glm::mat4& Mesh::getDequantizationMatrix() const {
+    static const glm::mat4 identity;
+#if _GVRF_USE_GLES3_
+    // as the buffers are, which is as set unless the data was released
+    if (vertex_buffers_.empty() ? quantized_ : buffers_quantized_) {
+        return getQuantization().dequantization_matrix();
+    }
+#endif
+    return identity;
+}
+
+void Mesh::cullClusters(const glm::vec4* frustum,
+        const glm::vec3& camera_position, bool backface_culling) {
+    // the triangles of a released mesh are at most the picking proxy
+    if (primitive_type_ != TRIANGLES || (clusters_dirty_ && released_)) {
+        return;
+    }
+    if (clusters_dirty_) {
+        clusters_dirty_ = false;
+        clusters_ = MeshClusters::build(triangles_, vertices_);
+    }
+
+    draw_ranges_.clear();
+    for (auto it = clusters_.begin(); it != clusters_.end(); ++it) {
+        if (!MeshClusters::isVisible(*it, frustum, camera_position,
+                backface_culling)) {
+            continue;
+        }
+        if (!draw_ranges_.empty()
+                && draw_ranges_.back().first_index
+                        + draw_ranges_.back().index_count == it->first_index) {
+            DrawRange& range = draw_ranges_.back();
+            range.index_count += it->index_count;
+            range.min_vertex = std::min(range.min_vertex, it->min_vertex);
+            range.max_vertex = std::max(range.max_vertex, it->max_vertex);
+        } else {
+            DrawRange range = { it->first_index, it->index_count,
+                    it->min_vertex, it->max_vertex };
+            draw_ranges_.push_back(range);
+        }
+    }
+    clusters_culled_ = true;
+}
+
+void Mesh::drawElements() {
+    bool culled = clusters_culled_;
+    clusters_culled_ = false;
+    const std::vector<DrawRange>* ranges =
+            culled ? &draw_ranges_ :
+            ranges_restricted_ ? &restricted_ranges_ : 0;
+    GLenum mode = PRIMITIVE_MODES[primitive_type_];
+#if _GVRF_USE_GLES3_
+    if (vertex_array_ == 0) {
+        return;
+    }
+    if (ranges != 0) {
+        int index_size = index_type_ == GL_UNSIGNED_BYTE ? 1 :
+                index_type_ == GL_UNSIGNED_SHORT ? 2 : 4;
+        for (auto it = ranges->begin(); it != ranges->end(); ++it) {
+            glDrawRangeElements(mode, it->min_vertex, it->max_vertex,
+                    it->index_count, index_type_,
+                    reinterpret_cast<const GLvoid*>(it->first_index
+                            * index_size));
+        }
+        return;
+    }
+    glDrawElements(mode, index_count_, index_type_, 0);
+#else
+    if (client_indices_dirty_) {
+        client_indices_dirty_ = false;
+        client_indices_.assign(triangles_.begin(), triangles_.end());
+        if (getIndexType() == GL_UNSIGNED_INT) {
+            LOGE("Mesh::drawElements() : more than 65536 vertices, use split()");
+            client_indices_.clear();
+        }
+    }
+    // GLES2 has no glDrawRangeElements; one draw per range instead
+    if (ranges != 0 && !client_indices_.empty()) {
+        for (auto it = ranges->begin(); it != ranges->end(); ++it) {
+            glDrawElements(mode, it->index_count, GL_UNSIGNED_SHORT,
+                    client_indices_.data() + it->first_index);
+        }
+        return;
+    }
+    glDrawElements(mode, client_indices_.size(), GL_UNSIGNED_SHORT,
+            client_indices_.data());
+#endif
+}
+
+void Mesh::flushVertices() {
+#if _GVRF_USE_GLES3_
+    if (!vertex_arrays_.empty() && !released_
+            && vertices_dirty_end_ > vertices_dirty_begin_) {
+        updateVAO();
+    }
+#endif
+}
+
+template<class T>
+static void copyPart(std::vector<T>& destination,
+        const std::vector<T>& source, int first) {
+    if (source.empty()) {
+        return;
+    }
+    if (destination.size() < first + source.size()) {
+        destination.resize(first + source.size());
+    }
+    std::copy(source.begin(), source.end(), destination.begin() + first);
+}
+
+template<class T>
+static void copyPart(std::map<std::string, std::vector<T>>& destination,
+        const std::map<std::string, std::vector<T>>& source, int first) {
+    for (auto it = source.begin(); it != source.end(); ++it) {
+        copyPart(destination[it->first], it->second, first);
+    }
+}
+
+void Mesh::uploadPart(int first, const Mesh& part) {
+    VertexLayout layout(interleaved_);
+    std::vector<AttributeSource> sources;
+    std::vector<VertexBindings::Source> attributes;
+    int count = part.addAttributes(layout, sources, attributes);
+    if (!released_) {
+        copyPart(vertices_, part.vertices_, first);
+        copyPart(normals_, part.normals_, first);
+        copyPart(tex_coords_, part.tex_coords_, first);
+        copyPart(float_vectors_, part.float_vectors_, first);
+        copyPart(vec2_vectors_, part.vec2_vectors_, first);
+        copyPart(vec3_vectors_, part.vec3_vectors_, first);
+        copyPart(vec4_vectors_, part.vec4_vectors_, first);
+        markVerticesDirty(first, count);
+        flushVertices();
+        return;
+    }
+
+#if _GVRF_USE_GLES3_
+    if (vertex_buffers_.empty() || buffers_quantized_ || part.quantized_
+            || !(layout == vertex_layout_) || attributes != buffer_attributes_
+            || first < 0 || first + count > buffer_vertex_count_) {
+        LOGE("Mesh::uploadPart() : part does not match the buffers");
+        return;
+    }
+    const std::vector<VertexLayout::Attribute>& layout_attributes =
+            layout.attributes();
+    for (int i = 0; i < vertex_buffers_.size() && count > 0; ++i) {
+        part.encodeVertices(layout, sources, i, 0, count, upload_data_);
+        int stride =
+                layout.interleaved() ?
+                        layout.stride() :
+                        VertexLayout::attributeSize(layout_attributes[i].size,
+                                layout_attributes[i].type);
+        GLStreamBuffer::current().upload(vertex_buffers_[i]->id(),
+                first * stride, upload_data_.data(), upload_data_.size());
+    }
+#endif
+}
+
+void Mesh::releaseData() {
+    // what drawing needs later is worked out while the data is here
+    updateBounds();
+    if (quantized_) {
+        getQuantization();
+    }
+    if (clustered_ && clusters_dirty_ && primitive_type_ == TRIANGLES) {
+        clusters_dirty_ = false;
+        clusters_ = MeshClusters::build(triangles_, vertices_);
+    }
+
+    // MeshEyePointee only picks triangles
+    std::vector<glm::vec3> positions;
+    std::vector<unsigned int> triangles;
+    if (residency_ == PICKING && primitive_type_ == TRIANGLES) {
+        triangles = triangles_;
+        MeshSimplifier::weldVertices(triangles, vertices_);
+        if (picking_ratio_ < 1.0f) {
+            int target_index_count = static_cast<int>(triangles.size() / 3
+                    * std::max(picking_ratio_, 0.0f)) * 3;
+            MeshSimplifier::simplify(triangles, vertices_,
+                    std::vector<glm::vec3>(), std::vector<glm::vec2>(),
+                    target_index_count, 0.0f);
+        }
+        std::vector<unsigned int> order = MeshOptimizer::optimizeVertexFetch(
+                triangles, vertices_.size());
+        unsigned int used = 0;
+        for (auto it = triangles.begin(); it != triangles.end(); ++it) {
+            used = std::max(used, *it + 1);
+        }
+        order.resize(used);
+        positions = gatherVertices(vertices_, order);
+    }
+
+    LOGD("Mesh::releaseData() : %lld bytes of %lld kept",
+            static_cast<long long>(positions.size() * sizeof(glm::vec3)
+                    + triangles.size() * sizeof(unsigned int)),
+            getDataSize());
+    vertices_.swap(positions);
+    std::vector<glm::vec3>().swap(normals_);
+    std::vector<glm::vec2>().swap(tex_coords_);
+    float_vectors_.clear();
+    vec2_vectors_.clear();
+    vec3_vectors_.clear();
+    vec4_vectors_.clear();
+    triangles_.swap(triangles);
+    std::vector<unsigned short>().swap(client_indices_);
+    released_ = true;
+    ++version_;
+}
+
+void Mesh::reload(const Mesh& source, bool context_lost) {
+    vertices_ = source.vertices_;
+    normals_ = source.normals_;
+    tex_coords_ = source.tex_coords_;
+    float_vectors_ = source.float_vectors_;
+    vec2_vectors_ = source.vec2_vectors_;
+    vec3_vectors_ = source.vec3_vectors_;
+    vec4_vectors_ = source.vec4_vectors_;
+    triangles_ = source.triangles_;
+    primitive_type_ = source.primitive_type_;
+    released_ = false;
+    ++version_;
+
+    bounds_dirty_ = true;
+    quantization_dirty_ = true;
+    clusters_dirty_ = true;
+    client_indices_dirty_ = true;
+    if (context_lost) {
+        if (index_buffer_) {
+            index_buffer_->abandon();
+        }
+        for (auto it = vertex_buffers_.begin(); it != vertex_buffers_.end();
+                ++it) {
+            (*it)->abandon();
+        }
+        for (auto it = vertex_arrays_.begin(); it != vertex_arrays_.end();
+                ++it) {
+            it->id = 0;
+        }
+    }
+    deleteVAO();
+}
+
+void Mesh::deleteVertexArrays() {
+    for (auto it = vertex_arrays_.begin(); it != vertex_arrays_.end(); ++it) {
+        if (it->id != 0) {
+            glDeleteVertexArrays(1, &it->id);
+        }
+    }
+    vertex_arrays_.clear();
+    vertex_array_ = 0;
+}
+
+void Mesh::deleteVAO() {
+    deleteVertexArrays();
+    vertex_buffers_.clear();
+    buffer_attributes_.clear();
+    vertex_layout_ = VertexLayout(interleaved_);
+    index_buffer_.reset();
+}
+
 }
@@ -21,6 +21,9 @@
 #ifndef MESH_H_
 #define MESH_H_
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
 #include <map>
 #include <memory>
 #include <vector>
@@ -29,15 +32,28 @@
 #include "GLES3/gl3.h"
 #include "glm/glm.hpp"
 #include "gl/gl_buffer.h"
+#include "engine/optimizer/mesh_clusters.h"
 
 #include "objects/hybrid_object.h"
+#include "objects/vertex_bindings.h"
+#include "objects/vertex_layout.h"
+#include "objects/vertex_quantization.h"
 
 namespace gvr {
 class Mesh: public HybridObject {
 public:
     Mesh() :
-            vertices_(), normals_(), tex_coords_(), triangles_(), float_vectors_(), vec2_vectors_(), vec3_vectors_(), vec4_vectors_(), vaoID_(
-                    0), vertexLoc_(-1), normalLoc_(-1), texCoordLoc_(-1) {
+            vertices_(), normals_(), tex_coords_(), triangles_(), float_vectors_(), vec2_vectors_(), vec3_vectors_(), vec4_vectors_(), bounds_min_(), bounds_max_(), bounding_sphere_(), bounds_dirty_(
+                    true), bounding_box_(), quantized_(false), quantization_(), quantization_dirty_(
+                    true), interleaved_(true), index_type_(GL_UNSIGNED_SHORT), index_buffer_(), vertex_layout_(
+                    true), buffer_attributes_(), vertex_buffers_(), buffers_quantized_(
+                    false), buffer_vertex_count_(0), vertex_arrays_(), vertex_array_(0), usage_(STATIC), vertices_dirty_begin_(
+                    std::numeric_limits<int>::max()), vertices_dirty_end_(0), indices_dirty_(
+                    false), upload_data_(), client_indices_(), client_indices_dirty_(
+                    true), clustered_(false), clusters_(), clusters_dirty_(
+                    true), draw_ranges_(), clusters_culled_(false), restricted_ranges_(), ranges_restricted_(
+                    false), residency_(KEEP), picking_ratio_(1.0f), released_(
+                    false), version_(0), index_count_(0), primitive_type_(TRIANGLES) {
     }
 
     ~Mesh() {
@@ -47,13 +63,10 @@ public:
         normals.swap(normals_);
         std::vector<glm::vec2> tex_coords;
         tex_coords.swap(tex_coords_);
-        std::vector<unsigned short> triangles;
+        std::vector<unsigned int> triangles;
         triangles.swap(triangles_);
 
-        if (vaoID_ != 0) {
-            glDeleteVertexArrays(1, &vaoID_);
-            vaoID_ = 0;
-        }
+        deleteVAO();
     }
 
     std::vector<glm::vec3>& vertices() {
@@ -66,10 +79,18 @@ public:
 
     void set_vertices(const std::vector<glm::vec3>& vertices) {
         vertices_ = vertices;
+        bounds_dirty_ = true;
+        quantization_dirty_ = true;
+        clusters_dirty_ = true;
+        markVerticesDirty(0, vertices_.size());
     }
 
     void set_vertices(std::vector<glm::vec3>&& vertices) {
         vertices_ = std::move(vertices);
+        bounds_dirty_ = true;
+        quantization_dirty_ = true;
+        clusters_dirty_ = true;
+        markVerticesDirty(0, vertices_.size());
     }
 
     std::vector<glm::vec3>& normals() {
@@ -82,10 +103,14 @@ public:
 
     void set_normals(const std::vector<glm::vec3>& normals) {
         normals_ = normals;
+        quantization_dirty_ = true;
+        markVerticesDirty(0, normals_.size());
     }
 
     void set_normals(std::vector<glm::vec3>&& normals) {
         normals_ = std::move(normals);
+        quantization_dirty_ = true;
+        markVerticesDirty(0, normals_.size());
     }
 
     std::vector<glm::vec2>& tex_coords() {
@@ -98,28 +123,84 @@ public:
 
     void set_tex_coords(const std::vector<glm::vec2>& tex_coords) {
         tex_coords_ = tex_coords;
+        quantization_dirty_ = true;
+        markVerticesDirty(0, tex_coords_.size());
     }
 
     void set_tex_coords(std::vector<glm::vec2>&& tex_coords) {
         tex_coords_ = std::move(tex_coords);
+        quantization_dirty_ = true;
+        markVerticesDirty(0, tex_coords_.size());
     }
 
-    std::vector<unsigned short>& triangles() {
+    std::vector<unsigned int>& triangles() {
         return triangles_;
     }
 
-    const std::vector<unsigned short>& triangles() const {
+    const std::vector<unsigned int>& triangles() const {
         return triangles_;
     }
 
-    void set_triangles(const std::vector<unsigned short>& triangles) {
+    void set_triangles(const std::vector<unsigned int>& triangles) {
         triangles_ = triangles;
+        client_indices_dirty_ = true;
+        indices_dirty_ = true;
+        clusters_dirty_ = true;
+        ++version_;
     }
 
-    void set_triangles(std::vector<unsigned short>&& triangles) {
+    void set_triangles(std::vector<unsigned int>&& triangles) {
         triangles_ = std::move(triangles);
+        client_indices_dirty_ = true;
+        indices_dirty_ = true;
+        clusters_dirty_ = true;
+        ++version_;
     }
 
+    void set_triangles(const std::vector<unsigned short>& triangles) {
+        triangles_.assign(triangles.begin(), triangles.end());
+        client_indices_dirty_ = true;
+        indices_dirty_ = true;
+        clusters_dirty_ = true;
+        ++version_;
+    }
+
+    /*
+     * The smallest of GL_UNSIGNED_BYTE, GL_UNSIGNED_SHORT and
+     * GL_UNSIGNED_INT that can address every vertex of the mesh.
+     */
+    GLenum getIndexType() const;
+
+    /*
+     * Splits the mesh into as few meshes as needed so that none has more
+     * than max_vertices vertices, for GLES2 which has no 32-bit indices.
+     */
+    std::vector<std::shared_ptr<Mesh>> split(int max_vertices) const;
+
+    /*
+     * Reorders the triangles for the post-transform vertex cache and then
+     * for overdraw, and the vertices in the order the triangles use them;
+     * other primitives only get their vertices reordered. See
+     * MeshOptimizer for overdraw_threshold; 1.05 is a good default.
+     */
+    void optimize(float overdraw_threshold);
+
+    /*
+     * Returns a copy of the mesh cut down by MeshSimplifier to about ratio
+     * of its triangles, and sets error to the geometric error of the copy
+     * in mesh units.
+     */
+    std::shared_ptr<Mesh> simplify(float ratio, float& error) const;
+
+    /*
+     * Simplifies the mesh to each of ratios on a few worker threads, each
+     * level from this mesh rather than from the level before. The levels
+     * and their errors come back in the order of ratios; a renderer
+     * picks a level by projecting its error to the screen.
+     */
+    std::vector<std::shared_ptr<Mesh>> generateLods(
+            const std::vector<float>& ratios, std::vector<float>& errors) const;
+
     std::vector<float>& getFloatVector(std::string key) {
         auto it = float_vectors_.find(key);
         if (it != float_vectors_.end()) {
@@ -144,6 +225,7 @@ public:
 
     void setFloatVector(std::string key, const std::vector<float>& vector) {
         float_vectors_[key] = vector;
+        markVerticesDirty(0, vector.size());
     }
 
     std::vector<glm::vec2>& getVec2Vector(std::string key) {
@@ -168,6 +250,7 @@ public:
 
     void setVec2Vector(std::string key, const std::vector<glm::vec2>& vector) {
         vec2_vectors_[key] = vector;
+        markVerticesDirty(0, vector.size());
     }
 
     std::vector<glm::vec3>& getVec3Vector(std::string key) {
@@ -192,6 +275,7 @@ public:
 
     void setVec3Vector(std::string key, const std::vector<glm::vec3>& vector) {
         vec3_vectors_[key] = vector;
+        markVerticesDirty(0, vector.size());
     }
 
     std::vector<glm::vec4>& getVec4Vector(std::string key) {
@@ -216,60 +300,263 @@ public:
 
     void setVec4Vector(std::string key, const std::vector<glm::vec4>& vector) {
         vec4_vectors_[key] = vector;
+        markVerticesDirty(0, vector.size());
     }
 
+    /*
+     * The bounds are computed together on first use after the vertices
+     * change. The bounding box mesh is shared by the callers until then,
+     * and must not be modified.
+     */
     std::shared_ptr<Mesh> getBoundingBox() const;
 
-    // /////////////////////////////////////////////////
-    //  code for vertex attribute location
+    const glm::vec3& getBoundsMin() const {
+        updateBounds();
+        return bounds_min_;
+    }
 
-    void setVertexLoc(GLuint loc) {
-        vertexLoc_ = loc;
+    const glm::vec3& getBoundsMax() const {
+        updateBounds();
+        return bounds_max_;
     }
 
-    const GLuint getVertexLoc() const {
-        return vertexLoc_;
+    // center in xyz, radius in w
+    const glm::vec4& getBoundingSphere() const {
+        updateBounds();
+        return bounding_sphere_;
     }
 
-    void setNormalLoc(GLuint loc) {
-        normalLoc_ = loc;
+    enum Usage {
+        STATIC = 0, DYNAMIC = 1, STREAM = 2
+    };
+
+    Usage usage() const {
+        return usage_;
     }
 
-    const GLuint getNormalLoc() const {
-        return normalLoc_;
+    /*
+     * What a mesh keeps in memory once generateVAO() has filled its
+     * buffers. KEEP, the default, keeps all of its data. RELEASE frees the
+     * vertices and triangles, keeping only what drawing needs: the bounds,
+     * the clusters and the quantization. PICKING also keeps positions and
+     * triangles for MeshEyePointee, welded across seams and simplified to
+     * picking_ratio of the triangles. GLES2 draws from the data, so it
+     * always keeps it. reload() brings the data back; uploadPart() still
+     * writes to the buffers of a released DYNAMIC or STREAM mesh.
+     */
+    enum Residency {
+        KEEP = 0, RELEASE = 1, PICKING = 2
+    };
+
+    Residency residency() const {
+        return residency_;
     }
 
-    void setTexCoordLoc(GLuint loc) {
-        texCoordLoc_ = loc;
+    void set_residency(Residency residency, float picking_ratio) {
+        residency_ = residency;
+        picking_ratio_ = picking_ratio;
     }
 
-    const GLuint getTexCoordLoc() const {
-        return texCoordLoc_;
+    // whether the data went after upload, leaving none or the picking proxy
+    bool released() const {
+        return released_;
     }
 
-    void setVertexAttribLocF(GLuint location, std::string key) {
-        attribute_float_keys_[location] = key;
+    /*
+     * Replaces the data of the mesh with source's, and generates its
+     * buffers again: the way back from a released mesh, for editing or
+     * after the GL context was lost, in which case its GL objects are
+     * forgotten rather than deleted.
+     */
+    void reload(const Mesh& source, bool context_lost);
+
+    /*
+     * How often the vertex data changes after the first draw. A STATIC
+     * mesh fills its buffers again on a change; DYNAMIC (now and then)
+     * and STREAM (about every frame) meshes upload only the vertices that
+     * changed, through a ring buffer, so the GPU is never waited on. A mesh
+     * that released its data keeps its buffers as they are until reload().
+     */
+    void set_usage(Usage usage) {
+        if (usage != usage_) {
+            usage_ = usage;
+            if (!released_) {
+                deleteVAO();
+            }
+        }
     }
 
-    void setVertexAttribLocV2(GLuint location, std::string key) {
-        attribute_vec2_keys_[location] = key;
+    // for code that edits the vertex data in place: the vertices
+    // [first, first + count) are uploaded again before the next draw
+    void markVerticesDirty(int first, int count) {
+        vertices_dirty_begin_ = std::min(vertices_dirty_begin_, first);
+        vertices_dirty_end_ = std::max(vertices_dirty_end_, first + count);        ++version_;
     }
 
-    void setVertexAttribLocV3(GLuint location, std::string key) {
-        attribute_vec3_keys_[location] = key;
+    // uploads the vertices marked dirty so far to the buffers already
+    // generated, so that edits far apart are not sent as one range
+    void flushVertices();
+
+    /*
+     * Writes the vertices of part over [first, first + part vertex count):
+     * into the data while the mesh has it, else straight into its buffers,
+     * whose attributes part must have exactly and unquantized. For pools
+     * filled a piece at a time; the bounds stay as they were.
+     */
+    void uploadPart(int first, const Mesh& part);
+
+    // for code that edits vertices() in place; also refits the quantization
+    void dirtyBounds() {
+        bounds_dirty_ = true;
+        quantization_dirty_ = true;
+        clusters_dirty_ = true;        ++version_;
     }
 
-    void setVertexAttribLocV4(GLuint location, std::string key) {
-        attribute_vec4_keys_[location] = key;
+    // FNV-1a over the vertex data and the triangles
+    unsigned long long getContentHash() const;
+
+    // a second hash, seeded apart, over all that hasSameContent() compares
+    unsigned long long getCheckHash() const;
+
+    // goes up with every change to the data, release included; any thread
+    // may read it, to tell whether a snapshot of the data still holds
+    unsigned int version() const {
+        return version_;
     }
 
-    // generate VAO
-    void generateVAO();
+    // compares every attribute and the triangles, not just the hash
+    bool hasSameContent(const Mesh& mesh) const;
+
+    // the bytes of vertex and index data the mesh uploads as floats
+    long long getDataSize() const;
+
+    /*
+     * Makes current the vertex array object for a shader program's
+     * bindings, generating it on first use. The mesh has one set of vertex
+     * buffers with all of its attributes, and one index buffer; a vertex
+     * array object only points the program's locations into them, so
+     * programs with the same bindings share one, and a new one needs no
+     * data, even after a STATIC mesh released it.
+     */
+    void generateVAO(const VertexBindings& bindings);
 
     const GLuint getVAOId() const {
-        return vaoID_;
+        return vertex_array_;
+    }
+
+    int vertex_array_count() const {
+        return vertex_arrays_.size();
+    }
+
+    /*
+     * What the indices describe: TRIANGLES, the default, takes them three
+     * at a time, LINES two at a time, LINE_STRIP joins them in order and
+     * POINTS draws each vertex indexed. Clusters, simplification, cache
+     * and overdraw optimization and picking only apply to triangles.
+     */
+    enum PrimitiveType {
+        TRIANGLES = 0, LINES = 1, LINE_STRIP = 2, POINTS = 3
+    };
+
+    PrimitiveType primitive_type() const {
+        return primitive_type_;
+    }
+
+    void set_primitive_type(PrimitiveType primitive_type) {
+        primitive_type_ = primitive_type;
+        clusters_dirty_ = true;
+        clusters_culled_ = false;        ++version_;
+    }
+
+    // a LINES copy of the mesh with every edge of its triangles once, for
+    // wireframe overlays
+    std::shared_ptr<Mesh> getWireframe() const;
+
+    // draws the primitives from the bound vertex array object, or on GLES2
+    // from the attribute arrays the shader has set up
+    void drawElements();
+
+    struct DrawRange {
+        int first_index;
+        int index_count;
+        unsigned int min_vertex;
+        unsigned int max_vertex;
+    };
+
+    /*
+     * Restricts the draws to the index ranges given until they are cleared:
+     * for a mesh used as a pool of chunks of which some are drawn at a
+     * time, such as PointCloud's.
+     */
+    void set_draw_ranges(const std::vector<DrawRange>& draw_ranges) {
+        restricted_ranges_ = draw_ranges;
+        ranges_restricted_ = true;
+    }
+
+    void clear_draw_ranges() {
+        restricted_ranges_.clear();
+        ranges_restricted_ = false;
+    }
+
+    bool interleaved() const {
+        return interleaved_;
+    }
+
+    /*
+     * By default generateVAO packs every attribute into one interleaved
+     * buffer; false gives each attribute its own buffer, as before.
+     * Changing it fills the buffers again on the next draw; a mesh that
+     * released its data keeps the buffers it has until reload().
+     */
+    void set_interleaved(bool interleaved) {
+        if (interleaved != interleaved_) {
+            interleaved_ = interleaved;
+            if (!released_) {
+                deleteVAO();
+            }
+        }
+    }
+
+    bool quantized() const {
+        return quantized_;
+    }
+
+    /*
+     * Opt-in compressed vertex buffers, see VertexQuantization. The mesh
+     * keeps its float data; only what generateVAO uploads changes.
+     * Turning it on fits the format and logs its error bounds. As with
+     * set_interleaved(), a mesh that released its data changes on reload().
+     */
+    void set_quantized(bool quantized);
+
+    bool clustered() const {
+        return clustered_;
     }
 
+    /*
+     * Opt-in for large meshes seen a part at a time, such as terrain and
+     * building shells: the triangles are split into MeshClusters, and the
+     * renderer draws only the clusters cullClusters() keeps.
+     */
+    void set_clustered(bool clustered) {
+        clustered_ = clustered;
+        clusters_culled_ = false;
+    }
+
+    /*
+     * Culls the clusters for the next drawElements() against the frustum
+     * planes and, with backface_culling, the camera position, both in the
+     * space of the mesh. Draws after that one are of the whole mesh again.
+     */
+    void cullClusters(const glm::vec4* frustum,
+            const glm::vec3& camera_position, bool backface_culling);
+
+    // fitted on first use after the vertex data changes
+    const VertexQuantization& getQuantization() const;
+
+    // the model matrix part that decodes quantized positions, or identity
+    const glm::mat4& getDequantizationMatrix() const;
+
     // setter for switching between GL_CLAMP_TO_EDGE and GL_REPEAT
     void setTextureRepeatFlag(bool value) {
         texture_repeat_ = value;
@@ -287,6 +574,38 @@ private:
     Mesh& operator=(const Mesh& mesh);
     Mesh& operator=(Mesh&& mesh);
 
+    struct AttributeSource;
+
+    // a vertex array object, for the VertexBindings::id() it was
+    // generated with
+    struct VertexArray {
+        int bindings_id;
+        GLuint id;
+    };
+
+    void updateBounds() const {
+        if (bounds_dirty_) {
+            computeBounds();
+        }
+    }
+    void computeBounds() const;
+
+    int addAttributes(VertexLayout& layout,
+            std::vector<AttributeSource>& sources,
+            std::vector<VertexBindings::Source>& attributes) const;
+    void encodeVertices(const VertexLayout& layout,
+            const std::vector<AttributeSource>& sources, int attribute,
+            int first, int last, std::vector<unsigned char>& data) const;
+    void uploadIndices();
+    void uploadVertices();
+    void updateVAO();
+    void deleteVertexArrays();
+    void deleteVAO();
+    void releaseData();
+    std::shared_ptr<Mesh> createPart(
+            const std::vector<unsigned int>& part_vertices,
+            std::vector<unsigned int>& part_triangles) const;
+
 private:
     std::vector<glm::vec3> vertices_;
     std::vector<glm::vec3> normals_;
@@ -295,21 +614,57 @@ private:
     std::map<std::string, std::vector<glm::vec2>> vec2_vectors_;
     std::map<std::string, std::vector<glm::vec3>> vec3_vectors_;
     std::map<std::string, std::vector<glm::vec4>> vec4_vectors_;
-    std::vector<unsigned short> triangles_;
-
-    // add location slot map
-    std::map<int, std::string> attribute_float_keys_;
-    std::map<int, std::string> attribute_vec2_keys_;
-    std::map<int, std::string> attribute_vec3_keys_;
-    std::map<int, std::string> attribute_vec4_keys_;
-
-    // add vertex array object and VBO
-    GLuint vaoID_;
-
-    // attribute locations
-    GLuint vertexLoc_;
-    GLuint normalLoc_;
-    GLuint texCoordLoc_;
+    std::vector<unsigned int> triangles_;
+
+    mutable glm::vec3 bounds_min_;
+    mutable glm::vec3 bounds_max_;
+    mutable glm::vec4 bounding_sphere_;
+    mutable bool bounds_dirty_;
+    mutable std::shared_ptr<Mesh> bounding_box_;
+
+    bool quantized_;
+    mutable VertexQuantization quantization_;
+    mutable bool quantization_dirty_;
+
+    // the buffers, what each attribute of vertex_layout_ holds, the vertex
+    // array objects reading them, and the one of the last generateVAO()
+    bool interleaved_;
+    GLenum index_type_;
+    std::unique_ptr<GLBuffer> index_buffer_;
+    VertexLayout vertex_layout_;
+    std::vector<VertexBindings::Source> buffer_attributes_;
+    std::vector<std::unique_ptr<GLBuffer>> vertex_buffers_;
+    bool buffers_quantized_;
+    int buffer_vertex_count_;
+    std::vector<VertexArray> vertex_arrays_;
+    GLuint vertex_array_;
+
+    // what changed since the buffers were filled, and what they hold
+    Usage usage_;
+    int vertices_dirty_begin_;
+    int vertices_dirty_end_;
+    bool indices_dirty_;
+    std::vector<unsigned char> upload_data_;
+
+    // 16-bit copy of the triangles for GLES2 client-side drawing
+    std::vector<unsigned short> client_indices_;
+    bool client_indices_dirty_;
+
+    bool clustered_;
+    std::vector<MeshCluster> clusters_;
+    bool clusters_dirty_;
+    // adjacent visible clusters are merged into one range to draw
+    std::vector<DrawRange> draw_ranges_;
+    bool clusters_culled_;
+    std::vector<DrawRange> restricted_ranges_;
+    bool ranges_restricted_;
+
+    Residency residency_;
+    float picking_ratio_;
+    std::atomic<bool> released_;
+    std::atomic<unsigned int> version_;
+    int index_count_;
+    PrimitiveType primitive_type_;
 
     // boolean flag for switching from GL_CLAMP_TO_EDGE to GL_REPEAT 
     // when texture coordinates are greater than 1.
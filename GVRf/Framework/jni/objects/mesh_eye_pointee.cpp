@@ -20,6 +20,7 @@
 
 #include "mesh_eye_pointee.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "glm/glm.hpp"
@@ -36,9 +37,43 @@ MeshEyePointee::MeshEyePointee(std::shared_ptr<Mesh>&& mesh) :
 MeshEyePointee::~MeshEyePointee() {
 }
 
+// slab test of a ray against a box, both in mesh space
+static bool rayHitsBox(const glm::vec3& origin, const glm::vec3& direction,
+        const glm::vec3& min, const glm::vec3& max) {
+    float near = -std::numeric_limits<float>::infinity();
+    float far = std::numeric_limits<float>::infinity();
+    for (int i = 0; i < 3; ++i) {
+        if (direction[i] == 0.0f) {
+            if (origin[i] < min[i] || origin[i] > max[i]) {
+                return false;
+            }
+        } else {
+            float t1 = (min[i] - origin[i]) / direction[i];
+            float t2 = (max[i] - origin[i]) / direction[i];
+            near = std::max(near, std::min(t1, t2));
+            far = std::min(far, std::max(t1, t2));
+        }
+    }
+    return near <= far && far >= 0.0f;
+}
+
 EyePointData MeshEyePointee::isPointed(const glm::mat4& mv_matrix, float ox,
         float oy, float oz, float dx, float dy, float dz) {
     glm::mat4 inv_mv_matrix = glm::affineInverse(mv_matrix);
+
+    // only triangles are picked; points and lines have no area to hit
+    if (mesh_->primitive_type() != Mesh::TRIANGLES) {
+        return EyePointData();
+    }
+
+    // most rays miss the mesh; the cached bounds reject them without
+    // transforming any vertex
+    glm::vec3 mesh_origin(inv_mv_matrix * glm::vec4(ox, oy, oz, 1.0f));
+    glm::vec3 mesh_direction(inv_mv_matrix * glm::vec4(dx, dy, dz, 0.0f));
+    if (!rayHitsBox(mesh_origin, mesh_direction, mesh_->getBoundsMin(),
+            mesh_->getBoundsMax())) {
+        return EyePointData();
+    }
     std::vector<glm::vec4> relative_veritces;
     for (auto it = mesh_->vertices().begin(); it != mesh_->vertices().end();
             ++it) {
@@ -20,6 +20,11 @@
 
 #include "mesh.h"
 
+#include "glm/gtc/type_ptr.hpp"
+
+#include "engine/optimizer/mesh_optimizer.h"
+#include "objects/mesh_registry.h"
+
 #include "util/gvr_log.h"
 #include "util/gvr_jni.h"
 #include "android/asset_manager_jni.h"
@@ -56,6 +61,14 @@ Java_org_gearvrf_NativeMesh_getTriangles(JNIEnv * env,
 JNIEXPORT void JNICALL
 Java_org_gearvrf_NativeMesh_setTriangles(JNIEnv * env,
         jobject obj, jlong jmesh, jcharArray triangles);
+
+JNIEXPORT jintArray JNICALL
+Java_org_gearvrf_NativeMesh_getIndices(JNIEnv * env,
+        jobject obj, jlong jmesh);
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setIndices(JNIEnv * env,
+        jobject obj, jlong jmesh, jintArray indices);
 JNIEXPORT jfloatArray JNICALL
 Java_org_gearvrf_NativeMesh_getFloatVector(JNIEnv * env,
         jobject obj, jlong jmesh, jstring key);
@@ -87,6 +100,60 @@ Java_org_gearvrf_NativeMesh_setVec4Vector(JNIEnv * env,
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeMesh_getBoundingBox(JNIEnv * env,
         jobject obj, jlong jmesh);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setInterleaved(JNIEnv * env,
+        jobject obj, jlong jmesh, jboolean interleaved);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_optimize(JNIEnv * env,
+        jobject obj, jlong jmesh, jfloat overdraw_threshold);
+JNIEXPORT jfloatArray JNICALL
+Java_org_gearvrf_NativeMesh_getVertexCacheStatistics(JNIEnv * env,
+        jobject obj, jlong jmesh, jint cache_size);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setQuantized(JNIEnv * env,
+        jobject obj, jlong jmesh, jboolean quantized);
+JNIEXPORT jfloatArray JNICALL
+Java_org_gearvrf_NativeMesh_getQuantizationErrors(JNIEnv * env,
+        jobject obj, jlong jmesh);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setUsage(JNIEnv * env,
+        jobject obj, jlong jmesh, jint usage);
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeMesh_updateVertices(JNIEnv * env,
+        jobject obj, jlong jmesh, jint first_vertex, jfloatArray vertices);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_getBounds(JNIEnv * env,
+        jobject obj, jlong jmesh, jfloatArray bounds);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_getBoundingSphere(JNIEnv * env,
+        jobject obj, jlong jmesh, jfloatArray sphere);
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeMesh_generateLods(JNIEnv * env,
+        jobject obj, jlong jmesh, jfloatArray ratios, jfloatArray errors);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setClustered(JNIEnv * env,
+        jobject obj, jlong jmesh, jboolean clustered);
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeMesh_getSharingStatistics(JNIEnv * env,
+        jobject obj);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setResidency(JNIEnv * env,
+        jobject obj, jlong jmesh, jint residency, jfloat picking_ratio);
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeMesh_isReleased(JNIEnv * env,
+        jobject obj, jlong jmesh);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_reload(JNIEnv * env,
+        jobject obj, jlong jmesh, jlong jsource, jboolean context_lost);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeMesh_getPrimitiveType(JNIEnv * env,
+        jobject obj, jlong jmesh);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setPrimitiveType(JNIEnv * env,
+        jobject obj, jlong jmesh, jint primitive_type);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeMesh_getWireframe(JNIEnv * env,
+        jobject obj, jlong jmesh);
 }
 ;
 
@@ -189,7 +256,8 @@ Java_org_gearvrf_NativeMesh_getTriangles(JNIEnv * env,
         jobject obj, jlong jmesh) {
     std::shared_ptr<Mesh> mesh =
             *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
-    std::vector<unsigned short>& triangles = mesh->triangles();
+    std::vector<unsigned int>& indices = mesh->triangles();
+    std::vector<unsigned short> triangles(indices.begin(), indices.end());
     jcharArray jtriangles = env->NewCharArray(triangles.size());
     env->SetCharArrayRegion(jtriangles, 0, triangles.size(), triangles.data());
     return jtriangles;
@@ -212,6 +280,31 @@ Java_org_gearvrf_NativeMesh_setTriangles(JNIEnv * env,
     env->ReleaseCharArrayElements(triangles, jtriangles_pointer, 0);
 }
 
+JNIEXPORT jintArray JNICALL
+Java_org_gearvrf_NativeMesh_getIndices(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    std::vector<unsigned int>& indices = mesh->triangles();
+    jintArray jindices = env->NewIntArray(indices.size());
+    env->SetIntArrayRegion(jindices, 0, indices.size(),
+            reinterpret_cast<const jint*>(indices.data()));
+    return jindices;
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setIndices(JNIEnv * env,
+        jobject obj, jlong jmesh, jintArray indices) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    jint* jindices_pointer = env->GetIntArrayElements(indices, 0);
+    int indices_length = env->GetArrayLength(indices);
+    std::vector<unsigned int> native_indices(jindices_pointer,
+            jindices_pointer + indices_length);
+    mesh->set_triangles(std::move(native_indices));
+    env->ReleaseIntArrayElements(indices, jindices_pointer, JNI_ABORT);
+}
+
 JNIEXPORT jfloatArray JNICALL
 Java_org_gearvrf_NativeMesh_getFloatVector(JNIEnv * env,
         jobject obj, jlong jmesh, jstring key) {
@@ -365,4 +458,197 @@ Java_org_gearvrf_NativeMesh_getBoundingBox(JNIEnv * env,
     return reinterpret_cast<jlong>(new std::shared_ptr<Mesh>(bounding_box));
 }
 
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setInterleaved(JNIEnv * env,
+        jobject obj, jlong jmesh, jboolean interleaved) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    mesh->set_interleaved(static_cast<bool>(interleaved));
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_optimize(JNIEnv * env,
+        jobject obj, jlong jmesh, jfloat overdraw_threshold) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    mesh->optimize(overdraw_threshold);
+}
+
+JNIEXPORT jfloatArray JNICALL
+Java_org_gearvrf_NativeMesh_getVertexCacheStatistics(JNIEnv * env,
+        jobject obj, jlong jmesh, jint cache_size) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    MeshOptimizer::CacheStatistics statistics =
+            MeshOptimizer::analyzeVertexCache(mesh->triangles(),
+                    mesh->vertices().size(), cache_size);
+    jfloat values[] = { statistics.acmr, statistics.atvr };
+    jfloatArray jstatistics = env->NewFloatArray(2);
+    env->SetFloatArrayRegion(jstatistics, 0, 2, values);
+    return jstatistics;
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setQuantized(JNIEnv * env,
+        jobject obj, jlong jmesh, jboolean quantized) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    mesh->set_quantized(static_cast<bool>(quantized));
+}
+
+JNIEXPORT jfloatArray JNICALL
+Java_org_gearvrf_NativeMesh_getQuantizationErrors(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    const VertexQuantization& quantization = mesh->getQuantization();
+    jfloat values[] = { quantization.position_error(),
+            quantization.normal_error(), quantization.tex_coord_error() };
+    jfloatArray jerrors = env->NewFloatArray(3);
+    env->SetFloatArrayRegion(jerrors, 0, 3, values);
+    return jerrors;
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setUsage(JNIEnv * env,
+        jobject obj, jlong jmesh, jint usage) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    mesh->set_usage(static_cast<Mesh::Usage>(usage));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeMesh_updateVertices(JNIEnv * env,
+        jobject obj, jlong jmesh, jint first_vertex, jfloatArray vertices) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    int count = env->GetArrayLength(vertices) / 3;
+    std::vector<glm::vec3>& native_vertices = mesh->vertices();
+    if (first_vertex < 0 || first_vertex + count > native_vertices.size()) {
+        return JNI_FALSE;
+    }
+    env->GetFloatArrayRegion(vertices, 0, count * 3,
+            reinterpret_cast<jfloat*>(native_vertices.data() + first_vertex));
+    mesh->markVerticesDirty(first_vertex, count);
+    mesh->dirtyBounds();
+    return JNI_TRUE;
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_getBounds(JNIEnv * env,
+        jobject obj, jlong jmesh, jfloatArray bounds) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    env->SetFloatArrayRegion(bounds, 0, 3,
+            glm::value_ptr(mesh->getBoundsMin()));
+    env->SetFloatArrayRegion(bounds, 3, 3,
+            glm::value_ptr(mesh->getBoundsMax()));
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_getBoundingSphere(JNIEnv * env,
+        jobject obj, jlong jmesh, jfloatArray sphere) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    env->SetFloatArrayRegion(sphere, 0, 4,
+            glm::value_ptr(mesh->getBoundingSphere()));
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeMesh_generateLods(JNIEnv * env,
+        jobject obj, jlong jmesh, jfloatArray ratios, jfloatArray errors) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    jfloat* ratios_pointer = env->GetFloatArrayElements(ratios, 0);
+    std::vector<float> native_ratios(ratios_pointer,
+            ratios_pointer + env->GetArrayLength(ratios));
+    env->ReleaseFloatArrayElements(ratios, ratios_pointer, JNI_ABORT);
+
+    std::vector<float> native_errors;
+    std::vector<std::shared_ptr<Mesh>> lods = mesh->generateLods(
+            native_ratios, native_errors);
+    env->SetFloatArrayRegion(errors, 0, native_errors.size(),
+            native_errors.data());
+
+    std::vector<jlong> long_lods;
+    for (auto it = lods.begin(); it != lods.end(); ++it) {
+        long_lods.push_back(
+                reinterpret_cast<jlong>(new std::shared_ptr<Mesh>(*it)));
+    }
+    jlongArray jlods = env->NewLongArray(long_lods.size());
+    env->SetLongArrayRegion(jlods, 0, long_lods.size(), long_lods.data());
+    return jlods;
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setClustered(JNIEnv * env,
+        jobject obj, jlong jmesh, jboolean clustered) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    mesh->set_clustered(static_cast<bool>(clustered));
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeMesh_getSharingStatistics(JNIEnv * env,
+        jobject obj) {
+    MeshRegistry::Statistics statistics = MeshRegistry::statistics();
+    jlong values[] = { statistics.mesh_count, statistics.shared_count,
+            statistics.saved_bytes };
+    jlongArray jstatistics = env->NewLongArray(3);
+    env->SetLongArrayRegion(jstatistics, 0, 3, values);
+    return jstatistics;
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setResidency(JNIEnv * env,
+        jobject obj, jlong jmesh, jint residency, jfloat picking_ratio) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    mesh->set_residency(static_cast<Mesh::Residency>(residency),
+            picking_ratio);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeMesh_isReleased(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    return static_cast<jboolean>(mesh->released());
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_reload(JNIEnv * env,
+        jobject obj, jlong jmesh, jlong jsource, jboolean context_lost) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    std::shared_ptr<Mesh> source =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jsource);
+    mesh->reload(*source, static_cast<bool>(context_lost));
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeMesh_getPrimitiveType(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    return mesh->primitive_type();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMesh_setPrimitiveType(JNIEnv * env,
+        jobject obj, jlong jmesh, jint primitive_type) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    mesh->set_primitive_type(static_cast<Mesh::PrimitiveType>(primitive_type));
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeMesh_getWireframe(JNIEnv * env,
+        jobject obj, jlong jmesh) {
+    std::shared_ptr<Mesh> mesh =
+            *reinterpret_cast<std::shared_ptr<Mesh>*>(jmesh);
+    std::shared_ptr<Mesh> wireframe = mesh->getWireframe();
+    return reinterpret_cast<jlong>(new std::shared_ptr<Mesh>(wireframe));
+}
+
 }
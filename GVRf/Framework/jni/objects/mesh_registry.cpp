@@ -0,0 +1,154 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Shares meshes with the same content.
+ ***************************************************************************/
+
+#include "mesh_registry.h"
+
+#include <algorithm>
+
+#include "objects/mesh.h"
+
+namespace gvr {
+std::mutex MeshRegistry::mutex_;
+std::unordered_multimap<unsigned long long, MeshRegistry::Entry> MeshRegistry::meshes_;
+std::unordered_map<unsigned long long, MeshRegistry::Entry> MeshRegistry::sources_;
+int MeshRegistry::shared_count_ = 0;
+long long MeshRegistry::saved_bytes_ = 0;
+int MeshRegistry::prune_size_ = 64;
+
+// read while only the caller has the mesh, outside the lock
+MeshRegistry::Entry MeshRegistry::describe(const std::shared_ptr<Mesh>& mesh) {
+    Entry entry = { mesh, mesh->version(), mesh->getCheckHash(),
+            static_cast<int>(mesh->vertices().size()),
+            static_cast<int>(mesh->triangles().size()), mesh->getDataSize() };
+    return entry;
+}
+
+bool MeshRegistry::isCurrent(const Entry& entry,
+        std::shared_ptr<Mesh>& mesh) {
+    mesh = entry.mesh.lock();
+    return mesh && mesh->version() == entry.version;
+}
+
+void MeshRegistry::prune() {
+    for (auto it = meshes_.begin(); it != meshes_.end();) {
+        if (it->second.mesh.expired()) {
+            it = meshes_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = sources_.begin(); it != sources_.end();) {
+        if (it->second.mesh.expired()) {
+            it = sources_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    prune_size_ = std::max(64,
+            static_cast<int>(std::max(meshes_.size(), sources_.size())) * 2);
+}
+
+std::shared_ptr<Mesh> MeshRegistry::intern(const std::shared_ptr<Mesh>& mesh,
+        unsigned long long hash, Entry& entry) {
+    auto range = meshes_.equal_range(hash);
+    for (auto it = range.first; it != range.second;) {
+        std::shared_ptr<Mesh> registered;
+        if (!isCurrent(it->second, registered)) {
+            it = meshes_.erase(it);
+        } else if (registered == mesh) {
+            entry = it->second;
+            return mesh;
+        } else if (it->second.check_hash == entry.check_hash
+                && it->second.vertex_count == entry.vertex_count
+                && it->second.index_count == entry.index_count
+                && it->second.data_size == entry.data_size) {
+            ++shared_count_;
+            saved_bytes_ += entry.data_size;
+            entry = it->second;
+            return registered;
+        } else {
+            ++it;
+        }
+    }
+    if (meshes_.size() >= prune_size_) {
+        prune();
+    }
+    meshes_.insert(std::make_pair(hash, entry));
+    return mesh;
+}
+
+std::shared_ptr<Mesh> MeshRegistry::intern(
+        const std::shared_ptr<Mesh>& mesh) {
+    Entry entry = describe(mesh);
+    unsigned long long hash = mesh->getContentHash();
+    std::lock_guard<std::mutex> lock(mutex_);
+    return intern(mesh, hash, entry);
+}
+
+std::shared_ptr<Mesh> MeshRegistry::intern(const std::shared_ptr<Mesh>& mesh,
+        unsigned long long source_hash, int source_vertex_count,
+        int source_index_count) {
+    Entry entry = describe(mesh);
+    unsigned long long hash = mesh->getContentHash();
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::shared_ptr<Mesh> registered = intern(mesh, hash, entry);
+    if (sources_.size() >= prune_size_) {
+        prune();
+    }
+    entry.vertex_count = source_vertex_count;
+    entry.index_count = source_index_count;
+    sources_[source_hash] = entry;
+    return registered;
+}
+
+std::shared_ptr<Mesh> MeshRegistry::findSource(
+        unsigned long long source_hash, int source_vertex_count,
+        int source_index_count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = sources_.find(source_hash);
+    if (it == sources_.end()) {
+        return std::shared_ptr<Mesh>();
+    }
+    std::shared_ptr<Mesh> mesh;
+    if (!isCurrent(it->second, mesh)) {
+        sources_.erase(it);
+        return std::shared_ptr<Mesh>();
+    }
+    // another source with the same hash
+    if (it->second.vertex_count != source_vertex_count
+            || it->second.index_count != source_index_count) {
+        return std::shared_ptr<Mesh>();
+    }
+    ++shared_count_;
+    saved_bytes_ += it->second.data_size;
+    return mesh;
+}
+
+MeshRegistry::Statistics MeshRegistry::statistics() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    prune();
+    Statistics statistics;
+    statistics.mesh_count = meshes_.size();
+    statistics.shared_count = shared_count_;
+    statistics.saved_bytes = saved_bytes_;
+    return statistics;
+}
+
+}
@@ -0,0 +1,121 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Shares meshes with the same content.
+ ***************************************************************************/
+
+#ifndef MESH_REGISTRY_H_
+#define MESH_REGISTRY_H_
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace gvr {
+class Mesh;
+
+/*
+ * Meshes are found by content hash and confirmed against a snapshot taken
+ * when they were registered: a second, differently seeded hash and the
+ * vertex and index counts. The data of a registered mesh is never read
+ * again, as the GL thread may be editing or releasing it while a loader
+ * interns off that thread; only its version() is, which tells whether the
+ * snapshot still holds. A mesh passed in must not be edited by another
+ * thread while intern() reads it.
+ *
+ * The registry only holds weak references: a mesh, and with it its vertex
+ * array object and buffers, is released when its last user lets go, as any
+ * other mesh. A registered mesh that is edited or releases its data stops
+ * matching, so it is never handed out for data it no longer has; but edits
+ * to a shared mesh are seen by all its users.
+ *
+ * A loader can also register a mesh under the hash of the source it was
+ * built from, such as an import before optimization, and look that up
+ * before building it again. The source data is not kept, so sources are
+ * matched by their 64-bit hash and their vertex and index counts.
+ */
+class MeshRegistry {
+private:
+    MeshRegistry();
+
+public:
+    struct Statistics {
+        // live meshes in the registry
+        int mesh_count;
+        // requests answered with a mesh already registered
+        int shared_count;
+        // the vertex and index data those requests did not duplicate, in
+        // bytes; as much again was saved in GPU buffers
+        long long saved_bytes;
+    };
+
+    // returns the registered mesh with the content of mesh, or else
+    // registers mesh and returns it
+    static std::shared_ptr<Mesh> intern(const std::shared_ptr<Mesh>& mesh);
+
+    // intern(), remembering the mesh returned as built from the source
+    // with source_hash and those counts
+    static std::shared_ptr<Mesh> intern(const std::shared_ptr<Mesh>& mesh,
+            unsigned long long source_hash, int source_vertex_count,
+            int source_index_count);
+
+    // the live mesh built from the source, or null, also if it has been
+    // edited or released its data since
+    static std::shared_ptr<Mesh> findSource(unsigned long long source_hash,
+            int source_vertex_count, int source_index_count);
+
+    static Statistics statistics();
+
+private:
+    MeshRegistry(const MeshRegistry& mesh_registry);
+    MeshRegistry(MeshRegistry&& mesh_registry);
+    MeshRegistry& operator=(const MeshRegistry& mesh_registry);
+    MeshRegistry& operator=(MeshRegistry&& mesh_registry);
+
+    // a mesh as it was registered; for a source, the counts are the
+    // source's and check_hash is unused
+    struct Entry {
+        std::weak_ptr<Mesh> mesh;
+        unsigned int version;
+        unsigned long long check_hash;
+        int vertex_count;
+        int index_count;
+        long long data_size;
+    };
+
+    static Entry describe(const std::shared_ptr<Mesh>& mesh);
+    // whether entry still describes a live mesh, which is returned
+    static bool isCurrent(const Entry& entry, std::shared_ptr<Mesh>& mesh);
+    // intern() with mutex_ held; entry describes mesh, and is set to the
+    // entry of the mesh returned
+    static std::shared_ptr<Mesh> intern(const std::shared_ptr<Mesh>& mesh,
+            unsigned long long hash, Entry& entry);
+    // drops the meshes released since; call with mutex_ held
+    static void prune();
+
+private:
+    static std::mutex mutex_;
+    static std::unordered_multimap<unsigned long long, Entry> meshes_;
+    static std::unordered_map<unsigned long long, Entry> sources_;
+    static int shared_count_;
+    static long long saved_bytes_;
+    // the size at which intern() prunes next
+    static int prune_size_;
+};
+
+}
+#endif
@@ -0,0 +1,298 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Scene graph edits queued from any thread, applied on the GL thread.
+ ***************************************************************************/
+
+#include "mutation_queue.h"
+
+#include <cstring>
+#include <stdint.h>
+
+#include "glm/glm.hpp"
+
+#include "objects/material.h"
+#include "objects/mesh.h"
+#include "objects/scene.h"
+#include "objects/scene_object.h"
+#include "objects/components/render_data.h"
+#include "objects/components/transform.h"
+#include "objects/textures/texture.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+std::atomic<MutationQueue::Batch*> MutationQueue::head_(0);
+
+class CommandReader {
+public:
+    CommandReader(const char* data, int size) :
+            data_(data), size_(size), offset_(0) {
+    }
+
+    bool done() const {
+        return offset_ >= size_;
+    }
+
+    int32_t readInt() {
+        int32_t value;
+        read(&value, sizeof(value));
+        return value;
+    }
+
+    float readFloat() {
+        float value;
+        read(&value, sizeof(value));
+        return value;
+    }
+
+    template<class T>
+    std::shared_ptr<HybridObject> readObject() {
+        int64_t pointer;
+        read(&pointer, sizeof(pointer));
+        if (pointer == 0) {
+            std::string error = "MutationQueue::decode() : null object";
+            throw error;
+        }
+        return *reinterpret_cast<std::shared_ptr<T>*>(pointer);
+    }
+
+    std::string readString() {
+        int32_t length = readInt();
+        if (length < 0 || length > size_ - offset_) {
+            std::string error = "MutationQueue::decode() : bad key";
+            throw error;
+        }
+        std::string string(data_ + offset_, length);
+        offset_ += (length + 3) & ~3;
+        return string;
+    }
+
+private:
+    void read(void* value, int size) {
+        if (size > size_ - offset_) {
+            std::string error = "MutationQueue::decode() : truncated command";
+            throw error;
+        }
+        memcpy(value, data_ + offset_, size);
+        offset_ += size;
+    }
+
+private:
+    const char* data_;
+    int size_;
+    int offset_;
+};
+
+MutationQueue::Batch* MutationQueue::decode(const char* data, int size) {
+    std::unique_ptr<Batch> batch(new Batch());
+    batch->next = 0;
+    CommandReader reader(data, size);
+    while (!reader.done()) {
+        Command command;
+        command.opcode = reader.readInt();
+        memset(command.values, 0, sizeof(command.values));
+        int value_count = 0;
+        switch (command.opcode) {
+        case ADD_SCENE_OBJECT:
+        case REMOVE_SCENE_OBJECT:
+            command.target = reader.readObject<Scene>();
+            command.argument = reader.readObject<SceneObject>();
+            break;
+        case ADD_CHILD_OBJECT:
+        case REMOVE_CHILD_OBJECT:
+            command.target = reader.readObject<SceneObject>();
+            command.argument = reader.readObject<SceneObject>();
+            break;
+        case ATTACH_TRANSFORM:
+            command.target = reader.readObject<SceneObject>();
+            command.argument = reader.readObject<Transform>();
+            break;
+        case ATTACH_RENDER_DATA:
+            command.target = reader.readObject<SceneObject>();
+            command.argument = reader.readObject<RenderData>();
+            break;
+        case SET_POSITION:
+        case SET_SCALE:
+            command.target = reader.readObject<Transform>();
+            value_count = 3;
+            break;
+        case SET_ROTATION:
+            command.target = reader.readObject<Transform>();
+            value_count = 4;
+            break;
+        case SET_MESH:
+            command.target = reader.readObject<RenderData>();
+            command.argument = reader.readObject<Mesh>();
+            break;
+        case SET_MATERIAL:
+            command.target = reader.readObject<RenderData>();
+            command.argument = reader.readObject<Material>();
+            break;
+        case SET_TEXTURE:
+            command.target = reader.readObject<Material>();
+            command.key = reader.readString();
+            command.argument = reader.readObject<Texture>();
+            break;
+        case SET_FLOAT:
+        case SET_VEC2:
+        case SET_VEC3:
+        case SET_VEC4:
+            command.target = reader.readObject<Material>();
+            command.key = reader.readString();
+            value_count = command.opcode - SET_FLOAT + 1;
+            break;
+        case SET_ENABLED:
+            command.target = reader.readObject<SceneObject>();
+            value_count = 1;
+            break;
+        default: {
+            std::string error = "MutationQueue::decode() : unknown opcode";
+            throw error;
+        }
+        }
+        for (int i = 0; i < value_count; ++i) {
+            command.values[i] = reader.readFloat();
+        }
+        batch->commands.push_back(command);
+    }
+    return batch.release();
+}
+
+void MutationQueue::submit(Batch* batch) {
+    batch->next = head_.load(std::memory_order_relaxed);
+    while (!head_.compare_exchange_weak(batch->next, batch,
+            std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+void MutationQueue::apply() {
+    Batch* batch = head_.exchange(0, std::memory_order_acquire);
+
+    // the stack holds the newest batch first
+    Batch* ordered = 0;
+    while (batch != 0) {
+        Batch* next = batch->next;
+        batch->next = ordered;
+        ordered = batch;
+        batch = next;
+    }
+
+    while (ordered != 0) {
+        for (auto it = ordered->commands.begin();
+                it != ordered->commands.end(); ++it) {
+            try {
+                applyCommand(*it);
+            } catch (std::string error) {
+                LOGE("Error detected in MutationQueue::apply; opcode : %d, error : %s",
+                        it->opcode, error.c_str());
+            }
+        }
+        Batch* next = ordered->next;
+        delete ordered;
+        ordered = next;
+    }
+}
+
+void MutationQueue::applyCommand(const Command& command) {
+    switch (command.opcode) {
+    case ADD_SCENE_OBJECT:
+        std::static_pointer_cast<Scene>(command.target)->addSceneObject(
+                std::static_pointer_cast<SceneObject>(command.argument));
+        break;
+    case REMOVE_SCENE_OBJECT:
+        std::static_pointer_cast<Scene>(command.target)->removeSceneObject(
+                std::static_pointer_cast<SceneObject>(command.argument));
+        break;
+    case ADD_CHILD_OBJECT: {
+        std::shared_ptr<SceneObject> scene_object = std::static_pointer_cast<
+                SceneObject>(command.target);
+        scene_object->addChildObject(scene_object,
+                std::static_pointer_cast<SceneObject>(command.argument));
+        break;
+    }
+    case REMOVE_CHILD_OBJECT:
+        std::static_pointer_cast<SceneObject>(command.target)->removeChildObject(
+                std::static_pointer_cast<SceneObject>(command.argument));
+        break;
+    case ATTACH_TRANSFORM: {
+        std::shared_ptr<SceneObject> scene_object = std::static_pointer_cast<
+                SceneObject>(command.target);
+        scene_object->attachTransform(scene_object,
+                std::static_pointer_cast<Transform>(command.argument));
+        break;
+    }
+    case ATTACH_RENDER_DATA: {
+        std::shared_ptr<SceneObject> scene_object = std::static_pointer_cast<
+                SceneObject>(command.target);
+        scene_object->attachRenderData(scene_object,
+                std::static_pointer_cast<RenderData>(command.argument));
+        break;
+    }
+    case SET_POSITION:
+        std::static_pointer_cast<Transform>(command.target)->set_position(
+                command.values[0], command.values[1], command.values[2]);
+        break;
+    case SET_ROTATION:
+        std::static_pointer_cast<Transform>(command.target)->set_rotation(
+                command.values[0], command.values[1], command.values[2],
+                command.values[3]);
+        break;
+    case SET_SCALE:
+        std::static_pointer_cast<Transform>(command.target)->set_scale(
+                command.values[0], command.values[1], command.values[2]);
+        break;
+    case SET_MESH:
+        std::static_pointer_cast<RenderData>(command.target)->set_mesh(
+                std::static_pointer_cast<Mesh>(command.argument));
+        break;
+    case SET_MATERIAL:
+        std::static_pointer_cast<RenderData>(command.target)->set_material(
+                std::static_pointer_cast<Material>(command.argument));
+        break;
+    case SET_TEXTURE:
+        std::static_pointer_cast<Material>(command.target)->setTexture(
+                command.key,
+                std::static_pointer_cast<Texture>(command.argument));
+        break;
+    case SET_FLOAT:
+        std::static_pointer_cast<Material>(command.target)->setFloat(
+                command.key, command.values[0]);
+        break;
+    case SET_VEC2:
+        std::static_pointer_cast<Material>(command.target)->setVec2(
+                command.key, glm::vec2(command.values[0], command.values[1]));
+        break;
+    case SET_VEC3:
+        std::static_pointer_cast<Material>(command.target)->setVec3(
+                command.key,
+                glm::vec3(command.values[0], command.values[1],
+                        command.values[2]));
+        break;
+    case SET_VEC4:
+        std::static_pointer_cast<Material>(command.target)->setVec4(
+                command.key,
+                glm::vec4(command.values[0], command.values[1],
+                        command.values[2], command.values[3]));
+        break;
+    case SET_ENABLED:
+        std::static_pointer_cast<SceneObject>(command.target)->set_enabled(
+                command.values[0] != 0.0f);
+        break;
+    }
+}
+
+}
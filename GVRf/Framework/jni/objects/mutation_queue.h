@@ -0,0 +1,103 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Scene graph edits queued from any thread, applied on the GL thread.
+ ***************************************************************************/
+
+#ifndef MUTATION_QUEUE_H_
+#define MUTATION_QUEUE_H_
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "objects/hybrid_object.h"
+
+namespace gvr {
+
+/*
+ * Producers decode a whole batch of commands, taking a reference on every
+ * object it names, and push it onto a lock-free stack. The GL thread takes
+ * the entire stack with one exchange and applies the batches in submission
+ * order.
+ */
+class MutationQueue {
+private:
+    MutationQueue();
+
+public:
+    enum Opcode {
+        ADD_SCENE_OBJECT = 1,
+        REMOVE_SCENE_OBJECT = 2,
+        ADD_CHILD_OBJECT = 3,
+        REMOVE_CHILD_OBJECT = 4,
+        ATTACH_TRANSFORM = 5,
+        ATTACH_RENDER_DATA = 6,
+        SET_POSITION = 7,
+        SET_ROTATION = 8,
+        SET_SCALE = 9,
+        SET_MESH = 10,
+        SET_MATERIAL = 11,
+        SET_TEXTURE = 12,
+        SET_FLOAT = 13,
+        SET_VEC2 = 14,
+        SET_VEC3 = 15,
+        SET_VEC4 = 16,
+        SET_ENABLED = 17
+    };
+
+    struct Command {
+        int opcode;
+        std::shared_ptr<HybridObject> target;
+        std::shared_ptr<HybridObject> argument;
+        std::string key;
+        float values[4];
+    };
+
+    struct Batch {
+        std::vector<Command> commands;
+        Batch* next;
+    };
+
+    /*
+     * Commands are a 32-bit opcode followed by its operands: objects as
+     * 64-bit native pointers, floats, and keys as a 32-bit byte count and
+     * UTF-8 bytes padded to 4. Throws on malformed data.
+     */
+    static Batch* decode(const char* data, int size);
+
+    // may be called from any thread
+    static void submit(Batch* batch);
+
+    // GL thread only
+    static void apply();
+
+private:
+    static void applyCommand(const Command& command);
+
+    MutationQueue(const MutationQueue& mutation_queue);
+    MutationQueue(MutationQueue&& mutation_queue);
+    MutationQueue& operator=(const MutationQueue& mutation_queue);
+    MutationQueue& operator=(MutationQueue&& mutation_queue);
+
+private:
+    static std::atomic<Batch*> head_;
+};
+
+}
+#endif
@@ -0,0 +1,56 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "mutation_queue.h"
+
+#include "util/gvr_jni.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeMutationQueue_submit(JNIEnv * env,
+        jobject obj, jobject jbuffer, jint size);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMutationQueue_apply(JNIEnv * env,
+        jobject obj);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeMutationQueue_submit(JNIEnv * env,
+        jobject obj, jobject jbuffer, jint size) {
+    const char* data = static_cast<const char*>(env->GetDirectBufferAddress(
+            jbuffer));
+    try {
+        MutationQueue::submit(MutationQueue::decode(data, size));
+        return JNI_TRUE;
+    } catch (std::string error) {
+        LOGE("%s", error.c_str());
+        return JNI_FALSE;
+    }
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeMutationQueue_apply(JNIEnv * env,
+        jobject obj) {
+    MutationQueue::apply();
+}
+
+}
@@ -0,0 +1,545 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/***************************************************************************
+ * A point cloud streamed into a mesh a chunk at a time.
+ ***************************************************************************/
+
+#include "point_cloud.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <queue>
+#include <random>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "objects/mesh.h"
+#include "objects/scene.h"
+#include "objects/scene_snapshot.h"
+#include "objects/components/camera.h"
+#include "objects/components/camera_rig.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+const int PointCloud::CHUNK_POINTS;
+const char PointCloud::COLOR_KEY[] = "color";
+
+// a node is refined while it covers more than this of the viewport height
+static const float MIN_SCREEN_SIZE = 0.1f;
+
+// 16 bits per axis of the position, 8 per channel of the color
+static const int POINT_BYTES = 10;
+static const float POSITION_STEPS = 65535.0f;
+
+struct PointCloud::Tree {
+    struct Node {
+        // the node's box, and the bounding sphere of it
+        glm::vec3 center;
+        float half_size;
+        float radius;
+        // the node's points are [first, first + count) of the points
+        int first;
+        int count;
+        int children[8];
+    };
+
+    Tree() :
+            nodes(), bounds_min(0.0f), bounds_max(0.0f), points(), path(), file(
+                    -1) {
+    }
+
+    ~Tree() {
+        if (file >= 0) {
+            close(file);
+            unlink(path.c_str());
+        }
+    }
+
+    void build(const std::vector<glm::vec3>& positions,
+            std::vector<int>& order);
+    void store(const std::vector<glm::vec3>& positions,
+            const std::vector<glm::vec4>& colors,
+            const std::vector<int>& order, const std::string& cache_path);
+    const unsigned char* read(const Node& node,
+            std::vector<unsigned char>& buffer) const;
+
+    std::vector<Node> nodes;
+    glm::vec3 bounds_min;
+    glm::vec3 bounds_max;
+    // the encoded points in memory, unless they are in the file
+    std::vector<unsigned char> points;
+    std::string path;
+    int file;
+};
+
+void PointCloud::Tree::build(const std::vector<glm::vec3>& positions,
+        std::vector<int>& order) {
+    struct Task {
+        int node;
+        int end;
+    };
+
+    // the boxes are cubes, so the points are split evenly on every axis
+    glm::vec3 extent = bounds_max - bounds_min;
+    float root_half_size = std::max(std::max(extent.x, extent.y), extent.z)
+            * 0.5f;
+    Node root = { (bounds_min + bounds_max) * 0.5f, root_half_size,
+            root_half_size * std::sqrt(3.0f), 0, 0, { -1, -1, -1, -1, -1, -1,
+                    -1, -1 } };
+    nodes.push_back(root);
+    Task root_task = { 0, static_cast<int>(order.size()) };
+    std::vector<Task> tasks(1, root_task);
+
+    std::vector<unsigned char> octants;
+    std::vector<int> sorted;
+    while (!tasks.empty()) {
+        Task task = tasks.back();
+        tasks.pop_back();
+        int first = nodes[task.node].first;
+        int count = std::min(task.end - first, CHUNK_POINTS);
+        nodes[task.node].count = count;
+        int begin = first + count;
+        if (begin == task.end) {
+            continue;
+        }
+
+        // the rest goes to the children, sorted stably by octant so that
+        // the range of each child is in random order too
+        glm::vec3 center = nodes[task.node].center;
+        int offsets[9] = { };
+        octants.resize(task.end - begin);
+        for (int i = begin; i < task.end; ++i) {
+            const glm::vec3& position = positions[order[i]];
+            unsigned char octant = (position.x > center.x ? 1 : 0)
+                    | (position.y > center.y ? 2 : 0)
+                    | (position.z > center.z ? 4 : 0);
+            octants[i - begin] = octant;
+            ++offsets[octant + 1];
+        }
+        for (int i = 0; i < 8; ++i) {
+            offsets[i + 1] += offsets[i];
+        }
+        sorted.resize(task.end - begin);
+        int next[8];
+        std::copy(offsets, offsets + 8, next);
+        for (int i = begin; i < task.end; ++i) {
+            sorted[next[octants[i - begin]]++] = order[i];
+        }
+        std::copy(sorted.begin(), sorted.end(), order.begin() + begin);
+
+        float half_size = nodes[task.node].half_size * 0.5f;
+        for (int i = 0; i < 8; ++i) {
+            if (offsets[i + 1] == offsets[i]) {
+                continue;
+            }
+            glm::vec3 child_center(center.x + (i & 1 ? half_size : -half_size),
+                    center.y + (i & 2 ? half_size : -half_size),
+                    center.z + (i & 4 ? half_size : -half_size));
+            Node child = { child_center, half_size, half_size
+                    * std::sqrt(3.0f), begin + offsets[i], 0, { -1, -1, -1,
+                    -1, -1, -1, -1, -1 } };
+            nodes[task.node].children[i] = nodes.size();
+            Task child_task = { static_cast<int>(nodes.size()), begin
+                    + offsets[i + 1] };
+            nodes.push_back(child);
+            tasks.push_back(child_task);
+        }
+    }
+}
+
+static bool writeAll(int file, const unsigned char* data, size_t size,
+        off_t offset) {
+    while (size > 0) {
+        ssize_t written = pwrite(file, data, size, offset);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return false;
+        }
+        data += written;
+        size -= written;
+        offset += written;
+    }
+    return true;
+}
+
+// encodes the points a node at a time, each relative to the node's box
+void PointCloud::Tree::store(const std::vector<glm::vec3>& positions,
+        const std::vector<glm::vec4>& colors, const std::vector<int>& order,
+        const std::string& cache_path) {
+    if (!cache_path.empty()) {
+        file = open(cache_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+        if (file < 0) {
+            std::string error = "PointCloud::PointCloud() : cannot create "
+                    + cache_path;
+            throw error;
+        }
+        path = cache_path;
+    } else {
+        points.resize(order.size() * POINT_BYTES);
+    }
+
+    std::vector<unsigned char> encoded;
+    for (auto it = nodes.begin(); it != nodes.end(); ++it) {
+        glm::vec3 origin = it->center - it->half_size;
+        float scale =
+                it->half_size > 0.0f ?
+                        POSITION_STEPS / (2.0f * it->half_size) : 0.0f;
+        encoded.resize(it->count * POINT_BYTES);
+        unsigned char* destination = encoded.data();
+        for (int i = it->first; i < it->first + it->count; ++i) {
+            glm::vec3 steps = glm::clamp((positions[order[i]] - origin) * scale,
+                    0.0f, POSITION_STEPS) + 0.5f;
+            unsigned short position[3] = { static_cast<unsigned short>(steps.x),
+                    static_cast<unsigned short>(steps.y),
+                    static_cast<unsigned short>(steps.z) };
+            std::memcpy(destination, position, sizeof(position));
+            glm::vec4 color = colors.empty() ? glm::vec4(1.0f) : colors[order[i]];
+            color = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+            destination[6] = static_cast<unsigned char>(color.r);
+            destination[7] = static_cast<unsigned char>(color.g);
+            destination[8] = static_cast<unsigned char>(color.b);
+            destination[9] = static_cast<unsigned char>(color.a);
+            destination += POINT_BYTES;
+        }
+
+        off_t offset = static_cast<off_t>(it->first) * POINT_BYTES;
+        if (file < 0) {
+            std::copy(encoded.begin(), encoded.end(), points.begin() + offset);
+        } else if (!writeAll(file, encoded.data(), encoded.size(), offset)) {
+            std::string error = "PointCloud::PointCloud() : cannot write "
+                    + cache_path;
+            throw error;
+        }
+    }
+}
+
+// the encoded points of node, in buffer if they come from the file; null
+// if they cannot be read
+const unsigned char* PointCloud::Tree::read(const Node& node,
+        std::vector<unsigned char>& buffer) const {
+    off_t offset = static_cast<off_t>(node.first) * POINT_BYTES;
+    if (file < 0) {
+        return points.data() + offset;
+    }
+    buffer.resize(node.count * POINT_BYTES);
+    size_t done = 0;
+    while (done < buffer.size()) {
+        ssize_t count = pread(file, buffer.data() + done,
+                buffer.size() - done, offset + done);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count <= 0) {
+            return 0;
+        }
+        done += count;
+    }
+    return buffer.data();
+}
+
+PointCloud::PointCloud(const std::vector<glm::vec3>& positions,
+        const std::vector<glm::vec4>& colors, int point_budget,
+        int upload_budget, const std::string& cache_path) :
+        tree_(), mesh_(), chunk_(), chunk_data_(), node_slots_(), last_selected_(), slot_nodes_(), upload_budget_(
+                upload_budget), frame_(0), drawn_point_count_(0), streamed_point_count_(
+                0) {
+    if (!colors.empty() && colors.size() != positions.size()) {
+        std::string error =
+                "PointCloud::PointCloud() : colors do not match the positions";
+        throw error;
+    }
+
+    std::shared_ptr<Tree> tree(new Tree());
+    if (!positions.empty()) {
+        tree->bounds_min = tree->bounds_max = positions[0];
+    }
+    for (auto it = positions.begin(); it != positions.end(); ++it) {
+        tree->bounds_min = glm::min(tree->bounds_min, *it);
+        tree->bounds_max = glm::max(tree->bounds_max, *it);
+    }
+
+    // in random order, the first points of any range are a sample of it
+    std::vector<int> order(positions.size());
+    for (int i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::minstd_rand random;
+    std::shuffle(order.begin(), order.end(), random);
+    tree->build(positions, order);
+    tree->store(positions, colors, order, cache_path);
+    tree_ = tree;
+
+    createMesh(std::max(point_budget / CHUNK_POINTS, 1));
+}
+
+PointCloud::PointCloud(const std::shared_ptr<const Tree>& tree,
+        int slot_count, int upload_budget) :
+        tree_(tree), mesh_(), chunk_(), chunk_data_(), node_slots_(), last_selected_(), slot_nodes_(), upload_budget_(
+                upload_budget), frame_(0), drawn_point_count_(0), streamed_point_count_(
+                0) {
+    createMesh(slot_count);
+}
+
+PointCloud::~PointCloud() {
+}
+
+std::shared_ptr<PointCloud> PointCloud::clone() const {
+    return std::shared_ptr<PointCloud>(
+            new PointCloud(tree_, slot_nodes_.size(), upload_budget_));
+}
+
+void PointCloud::createMesh(int slot_count) {
+    node_slots_.assign(tree_->nodes.size(), -1);
+    last_selected_.assign(tree_->nodes.size(), 0);
+    slot_nodes_.assign(slot_count, -1);
+
+    // the slots not streamed yet hold the corners of the bounds, so the
+    // bounds of the mesh are those of the whole cloud from the start
+    int capacity = slot_count * CHUNK_POINTS;
+    std::vector<glm::vec3> vertices(capacity);
+    std::vector<unsigned int> indices(capacity);
+    for (int i = 0; i < capacity; ++i) {
+        vertices[i] = i % 2 == 0 ? tree_->bounds_min : tree_->bounds_max;
+        indices[i] = i;
+    }
+    mesh_.reset(new Mesh());
+    mesh_->set_vertices(std::move(vertices));
+    mesh_->setVec4Vector(COLOR_KEY, std::vector<glm::vec4>(capacity));
+    mesh_->set_triangles(std::move(indices));
+    mesh_->set_primitive_type(Mesh::POINTS);
+    mesh_->set_usage(Mesh::DYNAMIC);
+    mesh_->set_draw_ranges(std::vector<Mesh::DrawRange>());
+    // the nodes are streamed straight into the buffers once they exist
+    mesh_->set_residency(Mesh::RELEASE, 1.0f);
+
+    chunk_.reset(new Mesh());
+    chunk_->setVec4Vector(COLOR_KEY, std::vector<glm::vec4>());
+}
+
+// a free slot, or else the one whose node was selected longest ago but not
+// by this update; -1 when every slot is in use by this update
+int PointCloud::findSlot() const {
+    int slot = -1;
+    unsigned int oldest = frame_;
+    for (int i = 0; i < slot_nodes_.size(); ++i) {
+        if (slot_nodes_[i] < 0) {
+            return i;
+        }
+        unsigned int last_selected = last_selected_[slot_nodes_[i]];
+        if (last_selected != frame_
+                && (slot < 0 || frame_ - last_selected > frame_ - oldest)) {
+            slot = i;
+            oldest = last_selected;
+        }
+    }
+    return slot;
+}
+
+bool PointCloud::stream(int node, int slot) {
+    const Tree::Node& source = tree_->nodes[node];
+    const unsigned char* data = tree_->read(source, chunk_data_);
+    if (data == 0) {
+        LOGE("PointCloud::stream() : cannot read node %d of %s", node,
+                tree_->path.c_str());
+        return false;
+    }
+
+    std::vector<glm::vec3>& vertices = chunk_->vertices();
+    std::vector<glm::vec4>& colors = chunk_->getVec4Vector(COLOR_KEY);
+    vertices.resize(source.count);
+    colors.resize(source.count);
+    glm::vec3 origin = source.center - source.half_size;
+    float step = 2.0f * source.half_size / POSITION_STEPS;
+    for (int i = 0; i < source.count; ++i) {
+        unsigned short position[3];
+        std::memcpy(position, data, sizeof(position));
+        vertices[i] = origin
+                + glm::vec3(position[0], position[1], position[2]) * step;
+        colors[i] = glm::vec4(data[6], data[7], data[8], data[9])
+                * (1.0f / 255.0f);
+        data += POINT_BYTES;
+    }
+
+    if (slot_nodes_[slot] >= 0) {
+        node_slots_[slot_nodes_[slot]] = -1;
+    }
+    slot_nodes_[slot] = node;
+    node_slots_[node] = slot;
+
+    // each slot goes up on its own, not as one range with those between
+    mesh_->uploadPart(slot * CHUNK_POINTS, *chunk_);
+    streamed_point_count_ += source.count;
+    return true;
+}
+
+// the fraction of the viewport height the node's sphere covers at most
+static float screenSize(const glm::vec3& center, float radius,
+        const glm::vec4& depth, float projection_scale) {
+    float distance = glm::dot(depth, glm::vec4(center, 1.0f)) - radius;
+    return distance > 0.0f ?
+            radius * projection_scale / distance :
+            std::numeric_limits<float>::max();
+}
+
+void PointCloud::update(const glm::mat4& left_mvp_matrix,
+        const glm::mat4& right_mvp_matrix) {
+    ++frame_;
+    const std::vector<Tree::Node>& nodes = tree_->nodes;
+    if (nodes.empty()) {
+        return;
+    }
+
+    // planes in the space of the points, normals pointing inward; the eyes
+    // are apart sideways only, so they share the other planes, and the
+    // outer side plane of each bounds what either sees
+    glm::mat4 left = glm::transpose(left_mvp_matrix);
+    glm::mat4 right = glm::transpose(right_mvp_matrix);
+    glm::vec4 frustum[6] = { left[3] + left[0], right[3] - right[0], left[3]
+            + left[1], left[3] - left[1], left[3] + left[2], left[3] - left[2] };
+    for (int i = 0; i < 6; ++i) {
+        frustum[i] /= glm::length(glm::vec3(frustum[i]));
+    }
+    // w, from between the eyes; a length in the space of the points times
+    // projection_scale, over w, is a fraction of the viewport height
+    glm::vec4 depth = (left[3] + right[3]) * 0.5f;
+    float projection_scale = glm::length(glm::vec3(left[1]));
+
+    // the nodes largest on screen first; a node is only reached through
+    // its parent, so the parent of every selected node is selected too
+    std::priority_queue<std::pair<float, int>> queue;
+    queue.push(std::make_pair(screenSize(nodes[0].center, nodes[0].radius,
+            depth, projection_scale), 0));
+    std::vector<int> selected;
+    int uploaded = 0;
+    while (!queue.empty() && selected.size() < slot_nodes_.size()) {
+        float screen_size = queue.top().first;
+        int index = queue.top().second;
+        queue.pop();
+        const Tree::Node& node = nodes[index];
+        bool visible = true;
+        for (int i = 0; i < 6 && visible; ++i) {
+            visible = glm::dot(glm::vec3(frustum[i]), node.center)
+                    + frustum[i].w >= -node.radius;
+        }
+        if (!visible) {
+            continue;
+        }
+
+        if (node_slots_[index] < 0) {
+            // one node per update is streamed whatever its size
+            int slot = uploaded > 0 && uploaded + node.count > upload_budget_ ?
+                    -1 : findSlot();
+            if (slot < 0 || !stream(index, slot)) {
+                continue;
+            }
+            uploaded += node.count;
+        }
+        last_selected_[index] = frame_;
+        selected.push_back(index);
+
+        if (screen_size <= MIN_SCREEN_SIZE) {
+            continue;
+        }
+        for (int i = 0; i < 8; ++i) {
+            int child = node.children[i];
+            if (child >= 0) {
+                queue.push(std::make_pair(screenSize(nodes[child].center,
+                        nodes[child].radius, depth, projection_scale), child));
+            }
+        }
+    }
+
+    // adjacent slots are drawn as one range
+    std::vector<int> slots;
+    for (auto it = selected.begin(); it != selected.end(); ++it) {
+        slots.push_back(node_slots_[*it]);
+    }
+    std::sort(slots.begin(), slots.end());
+    std::vector<Mesh::DrawRange> ranges;
+    drawn_point_count_ = 0;
+    for (auto it = slots.begin(); it != slots.end(); ++it) {
+        int first = *it * CHUNK_POINTS;
+        int count = nodes[slot_nodes_[*it]].count;
+        drawn_point_count_ += count;
+        if (!ranges.empty()
+                && ranges.back().first_index + ranges.back().index_count
+                        == first) {
+            ranges.back().index_count += count;
+            ranges.back().max_vertex = first + count - 1;
+        } else {
+            Mesh::DrawRange range = { first, count,
+                    static_cast<unsigned int>(first),
+                    static_cast<unsigned int>(first + count - 1) };
+            ranges.push_back(range);
+        }
+    }
+    mesh_->set_draw_ranges(ranges);
+}
+
+void PointCloud::updateAll(Scene* scene) {
+    std::shared_ptr<CameraRig> camera_rig = scene->main_camera_rig();
+    if (!camera_rig || !camera_rig->left_camera()
+            || !camera_rig->right_camera()) {
+        return;
+    }
+    std::shared_ptr<Camera> left_camera = camera_rig->left_camera();
+    std::shared_ptr<Camera> right_camera = camera_rig->right_camera();
+    glm::mat4 left_vp_matrix = left_camera->getProjectionMatrix()
+            * left_camera->getViewMatrix();
+    glm::mat4 right_vp_matrix = right_camera->getProjectionMatrix()
+            * right_camera->getViewMatrix();
+
+    // the transforms of this frame, as the eyes will draw them
+    scene->publishSnapshot();
+    std::shared_ptr<const SceneSnapshot> snapshot = scene->snapshot();
+    if (!snapshot) {
+        return;
+    }
+
+    // kept between frames so the update does not allocate; a point cloud
+    // drawn by several objects is updated for the first of them
+    static std::vector<PointCloud*> updated;
+    updated.clear();
+    for (int i = 0; i < snapshot->chunk_count(); ++i) {
+        const SceneSnapshot::Chunk* chunk = snapshot->chunk(i);
+        if (chunk == 0) {
+            continue;
+        }
+        for (int j = 0; j < SceneSnapshot::CHUNK_SIZE; ++j) {
+            const SceneSnapshot::Entry& entry = chunk->entries[j];
+            PointCloud* point_cloud = entry.point_cloud.get();
+            if (!entry.in_scene || !entry.active || point_cloud == 0
+                    || std::find(updated.begin(), updated.end(), point_cloud)
+                            != updated.end()) {
+                continue;
+            }
+            updated.push_back(point_cloud);
+            point_cloud->update(left_vp_matrix * entry.model_matrix,
+                    right_vp_matrix * entry.model_matrix);
+        }
+    }
+}
+
+}
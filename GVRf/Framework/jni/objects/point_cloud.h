@@ -0,0 +1,138 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/***************************************************************************
+ * A point cloud streamed into a mesh a chunk at a time.
+ ***************************************************************************/
+
+#ifndef POINT_CLOUD_H_
+#define POINT_CLOUD_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+#include "objects/hybrid_object.h"
+
+namespace gvr {
+class Mesh;
+class Scene;
+
+/*
+ * The points are sorted into an octree whose nodes hold up to CHUNK_POINTS
+ * each: an inner node a random sample of the points in its box, which its
+ * children refine, and a leaf all that is left. The points of each node
+ * are kept compressed, in memory or in a cache file, at 10 bytes a point:
+ * positions as 16 bits per axis within the node's box, colors as 8 bits
+ * per channel in [0, 1]. The mesh is a pool of slots of CHUNK_POINTS
+ * vertices, as many as the point budget allows, which releases its data
+ * once on the GPU.
+ *
+ * Every update() walks the octree from the nodes largest on screen down,
+ * selecting those seen by either eye until the slots are used up, and
+ * draws only the slots of the selected nodes. A node not in a slot yet is
+ * decoded and streamed into the one selected longest ago, up to the upload
+ * budget per update; the nodes below it wait for a later update.
+ *
+ * The mesh has no data to reload() after the GL context is lost; create
+ * the point cloud again instead.
+ */
+class PointCloud: public HybridObject {
+public:
+    static const int CHUNK_POINTS = 8192;
+
+    // the key of the colors in the mesh, for the color attribute
+    static const char COLOR_KEY[];
+
+    // the points wait in the file at cache_path, which is removed with the
+    // last clone, or in memory if it is empty
+    PointCloud(const std::vector<glm::vec3>& positions,
+            const std::vector<glm::vec4>& colors, int point_budget,
+            int upload_budget, const std::string& cache_path);
+    ~PointCloud();
+
+    // the same points, with a mesh and selection of its own, so each copy
+    // is drawn as its own view sees it
+    std::shared_ptr<PointCloud> clone() const;
+
+    // a POINTS mesh, to draw with a shader that reads COLOR_KEY
+    const std::shared_ptr<Mesh>& mesh() const {
+        return mesh_;
+    }
+
+    int node_count() const {
+        return node_slots_.size();
+    }
+
+    // of the last update()
+    int drawn_point_count() const {
+        return drawn_point_count_;
+    }
+
+    // since the point cloud was created
+    long long streamed_point_count() const {
+        return streamed_point_count_;
+    }
+
+    /*
+     * Selects and streams the nodes for a frame, on the GL thread, given
+     * the model-view-projection matrices of both eyes.
+     */
+    void update(const glm::mat4& left_mvp_matrix,
+            const glm::mat4& right_mvp_matrix);
+
+    // GL thread only, once per frame before the eyes are drawn; updates
+    // each point cloud in scene once, for the eyes of its main camera rig
+    static void updateAll(Scene* scene);
+
+private:
+    PointCloud(const PointCloud& point_cloud);
+    PointCloud(PointCloud&& point_cloud);
+    PointCloud& operator=(const PointCloud& point_cloud);
+    PointCloud& operator=(PointCloud&& point_cloud);
+
+    // the octree and the compressed points, shared by clones
+    struct Tree;
+
+    PointCloud(const std::shared_ptr<const Tree>& tree, int slot_count,
+            int upload_budget);
+
+    void createMesh(int slot_count);
+    int findSlot() const;
+    bool stream(int node, int slot);
+
+private:
+    std::shared_ptr<const Tree> tree_;
+    std::shared_ptr<Mesh> mesh_;
+    // a node decoded, on its way to a slot
+    std::unique_ptr<Mesh> chunk_;
+    std::vector<unsigned char> chunk_data_;
+    // the slot of each node, or -1 when not streamed
+    std::vector<int> node_slots_;
+    std::vector<unsigned int> last_selected_;
+    // the node in each slot, or -1
+    std::vector<int> slot_nodes_;
+    int upload_budget_;
+    unsigned int frame_;
+    int drawn_point_count_;
+    long long streamed_point_count_;
+};
+
+}
+#endif
@@ -0,0 +1,128 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "point_cloud.h"
+
+#include "objects/mesh.h"
+#include "objects/scene.h"
+#include "util/gvr_jni.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativePointCloud_ctor(JNIEnv * env,
+        jobject obj, jfloatArray positions, jfloatArray colors,
+        jint point_budget, jint upload_budget, jstring cache_path);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativePointCloud_getMesh(JNIEnv * env,
+        jobject obj, jlong jpoint_cloud);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativePointCloud_getNodeCount(JNIEnv * env,
+        jobject obj, jlong jpoint_cloud);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativePointCloud_getDrawnPointCount(JNIEnv * env,
+        jobject obj, jlong jpoint_cloud);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativePointCloud_getStreamedPointCount(JNIEnv * env,
+        jobject obj, jlong jpoint_cloud);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativePointCloud_updateAll(JNIEnv * env,
+        jobject obj, jlong jscene);
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativePointCloud_ctor(JNIEnv * env,
+        jobject obj, jfloatArray positions, jfloatArray colors,
+        jint point_budget, jint upload_budget, jstring cache_path) {
+    jfloat* jpositions_pointer = env->GetFloatArrayElements(positions, 0);
+    glm::vec3* positions_pointer =
+            reinterpret_cast<glm::vec3*>(jpositions_pointer);
+    int positions_length = static_cast<int>(env->GetArrayLength(positions))
+            / (sizeof(glm::vec3) / sizeof(jfloat));
+    std::vector<glm::vec3> native_positions(positions_pointer,
+            positions_pointer + positions_length);
+    env->ReleaseFloatArrayElements(positions, jpositions_pointer, JNI_ABORT);
+
+    std::vector<glm::vec4> native_colors;
+    if (colors != 0) {
+        jfloat* jcolors_pointer = env->GetFloatArrayElements(colors, 0);
+        glm::vec4* colors_pointer =
+                reinterpret_cast<glm::vec4*>(jcolors_pointer);
+        int colors_length = static_cast<int>(env->GetArrayLength(colors))
+                / (sizeof(glm::vec4) / sizeof(jfloat));
+        native_colors.assign(colors_pointer, colors_pointer + colors_length);
+        env->ReleaseFloatArrayElements(colors, jcolors_pointer, JNI_ABORT);
+    }
+
+    std::string native_cache_path;
+    if (cache_path != 0) {
+        const char* char_cache_path = env->GetStringUTFChars(cache_path, 0);
+        native_cache_path = std::string(char_cache_path);
+        env->ReleaseStringUTFChars(cache_path, char_cache_path);
+    }
+
+    return reinterpret_cast<jlong>(new std::shared_ptr<PointCloud>(
+            new PointCloud(native_positions, native_colors, point_budget,
+                    upload_budget, native_cache_path)));
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativePointCloud_getMesh(JNIEnv * env,
+        jobject obj, jlong jpoint_cloud) {
+    std::shared_ptr<PointCloud> point_cloud = *reinterpret_cast<std::shared_ptr<
+            PointCloud>*>(jpoint_cloud);
+    return reinterpret_cast<jlong>(new std::shared_ptr<Mesh>(
+            point_cloud->mesh()));
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativePointCloud_getNodeCount(JNIEnv * env,
+        jobject obj, jlong jpoint_cloud) {
+    std::shared_ptr<PointCloud> point_cloud = *reinterpret_cast<std::shared_ptr<
+            PointCloud>*>(jpoint_cloud);
+    return point_cloud->node_count();
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativePointCloud_getDrawnPointCount(JNIEnv * env,
+        jobject obj, jlong jpoint_cloud) {
+    std::shared_ptr<PointCloud> point_cloud = *reinterpret_cast<std::shared_ptr<
+            PointCloud>*>(jpoint_cloud);
+    return point_cloud->drawn_point_count();
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativePointCloud_getStreamedPointCount(JNIEnv * env,
+        jobject obj, jlong jpoint_cloud) {
+    std::shared_ptr<PointCloud> point_cloud = *reinterpret_cast<std::shared_ptr<
+            PointCloud>*>(jpoint_cloud);
+    return point_cloud->streamed_point_count();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativePointCloud_updateAll(JNIEnv * env,
+        jobject obj, jlong jscene) {
+    std::shared_ptr<Scene> scene =
+            *reinterpret_cast<std::shared_ptr<Scene>*>(jscene);
+    PointCloud::updateAll(scene.get());
+}
+
+}
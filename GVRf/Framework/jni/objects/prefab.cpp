@@ -0,0 +1,61 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * A scene object subtree stamped out as cheap clones.
+ ***************************************************************************/
+
+#include "prefab.h"
+
+#include <algorithm>
+
+#include "objects/scene_object.h"
+
+namespace gvr {
+void Prefab::prune() {
+    auto end = instances_.begin();
+    for (auto it = instances_.begin(); it != instances_.end(); ++it) {
+        if (!it->expired()) {
+            *end++ = *it;
+        }
+    }
+    instances_.erase(end, instances_.end());
+    prune_size_ = std::max(64, static_cast<int>(instances_.size()) * 2);
+}
+
+std::shared_ptr<SceneObject> Prefab::instantiate() {
+    std::shared_ptr<SceneObject> instance = scene_object_->cloneHierarchy();
+    if (instances_.size() >= prune_size_) {
+        prune();
+    }
+    instances_.push_back(instance);
+    return instance;
+}
+
+std::vector<std::shared_ptr<SceneObject>> Prefab::instances() {
+    prune();
+    std::vector<std::shared_ptr<SceneObject>> instances;
+    instances.reserve(instances_.size());
+    for (auto it = instances_.begin(); it != instances_.end(); ++it) {
+        std::shared_ptr<SceneObject> instance = it->lock();
+        if (instance) {
+            instances.push_back(instance);
+        }
+    }
+    return instances;
+}
+
+}
@@ -0,0 +1,73 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * A scene object subtree stamped out as cheap clones.
+ ***************************************************************************/
+
+#ifndef PREFAB_H_
+#define PREFAB_H_
+
+#include <memory>
+#include <vector>
+
+#include "objects/hybrid_object.h"
+
+namespace gvr {
+class SceneObject;
+
+/*
+ * Keeps the source subtree and weak references to its instances. Render
+ * data of instances cloned from the same source node share an instance
+ * group until one of them is changed.
+ */
+class Prefab: public HybridObject {
+public:
+    explicit Prefab(const std::shared_ptr<SceneObject>& scene_object) :
+            HybridObject(), scene_object_(scene_object), instances_(), prune_size_(
+                    64) {
+    }
+
+    ~Prefab() {
+    }
+
+    const std::shared_ptr<SceneObject>& scene_object() const {
+        return scene_object_;
+    }
+
+    std::shared_ptr<SceneObject> instantiate();
+
+    // drops the instances that have been destroyed
+    std::vector<std::shared_ptr<SceneObject>> instances();
+
+private:
+    Prefab(const Prefab& prefab);
+    Prefab(Prefab&& prefab);
+    Prefab& operator=(const Prefab& prefab);
+    Prefab& operator=(Prefab&& prefab);
+
+    void prune();
+
+private:
+    std::shared_ptr<SceneObject> scene_object_;
+    // an expired weak_ptr still pins the pooled block of its clone, so
+    // instantiate() prunes once the list doubles
+    std::vector<std::weak_ptr<SceneObject>> instances_;
+    int prune_size_;
+};
+
+}
+#endif
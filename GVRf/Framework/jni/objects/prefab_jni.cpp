@@ -0,0 +1,74 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "prefab.h"
+
+#include "objects/scene_object.h"
+#include "util/gvr_jni.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativePrefab_ctor(JNIEnv * env,
+        jobject obj, jlong jscene_object);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativePrefab_instantiate(JNIEnv * env,
+        jobject obj, jlong jprefab);
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativePrefab_getInstances(JNIEnv * env,
+        jobject obj, jlong jprefab);
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativePrefab_ctor(JNIEnv * env,
+        jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    return reinterpret_cast<jlong>(new std::shared_ptr<Prefab>(
+            new Prefab(scene_object)));
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativePrefab_instantiate(JNIEnv * env,
+        jobject obj, jlong jprefab) {
+    std::shared_ptr<Prefab> prefab =
+            *reinterpret_cast<std::shared_ptr<Prefab>*>(jprefab);
+    return reinterpret_cast<jlong>(new std::shared_ptr<SceneObject>(
+            prefab->instantiate()));
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativePrefab_getInstances(JNIEnv * env,
+        jobject obj, jlong jprefab) {
+    std::shared_ptr<Prefab> prefab =
+            *reinterpret_cast<std::shared_ptr<Prefab>*>(jprefab);
+    std::vector<std::shared_ptr<SceneObject>> instances = prefab->instances();
+    std::vector<jlong> long_instances(instances.size());
+    for (int i = 0; i < instances.size(); ++i) {
+        long_instances[i] = reinterpret_cast<jlong>(
+                new std::shared_ptr<SceneObject>(instances[i]));
+    }
+    jlongArray jinstances = env->NewLongArray(long_instances.size());
+    env->SetLongArrayRegion(jinstances, 0, long_instances.size(),
+            long_instances.data());
+    return jinstances;
+}
+
+}
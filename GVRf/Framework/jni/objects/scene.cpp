@@ -20,40 +20,206 @@
 
 #include "scene.h"
 
+#include <algorithm>
+
+#include "objects/material.h"
 #include "objects/scene_object.h"
+#include "objects/components/component_registry.h"
+#include "objects/components/render_data.h"
 
 namespace gvr {
 Scene::Scene() :
-        HybridObject(), scene_objects_(), main_camera_rig_() {
+        HybridObject(), scene_objects_(), name_index_(), tag_index_(), main_camera_rig_(), snapshot_mutex_(), snapshot_(
+                new SceneSnapshot()), dirty_entities_(), dirty_bits_() {
 	dirtyFlag_ = 0;
 }
 
 Scene::~Scene() {
+    for (SceneObject* scene_object = scene_objects_.first().get();
+            scene_object != 0;
+            scene_object = scene_object->next_sibling().get()) {
+        if (scene_object->scene() == this) {
+            scene_object->setScene(0);
+        }
+    }
 }
 
 void Scene::addSceneObject(const std::shared_ptr<SceneObject>& scene_object) {
-    scene_objects_.push_back(scene_object);
+    if (scene_objects_.contains(scene_object.get())) {
+        return;
+    }
+    std::shared_ptr<SceneObject> parent = scene_object->parent();
+    if (parent) {
+        parent->removeChildObject(scene_object);
+    }
+    scene_objects_.pushBack(scene_object);
+    scene_object->setScene(this);
 }
 
 void Scene::removeSceneObject(
         const std::shared_ptr<SceneObject>& scene_object) {
-    scene_objects_.erase(
-            std::remove(scene_objects_.begin(), scene_objects_.end(),
-                    scene_object), scene_objects_.end());
+    if (scene_objects_.contains(scene_object.get())) {
+        scene_objects_.remove(scene_object.get());
+        scene_object->setScene(0);
+    }
 }
 
 std::vector<std::shared_ptr<SceneObject>> Scene::getWholeSceneObjects() {
     std::vector < std::shared_ptr < SceneObject >> scene_objects =
-            scene_objects_;
+            scene_objects_.toVector();
     for (int i = 0; i < scene_objects.size(); ++i) {
-        std::vector < std::shared_ptr
-                < SceneObject >> children(scene_objects[i]->children());
-        for (auto it = children.begin(); it != children.end(); ++it) {
-            scene_objects.push_back(*it);
+        for (const std::shared_ptr<SceneObject>* child =
+                &scene_objects[i]->first_child(); *child;
+                child = &(*child)->next_sibling()) {
+            scene_objects.push_back(*child);
         }
     }
 
     return scene_objects;
 }
 
+const std::vector<SceneObject*>& Scene::find(const SceneObjectIndex& index,
+        int id) {
+    static const std::vector<SceneObject*> empty;
+    auto it = index.find(id);
+    return it != index.end() ? it->second : empty;
+}
+
+void Scene::remove(SceneObjectIndex& index, int id,
+        SceneObject* scene_object) {
+    auto it = index.find(id);
+    if (it == index.end()) {
+        return;
+    }
+    std::vector<SceneObject*>& scene_objects = it->second;
+    auto position = std::find(scene_objects.begin(), scene_objects.end(),
+            scene_object);
+    if (position != scene_objects.end()) {
+        *position = scene_objects.back();
+        scene_objects.pop_back();
+    }
+}
+
+void Scene::indexSceneObject(SceneObject* scene_object) {
+    if (scene_object->name_id() != StringTable::EMPTY) {
+        name_index_[scene_object->name_id()].push_back(scene_object);
+    }
+    const std::vector<int>& tag_ids = scene_object->tag_ids();
+    for (auto it = tag_ids.begin(); it != tag_ids.end(); ++it) {
+        tag_index_[*it].push_back(scene_object);
+    }
+}
+
+void Scene::unindexSceneObject(SceneObject* scene_object) {
+    if (scene_object->name_id() != StringTable::EMPTY) {
+        remove(name_index_, scene_object->name_id(), scene_object);
+    }
+    const std::vector<int>& tag_ids = scene_object->tag_ids();
+    for (auto it = tag_ids.begin(); it != tag_ids.end(); ++it) {
+        remove(tag_index_, *it, scene_object);
+    }
+}
+
+void Scene::markDirty(int entity) {
+    if (entity >= dirty_bits_.size()) {
+        dirty_bits_.resize(entity + 1, false);
+    }
+    if (!dirty_bits_[entity]) {
+        dirty_bits_[entity] = true;
+        dirty_entities_.push_back(entity);
+    }
+}
+
+void Scene::publishSnapshot() {
+    if (dirty_entities_.empty()) {
+        return;
+    }
+
+    std::shared_ptr<const SceneSnapshot> previous = snapshot();
+    std::shared_ptr<SceneSnapshot> next(new SceneSnapshot(*previous));
+    std::vector<std::shared_ptr<SceneSnapshot::Chunk>> cloned_chunks;
+
+    for (auto it = dirty_entities_.begin(); it != dirty_entities_.end();
+            ++it) {
+        int entity = *it;
+        dirty_bits_[entity] = false;
+
+        int chunk_index = entity / SceneSnapshot::CHUNK_SIZE;
+        if (chunk_index >= next->chunks_.size()) {
+            next->chunks_.resize(chunk_index + 1);
+        }
+        if (chunk_index >= cloned_chunks.size()) {
+            cloned_chunks.resize(chunk_index + 1);
+        }
+
+        std::shared_ptr<SceneSnapshot::Chunk>& chunk =
+                cloned_chunks[chunk_index];
+        if (!chunk) {
+            const std::shared_ptr<const SceneSnapshot::Chunk>& old_chunk =
+                    next->chunks_[chunk_index];
+            chunk.reset(
+                    old_chunk ?
+                            new SceneSnapshot::Chunk(*old_chunk) :
+                            new SceneSnapshot::Chunk());
+        }
+
+        SceneSnapshot::Entry& entry = chunk->entries[entity
+                % SceneSnapshot::CHUNK_SIZE];
+        if (entry.in_scene) {
+            --chunk->count;
+        }
+        entry = SceneSnapshot::Entry();
+
+        const EntityHotData& hot_data = ComponentRegistry::hot_data(entity);
+        if (hot_data.scene != this) {
+            continue;
+        }
+
+        SceneObject* scene_object = hot_data.scene_object;
+        std::shared_ptr<SceneObject> parent = scene_object->parent();
+        entry.in_scene = true;
+        entry.parent = parent ? parent->entity_id() : -1;
+        entry.active = hot_data.active;
+        if (!entry.active) {
+            ++chunk->count;
+            continue;
+        }
+        if (hot_data.transform != 0) {
+            entry.model_matrix = hot_data.transform->getModelMatrix();
+        }
+        if (hot_data.render_data != 0) {
+            entry.render_data = scene_object->render_data();
+            entry.mesh = entry.render_data->mesh();
+            entry.material = entry.render_data->material();
+            entry.render_mask = entry.render_data->render_mask();
+            entry.rendering_order = entry.render_data->rendering_order();
+            entry.point_cloud = entry.render_data->point_cloud();
+            entry.cull_test = entry.render_data->cull_test();
+            entry.offset = entry.render_data->offset();
+            entry.offset_factor = entry.render_data->offset_factor();
+            entry.offset_units = entry.render_data->offset_units();
+            entry.depth_test = entry.render_data->depth_test();
+            entry.alpha_blend = entry.render_data->alpha_blend();
+            entry.line_width = entry.render_data->line_width();
+            entry.point_size = entry.render_data->point_size();
+            entry.frustum_culling = entry.render_data->frustum_culling();
+        }
+        ++chunk->count;
+    }
+    dirty_entities_.clear();
+
+    for (int i = 0; i < cloned_chunks.size(); ++i) {
+        if (cloned_chunks[i]) {
+            if (cloned_chunks[i]->count > 0) {
+                next->chunks_[i] = cloned_chunks[i];
+            } else {
+                next->chunks_[i].reset();
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    snapshot_ = next;
+}
+
 }
@@ -22,14 +22,16 @@
 #define SCENE_H_
 
 #include <memory>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
-
 #include "objects/hybrid_object.h"
+#include "objects/scene_object.h"
+#include "objects/scene_snapshot.h"
 
 namespace gvr {
 class CameraRig;
-class SceneObject;
 
 class Scene: public HybridObject {
 public:
@@ -37,8 +39,11 @@ public:
     virtual ~Scene();
     void addSceneObject(const std::shared_ptr<SceneObject>& scene_object);
     void removeSceneObject(const std::shared_ptr<SceneObject>& scene_object);
-    const std::vector<std::shared_ptr<SceneObject>>& scene_objects() {
-        return scene_objects_;
+    std::vector<std::shared_ptr<SceneObject>> scene_objects() const {
+        return scene_objects_.toVector();
+    }
+    const std::shared_ptr<SceneObject>& first_scene_object() const {
+        return scene_objects_.first();
     }
     const std::shared_ptr<CameraRig>& main_camera_rig() {
         return main_camera_rig_;
@@ -48,6 +53,29 @@ public:
     }
     std::vector<std::shared_ptr<SceneObject>> getWholeSceneObjects();
 
+    /*
+     * Every object in the scene, roots and descendants, is indexed by its
+     * name and tags. Ids come from StringTable; the lookups neither walk the
+     * hierarchy nor allocate.
+     */
+    const std::vector<SceneObject*>& getSceneObjectsByName(int name_id) const {
+        return find(name_index_, name_id);
+    }
+    const std::vector<SceneObject*>& getSceneObjectsByTag(int tag_id) const {
+        return find(tag_index_, tag_id);
+    }
+    void indexSceneObject(SceneObject* scene_object);
+    void unindexSceneObject(SceneObject* scene_object);
+
+    void markDirty(int entity);
+    void publishSnapshot();
+
+    // may be called from any thread
+    std::shared_ptr<const SceneSnapshot> snapshot() {
+        std::lock_guard<std::mutex> lock(snapshot_mutex_);
+        return snapshot_;
+    }
+
     int getSceneDirtyFlag() { return 1 || dirtyFlag_;  /* force to be true */}
     void setSceneDirtyFlag(int dirtyBits) { dirtyFlag_ |= dirtyBits; }
 
@@ -58,9 +86,24 @@ private:
     Scene& operator=(Scene&& scene);
 
 private:
-    std::vector<std::shared_ptr<SceneObject>> scene_objects_;
+    typedef std::unordered_map<int, std::vector<SceneObject*>> SceneObjectIndex;
+
+    static const std::vector<SceneObject*>& find(const SceneObjectIndex& index,
+            int id);
+    static void remove(SceneObjectIndex& index, int id,
+            SceneObject* scene_object);
+
+private:
+    SceneObjectList scene_objects_;
+    SceneObjectIndex name_index_;
+    SceneObjectIndex tag_index_;
     std::shared_ptr<CameraRig> main_camera_rig_;
 
+    std::mutex snapshot_mutex_;
+    std::shared_ptr<const SceneSnapshot> snapshot_;
+    std::vector<int> dirty_entities_;
+    std::vector<bool> dirty_bits_;
+
     int dirtyFlag_;
 };
 
@@ -44,6 +44,18 @@ Java_org_gearvrf_NativeScene_setMainCameraRig(JNIEnv * env,
 JNIEXPORT jlongArray JNICALL
 Java_org_gearvrf_NativeScene_getWholeSceneObjects(JNIEnv * env,
         jobject obj, jlong jscene);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeScene_getStringId(JNIEnv * env,
+        jobject obj, jstring string);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeScene_findStringId(JNIEnv * env,
+        jobject obj, jstring string);
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeScene_getSceneObjectsByName(JNIEnv * env,
+        jobject obj, jlong jscene, jint name_id);
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeScene_getSceneObjectsByTag(JNIEnv * env,
+        jobject obj, jlong jscene, jint tag_id);
 }
 ;
 
@@ -109,4 +121,55 @@ Java_org_gearvrf_NativeScene_getWholeSceneObjects(JNIEnv * env,
     return jscene_objects;
 }
 
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeScene_getStringId(JNIEnv * env,
+        jobject obj, jstring string) {
+    const char* native_string = env->GetStringUTFChars(string, 0);
+    int id = StringTable::intern(std::string(native_string));
+    env->ReleaseStringUTFChars(string, native_string);
+    return id;
+}
+
+// -1 if no object was ever given the string, without adding it
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeScene_findStringId(JNIEnv * env,
+        jobject obj, jstring string) {
+    const char* native_string = env->GetStringUTFChars(string, 0);
+    std::string lookup(native_string);
+    env->ReleaseStringUTFChars(string, native_string);
+    int id = StringTable::find(lookup);
+    return id != StringTable::EMPTY || lookup.empty() ? id : -1;
+}
+
+static jlongArray toLongArray(JNIEnv * env,
+        const std::vector<SceneObject*>& scene_objects) {
+    std::vector<jlong> long_scene_objects;
+    long_scene_objects.reserve(scene_objects.size());
+    for (auto it = scene_objects.begin(); it != scene_objects.end(); ++it) {
+        long_scene_objects.push_back(
+                reinterpret_cast<jlong>(new std::shared_ptr<SceneObject>(
+                        (*it)->shared_this())));
+    }
+    jlongArray jscene_objects = env->NewLongArray(long_scene_objects.size());
+    env->SetLongArrayRegion(jscene_objects, 0, long_scene_objects.size(),
+            long_scene_objects.data());
+    return jscene_objects;
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeScene_getSceneObjectsByName(JNIEnv * env,
+        jobject obj, jlong jscene, jint name_id) {
+    std::shared_ptr<Scene> scene =
+            *reinterpret_cast<std::shared_ptr<Scene>*>(jscene);
+    return toLongArray(env, scene->getSceneObjectsByName(name_id));
+}
+
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeScene_getSceneObjectsByTag(JNIEnv * env,
+        jobject obj, jlong jscene, jint tag_id) {
+    std::shared_ptr<Scene> scene =
+            *reinterpret_cast<std::shared_ptr<Scene>*>(jscene);
+    return toLongArray(env, scene->getSceneObjectsByTag(tag_id));
+}
+
 }
@@ -20,119 +20,298 @@
 
 #include "scene_object.h"
 
+#include "objects/components/billboard.h"
 #include "objects/components/camera.h"
 #include "objects/components/camera_rig.h"
 #include "objects/components/eye_pointee_holder.h"
 #include "objects/components/render_data.h"
+#include "objects/components/trigger_volume.h"
+#include "objects/scene.h"
+#include "util/block_allocator.h"
 #include "util/gvr_log.h"
 
 namespace gvr {
+bool SceneObjectList::contains(const SceneObject* scene_object) const {
+    return scene_object->list_ == this;
+}
+
+void SceneObjectList::pushBack(
+        const std::shared_ptr<SceneObject>& scene_object) {
+    if (scene_object->list_ != 0) {
+        scene_object->list_->remove(scene_object.get());
+    }
+    scene_object->list_ = this;
+    scene_object->prev_sibling_ = last_;
+    if (last_ != 0) {
+        last_->next_sibling_ = scene_object;
+    } else {
+        first_ = scene_object;
+    }
+    last_ = scene_object.get();
+    ++size_;
+}
+
+void SceneObjectList::remove(SceneObject* scene_object) {
+    SceneObject* prev_sibling = scene_object->prev_sibling_;
+    std::shared_ptr<SceneObject>& link =
+            prev_sibling != 0 ? prev_sibling->next_sibling_ : first_;
+    // keeps the object alive until it is fully unlinked
+    std::shared_ptr<SceneObject> removed(std::move(link));
+    link = std::move(scene_object->next_sibling_);
+    if (link) {
+        link->prev_sibling_ = prev_sibling;
+    } else {
+        last_ = prev_sibling;
+    }
+    scene_object->prev_sibling_ = 0;
+    scene_object->list_ = 0;
+    --size_;
+}
+
+void SceneObjectList::clear() {
+    // unlinks one member at a time so long lists do not recurse
+    while (first_) {
+        std::shared_ptr<SceneObject> scene_object(std::move(first_));
+        first_ = std::move(scene_object->next_sibling_);
+        scene_object->prev_sibling_ = 0;
+        scene_object->list_ = 0;
+    }
+    last_ = 0;
+    size_ = 0;
+}
+
+const std::shared_ptr<SceneObject>& SceneObjectList::at(int index) const {
+    if (index < 0 || index >= size_) {
+        std::string error = "SceneObjectList::at() : Out of index.";
+        throw error;
+    }
+    const std::shared_ptr<SceneObject>* scene_object = &first_;
+    for (int i = 0; i < index; ++i) {
+        scene_object = &(*scene_object)->next_sibling_;
+    }
+    return *scene_object;
+}
+
+std::vector<std::shared_ptr<SceneObject>> SceneObjectList::toVector() const {
+    std::vector<std::shared_ptr<SceneObject>> scene_objects;
+    scene_objects.reserve(size_);
+    for (SceneObject* scene_object = first_.get(); scene_object != 0;
+            scene_object = scene_object->next_sibling_.get()) {
+        scene_objects.push_back(
+                scene_object->prev_sibling_ != 0 ?
+                        scene_object->prev_sibling_->next_sibling_ : first_);
+    }
+    return scene_objects;
+}
+
 SceneObject::SceneObject() :
-        HybridObject(), name_(""), transform_(), render_data_(), camera_(), camera_rig_(), eye_pointee_holder_(), parent_(), children_() {
+        HybridObject(), entity_id_(ComponentRegistry::createEntity(this)), enabled_(true), parent_(), children_(), list_(
+                0), next_sibling_(), prev_sibling_(0) {
 }
 
 SceneObject::~SceneObject() {
+    detachTransform();
+    detachRenderData();
+    detachCamera();
+    detachCameraRig();
+    detachEyePointeeHolder();
+    detachBillboard();
+    detachTriggerVolume();
+    Scene* scene = this->scene();
+    if (scene) {
+        scene->unindexSceneObject(this);
+    }
+    ComponentRegistry::destroyEntity(entity_id_);
 }
 
 void SceneObject::attachTransform(const std::shared_ptr<SceneObject>& self,
         const std::shared_ptr<Transform>& transform) {
-    if (transform_) {
-        detachTransform();
-    }
-    std::shared_ptr<SceneObject> owner_object(transform->owner_object());
-    if (owner_object) {
-        owner_object->detachRenderData();
-    }
-    transform_ = transform;
-    transform_->set_owner_object(self);
+    attachComponent(self, transform);
 }
 
 void SceneObject::detachTransform() {
-    if (transform_) {
-        transform_->removeOwnerObject();
-        transform_.reset();
-    }
+    detachComponent<Transform>();
+}
+
+std::shared_ptr<Transform> SceneObject::transform() const {
+    return getComponent<Transform>();
 }
 
 void SceneObject::attachRenderData(const std::shared_ptr<SceneObject>& self,
         const std::shared_ptr<RenderData>& render_data) {
-    if (render_data_) {
-        detachRenderData();
-    }
-    std::shared_ptr<SceneObject> owner_object(render_data->owner_object());
-    if (owner_object) {
-        owner_object->detachRenderData();
-    }
-    render_data_ = render_data;
-    render_data->set_owner_object(self);
+    attachComponent(self, render_data);
 }
 
 void SceneObject::detachRenderData() {
-    if (render_data_) {
-        render_data_->removeOwnerObject();
-        render_data_.reset();
-    }
+    detachComponent<RenderData>();
+}
+
+std::shared_ptr<RenderData> SceneObject::render_data() const {
+    return getComponent<RenderData>();
 }
 
 void SceneObject::attachCamera(const std::shared_ptr<SceneObject>& self,
         const std::shared_ptr<Camera>& camera) {
-    if (camera_) {
-        detachCamera();
-    }
-    std::shared_ptr<SceneObject> owner_object(camera->owner_object());
-    if (owner_object) {
-        owner_object->detachCamera();
-    }
-    camera_ = camera;
-    camera_->set_owner_object(self);
+    attachComponent(self, camera);
 }
 
 void SceneObject::detachCamera() {
-    if (camera_) {
-        camera_->removeOwnerObject();
-        camera_.reset();
-    }
+    detachComponent<Camera>();
+}
+
+std::shared_ptr<Camera> SceneObject::camera() const {
+    return getComponent<Camera>();
 }
 
 void SceneObject::attachCameraRig(const std::shared_ptr<SceneObject>& self,
         const std::shared_ptr<CameraRig>& camera_rig) {
-    if (camera_rig_) {
-        detachCameraRig();
-    }
-    std::shared_ptr<SceneObject> owner_object(camera_rig->owner_object());
-    if (owner_object) {
-        owner_object->detachCameraRig();
-    }
-    camera_rig_ = camera_rig;
-    camera_rig_->set_owner_object(self);
+    attachComponent(self, camera_rig);
 }
 
 void SceneObject::detachCameraRig() {
-    if (camera_rig_) {
-        camera_rig_->removeOwnerObject();
-        camera_rig_.reset();
-    }
+    detachComponent<CameraRig>();
+}
+
+std::shared_ptr<CameraRig> SceneObject::camera_rig() const {
+    return getComponent<CameraRig>();
 }
 
 void SceneObject::attachEyePointeeHolder(
         const std::shared_ptr<SceneObject>& self,
         const std::shared_ptr<EyePointeeHolder>& eye_pointee_holder) {
-    if (eye_pointee_holder_) {
-        detachEyePointeeHolder();
+    attachComponent(self, eye_pointee_holder);
+}
+
+void SceneObject::detachEyePointeeHolder() {
+    detachComponent<EyePointeeHolder>();
+}
+
+std::shared_ptr<EyePointeeHolder> SceneObject::eye_pointee_holder() const {
+    return getComponent<EyePointeeHolder>();
+}
+
+void SceneObject::attachBillboard(const std::shared_ptr<SceneObject>& self,
+        const std::shared_ptr<Billboard>& billboard) {
+    attachComponent(self, billboard);
+}
+
+void SceneObject::detachBillboard() {
+    detachComponent<Billboard>();
+}
+
+std::shared_ptr<Billboard> SceneObject::billboard() const {
+    return getComponent<Billboard>();
+}
+
+void SceneObject::attachTriggerVolume(const std::shared_ptr<SceneObject>& self,
+        const std::shared_ptr<TriggerVolume>& trigger_volume) {
+    attachComponent(self, trigger_volume);
+}
+
+void SceneObject::detachTriggerVolume() {
+    detachComponent<TriggerVolume>();
+}
+
+std::shared_ptr<TriggerVolume> SceneObject::trigger_volume() const {
+    return getComponent<TriggerVolume>();
+}
+
+void SceneObject::set_name(const std::string& name) {
+    int name_id = StringTable::intern(name);
+    Scene* scene = this->scene();
+    if (scene) {
+        scene->unindexSceneObject(this);
     }
-    std::shared_ptr<SceneObject> owner_object(
-            eye_pointee_holder->owner_object());
-    if (owner_object) {
-        owner_object->detachEyePointeeHolder();
+    ComponentRegistry::set_name_id(entity_id_, name_id);
+    if (scene) {
+        scene->indexSceneObject(this);
     }
-    eye_pointee_holder_ = eye_pointee_holder;
-    eye_pointee_holder_->set_owner_object(self);
 }
 
-void SceneObject::detachEyePointeeHolder() {
-    if (eye_pointee_holder_) {
-        eye_pointee_holder_->removeOwnerObject();
-        eye_pointee_holder_.reset();
+void SceneObject::addTag(const std::string& tag) {
+    int tag_id = StringTable::intern(tag);
+    Scene* scene = this->scene();
+    if (scene) {
+        scene->unindexSceneObject(this);
+    }
+    ComponentRegistry::addTag(entity_id_, tag_id);
+    if (scene) {
+        scene->indexSceneObject(this);
+    }
+}
+
+void SceneObject::removeTag(const std::string& tag) {
+    int tag_id = StringTable::find(tag);
+    if (tag_id == StringTable::EMPTY || !hasTag(tag_id)) {
+        return;
+    }
+    Scene* scene = this->scene();
+    if (scene) {
+        scene->unindexSceneObject(this);
+    }
+    ComponentRegistry::removeTag(entity_id_, tag_id);
+    if (scene) {
+        scene->indexSceneObject(this);
+    }
+}
+
+std::shared_ptr<SceneObject> SceneObject::shared_this() const {
+    if (list_ == 0) {
+        return std::shared_ptr<SceneObject>();
+    }
+    return prev_sibling_ != 0 ? prev_sibling_->next_sibling_ : list_->first();
+}
+
+void SceneObject::setScene(Scene* scene) {
+    Scene* old_scene = ComponentRegistry::scene(entity_id_);
+    if (old_scene != scene) {
+        if (old_scene) {
+            old_scene->unindexSceneObject(this);
+            old_scene->markDirty(entity_id_);
+        }
+        ComponentRegistry::set_scene(entity_id_, scene);
+        if (scene) {
+            scene->indexSceneObject(this);
+        }
+        markDirty();
+    }
+    for (SceneObject* child = children_.first().get(); child != 0;
+            child = child->next_sibling_.get()) {
+        child->setScene(scene);
+    }
+}
+
+void SceneObject::markDirty() {
+    Scene* scene = ComponentRegistry::scene(entity_id_);
+    if (scene) {
+        scene->markDirty(entity_id_);
+    }
+}
+
+void SceneObject::set_enabled(bool enabled) {
+    if (enabled_ != enabled) {
+        enabled_ = enabled;
+        updateActive();
+    }
+}
+
+void SceneObject::updateActive() {
+    std::shared_ptr<SceneObject> parent = parent_.lock();
+    std::vector<std::pair<SceneObject*, bool>> stack(1,
+            std::make_pair(this, parent ? parent->active() : true));
+    while (!stack.empty()) {
+        SceneObject* scene_object = stack.back().first;
+        bool active = scene_object->enabled_ && stack.back().second;
+        stack.pop_back();
+        if (active == scene_object->active()) {
+            continue;
+        }
+        ComponentRegistry::set_active(scene_object->entity_id_, active);
+        scene_object->markDirty();
+        for (SceneObject* child = scene_object->children_.first().get();
+                child != 0; child = child->next_sibling_.get()) {
+            stack.push_back(std::make_pair(child, active));
+        }
     }
 }
 
@@ -147,16 +326,22 @@ void SceneObject::addChildObject(std::shared_ptr<SceneObject> self,
             throw error;
         }
     }
-    children_.push_back(child);
+    // moves the child out of its previous parent or scene in O(1)
+    children_.pushBack(child);
     child->parent_ = self;
+    child->markDirty();
+    child->setScene(scene());
+    child->updateActive();
     child->transform()->invalidate();
 }
 
 void SceneObject::removeChildObject(std::shared_ptr<SceneObject> child) {
-    if (child->parent_.lock().get() == this) {
-        children_.erase(std::remove(children_.begin(), children_.end(), child),
-                children_.end());
+    if (children_.contains(child.get())) {
+        children_.remove(child.get());
         child->parent_.reset();
+        child->markDirty();
+        child->setScene(0);
+        child->updateActive();
     }
 }
 
@@ -166,11 +351,94 @@ int SceneObject::getChildrenCount() const {
 
 const std::shared_ptr<SceneObject>& SceneObject::getChildByIndex(int index) {
     if (index < children_.size()) {
-        return children_[index];
+        return children_.at(index);
     } else {
         std::string error = "SceneObject::getChildByIndex() : Out of index.";
         throw error;
     }
 }
 
+int SceneObject::getHierarchySize() const {
+    int size = 0;
+    std::vector<const SceneObject*> stack(1, this);
+    while (!stack.empty()) {
+        const SceneObject* scene_object = stack.back();
+        stack.pop_back();
+        ++size;
+        for (SceneObject* child = scene_object->first_child().get();
+                child != 0; child = child->next_sibling().get()) {
+            stack.push_back(child);
+        }
+    }
+    return size;
+}
+
+static std::shared_ptr<SceneObject> cloneNode(const SceneObject* source,
+        const BlockAllocator<SceneObject>& allocator) {
+    std::shared_ptr<SceneObject> clone = std::allocate_shared<SceneObject>(
+            allocator);
+    ComponentRegistry::set_name_id(clone->entity_id(), source->name_id());
+    const std::vector<int>& tag_ids = source->tag_ids();
+    for (auto it = tag_ids.begin(); it != tag_ids.end(); ++it) {
+        ComponentRegistry::addTag(clone->entity_id(), *it);
+    }
+    clone->set_enabled(source->enabled());
+
+    std::shared_ptr<Transform> transform = source->transform();
+    if (transform) {
+        std::shared_ptr<Transform> cloned_transform = std::allocate_shared<
+                Transform>(allocator);
+        cloned_transform->set_position(transform->position());
+        cloned_transform->set_rotation(transform->rotation());
+        cloned_transform->set_scale(transform->scale());
+        clone->attachTransform(clone, cloned_transform);
+    }
+
+    std::shared_ptr<RenderData> render_data = source->render_data();
+    if (render_data) {
+        std::shared_ptr<RenderData> cloned_render_data = std::allocate_shared<
+                RenderData>(allocator);
+        cloned_render_data->copyFrom(*render_data);
+        clone->attachRenderData(clone, cloned_render_data);
+    }
+
+    std::shared_ptr<Billboard> billboard = source->billboard();
+    if (billboard) {
+        std::shared_ptr<Billboard> cloned_billboard = std::allocate_shared<
+                Billboard>(allocator);
+        cloned_billboard->set_mode(billboard->mode());
+        cloned_billboard->set_axis(billboard->axis());
+        clone->attachBillboard(clone, cloned_billboard);
+    }
+
+    std::shared_ptr<TriggerVolume> trigger_volume = source->trigger_volume();
+    if (trigger_volume) {
+        std::shared_ptr<TriggerVolume> cloned_trigger_volume =
+                std::allocate_shared<TriggerVolume>(allocator);
+        if (trigger_volume->shape() == TriggerVolume::SPHERE) {
+            cloned_trigger_volume->setSphere(trigger_volume->radius());
+        } else {
+            cloned_trigger_volume->setBox(trigger_volume->half_extents());
+        }
+        cloned_trigger_volume->set_center(trigger_volume->center());
+        clone->attachTriggerVolume(clone, cloned_trigger_volume);
+    }
+
+    for (SceneObject* child = source->first_child().get(); child != 0;
+            child = child->next_sibling().get()) {
+        clone->addChildObject(clone, cloneNode(child, allocator));
+    }
+    return clone;
+}
+
+std::shared_ptr<SceneObject> SceneObject::cloneHierarchy() const {
+    std::shared_ptr<MemoryBlock> block(
+            new MemoryBlock(
+                    getHierarchySize()
+                            * (sharedAllocationSize<SceneObject>()
+                                    + sharedAllocationSize<Transform>()
+                                    + sharedAllocationSize<RenderData>())));
+    return cloneNode(this, BlockAllocator<SceneObject>(block));
+}
+
 }
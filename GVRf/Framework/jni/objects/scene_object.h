@@ -26,65 +26,222 @@
 #include <memory>
 
 #include "objects/hybrid_object.h"
+#include "objects/components/component_registry.h"
 #include "objects/components/transform.h"
+#include "util/string_table.h"
 
 namespace gvr {
+class Billboard;
 class Camera;
 class CameraRig;
 class EyePointeeHolder;
 class RenderData;
+class Scene;
+class SceneObject;
+class TriggerVolume;
+
+/*
+ * Intrusive list threaded through the sibling links of its members, so
+ * appending and removing are O(1) and iteration follows insertion order.
+ * The list owns its members; an object belongs to at most one list.
+ */
+class SceneObjectList {
+public:
+    SceneObjectList() :
+            first_(), last_(0), size_(0) {
+    }
+
+    ~SceneObjectList() {
+        clear();
+    }
+
+    int size() const {
+        return size_;
+    }
+
+    const std::shared_ptr<SceneObject>& first() const {
+        return first_;
+    }
+
+    bool contains(const SceneObject* scene_object) const;
+    // first removes the object from the list it is in, if any
+    void pushBack(const std::shared_ptr<SceneObject>& scene_object);
+    void remove(SceneObject* scene_object);
+    void clear();
+
+    // walks the list
+    const std::shared_ptr<SceneObject>& at(int index) const;
+    std::vector<std::shared_ptr<SceneObject>> toVector() const;
+
+private:
+    SceneObjectList(const SceneObjectList& scene_object_list);
+    SceneObjectList(SceneObjectList&& scene_object_list);
+    SceneObjectList& operator=(const SceneObjectList& scene_object_list);
+    SceneObjectList& operator=(SceneObjectList&& scene_object_list);
+
+private:
+    std::shared_ptr<SceneObject> first_;
+    SceneObject* last_;
+    int size_;
+};
 
 class SceneObject: public HybridObject {
 public:
+    // active() and shouldUpdate() folded together, for per-frame callers
+    enum UpdateState {
+        INACTIVE = 0, SKIP_UPDATE = 1, UPDATE = 2
+    };
+
     SceneObject();
     ~SceneObject();
 
-    std::string name() const {
-        return name_;
+    int entity_id() const {
+        return entity_id_;
     }
 
-    void set_name(std::string name) {
-        name_ = name;
+    const std::string& name() const {
+        return StringTable::string(name_id());
+    }
+
+    int name_id() const {
+        return ComponentRegistry::name_id(entity_id_);
+    }
+
+    void set_name(const std::string& name);
+
+    const std::vector<int>& tag_ids() const {
+        return ComponentRegistry::tag_ids(entity_id_);
+    }
+
+    bool hasTag(int tag_id) const {
+        const std::vector<int>& tag_ids = this->tag_ids();
+        return std::find(tag_ids.begin(), tag_ids.end(), tag_id)
+                != tag_ids.end();
+    }
+
+    void addTag(const std::string& tag);
+    void removeTag(const std::string& tag);
+
+    template<class T>
+    void attachComponent(const std::shared_ptr<SceneObject>& self,
+            const std::shared_ptr<T>& component) {
+        if (ComponentRegistry::pool<T>().contains(entity_id_)) {
+            detachComponent<T>();
+        }
+        std::shared_ptr<SceneObject> owner_object(component->owner_object());
+        if (owner_object) {
+            owner_object->detachComponent<T>();
+        }
+        ComponentRegistry::attach<T>(entity_id_, component);
+        component->set_owner_object(self);
+        markDirty();
+    }
+
+    template<class T>
+    void detachComponent() {
+        std::shared_ptr<T> component = ComponentRegistry::get<T>(entity_id_);
+        if (component) {
+            component->removeOwnerObject();
+            ComponentRegistry::detach<T>(entity_id_);
+            markDirty();
+        }
+    }
+
+    template<class T>
+    std::shared_ptr<T> getComponent() const {
+        return ComponentRegistry::get<T>(entity_id_);
     }
 
     void attachTransform(const std::shared_ptr<SceneObject>& self,
             const std::shared_ptr<Transform>& transform);
     void detachTransform();
-
-    std::shared_ptr<Transform> transform() const {
-        return transform_;
-    }
+    std::shared_ptr<Transform> transform() const;
 
     void attachRenderData(const std::shared_ptr<SceneObject>& self,
             const std::shared_ptr<RenderData>& render_data);
     void detachRenderData();
-
-    std::shared_ptr<RenderData> render_data() const {
-        return render_data_;
-    }
+    std::shared_ptr<RenderData> render_data() const;
 
     void attachCamera(const std::shared_ptr<SceneObject>& self,
             const std::shared_ptr<Camera>& camera);
     void detachCamera();
-
-    std::shared_ptr<Camera> camera() const {
-        return camera_;
-    }
+    std::shared_ptr<Camera> camera() const;
 
     void attachCameraRig(const std::shared_ptr<SceneObject>& self,
             const std::shared_ptr<CameraRig>& camera_rig);
     void detachCameraRig();
-
-    std::shared_ptr<CameraRig> camera_rig() const {
-        return camera_rig_;
-    }
+    std::shared_ptr<CameraRig> camera_rig() const;
 
     void attachEyePointeeHolder(const std::shared_ptr<SceneObject>& self,
             const std::shared_ptr<EyePointeeHolder>& eye_pointee_holder);
     void detachEyePointeeHolder();
+    std::shared_ptr<EyePointeeHolder> eye_pointee_holder() const;
+
+    void attachBillboard(const std::shared_ptr<SceneObject>& self,
+            const std::shared_ptr<Billboard>& billboard);
+    void detachBillboard();
+    std::shared_ptr<Billboard> billboard() const;
+
+    void attachTriggerVolume(const std::shared_ptr<SceneObject>& self,
+            const std::shared_ptr<TriggerVolume>& trigger_volume);
+    void detachTriggerVolume();
+    std::shared_ptr<TriggerVolume> trigger_volume() const;
+
+    Scene* scene() const {
+        return ComponentRegistry::scene(entity_id_);
+    }
+
+    void setScene(Scene* scene);
+    void markDirty();
+
+    bool enabled() const {
+        return enabled_;
+    }
+
+    /*
+     * Disabling an object takes its whole subtree out of rendering, picking
+     * and transform updates until it is enabled again.
+     */
+    void set_enabled(bool enabled);
+
+    // enabled, and every ancestor enabled
+    bool active() const {
+        return ComponentRegistry::active(entity_id_);
+    }
+
+    // whether the object, or one of its descendants, passed the renderer's
+    // frustum test last frame
+    bool visible_last_frame() const {
+        return ComponentRegistry::visible_last_frame(entity_id_);
+    }
 
-    std::shared_ptr<EyePointeeHolder> eye_pointee_holder() const {
-        return eye_pointee_holder_;
+    // fraction of the viewport height the object covered last frame
+    float screen_size() const {
+        return ComponentRegistry::screen_size(entity_id_);
+    }
+
+    /*
+     * On by default: animations and billboards of an object that is small
+     * or out of view are updated less often. Objects whose updates matter
+     * to the game logic turn it off.
+     */
+    bool update_culling() const {
+        return ComponentRegistry::update_culling(entity_id_);
+    }
+
+    void set_update_culling(bool update_culling) {
+        ComponentRegistry::set_update_culling(entity_id_, update_culling);
+    }
+
+    bool shouldUpdate() const {
+        return ComponentRegistry::shouldUpdate(entity_id_);
+    }
+
+    UpdateState update_state() const {
+        if (!active()) {
+            return INACTIVE;
+        }
+        return shouldUpdate() ? UPDATE : SKIP_UPDATE;
     }
 
     std::shared_ptr<SceneObject> parent() const {
@@ -92,15 +249,36 @@ public:
     }
 
     std::vector<std::shared_ptr<SceneObject>> children() const {
-        return children_;
+        return children_.toVector();
     }
 
+    const std::shared_ptr<SceneObject>& first_child() const {
+        return children_.first();
+    }
+
+    const std::shared_ptr<SceneObject>& next_sibling() const {
+        return next_sibling_;
+    }
+
+    // the link owning this object, empty if it is neither a root nor a child
+    std::shared_ptr<SceneObject> shared_this() const;
+
     void addChildObject(std::shared_ptr<SceneObject> self,
             std::shared_ptr<SceneObject> child);
     void removeChildObject(std::shared_ptr<SceneObject> child);
     int getChildrenCount() const;
     const std::shared_ptr<SceneObject>& getChildByIndex(int index);
 
+    /*
+     * Copies the subtree with its transforms and render data out of one
+     * memory block. Meshes, materials and textures are shared with the
+     * source, and the cloned render data join the instance group of their
+     * source. Billboards and trigger volumes are cloned too; cameras, camera
+     * rigs and eye pointees are not.
+     */
+    std::shared_ptr<SceneObject> cloneHierarchy() const;
+    int getHierarchySize() const;
+
 private:
     SceneObject(const SceneObject& scene_object);
     SceneObject(SceneObject&& scene_object);
@@ -108,14 +286,21 @@ private:
     SceneObject& operator=(SceneObject&& scene_object);
 
 private:
-    std::string name_;
-    std::shared_ptr<Transform> transform_;
-    std::shared_ptr<RenderData> render_data_;
-    std::shared_ptr<Camera> camera_;
-    std::shared_ptr<CameraRig> camera_rig_;
-    std::shared_ptr<EyePointeeHolder> eye_pointee_holder_;
+    // refreshes the cached active bits of the subtree, skipping branches
+    // whose bit does not change
+    void updateActive();
+
+private:
+    friend class SceneObjectList;
+
+    int entity_id_;
+    bool enabled_;
     std::weak_ptr<SceneObject> parent_;
-    std::vector<std::shared_ptr<SceneObject>> children_;
+    SceneObjectList children_;
+    // links of the list holding this object
+    SceneObjectList* list_;
+    std::shared_ptr<SceneObject> next_sibling_;
+    SceneObject* prev_sibling_;
 };
 
 }
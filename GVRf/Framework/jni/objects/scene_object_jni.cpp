@@ -91,6 +91,24 @@ Java_org_gearvrf_NativeSceneObject_detachEyePointeeHolder(
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeSceneObject_getEyePointeeHolder(
         JNIEnv * env, jobject obj, jlong jscene_object);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_attachBillboard(
+        JNIEnv * env, jobject obj, jlong jscene_object, jlong jbillboard);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_detachBillboard(
+        JNIEnv * env, jobject obj, jlong jscene_object);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeSceneObject_getBillboard(
+        JNIEnv * env, jobject obj, jlong jscene_object);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_attachTriggerVolume(
+        JNIEnv * env, jobject obj, jlong jscene_object, jlong jtrigger_volume);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_detachTriggerVolume(
+        JNIEnv * env, jobject obj, jlong jscene_object);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeSceneObject_getTriggerVolume(
+        JNIEnv * env, jobject obj, jlong jscene_object);
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeSceneObject_getParent(JNIEnv * env,
         jobject obj, jlong jscene_object);
@@ -108,6 +126,51 @@ Java_org_gearvrf_NativeSceneObject_getChildrenCount(
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeSceneObject_getChildByIndex(JNIEnv * env,
         jobject obj, jlong jscene_object, jint index);
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeSceneObject_getChildren(JNIEnv * env,
+        jobject obj, jlong jscene_object);
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeSceneObject_cloneHierarchy(JNIEnv * env,
+        jobject obj, jlong jscene_object);
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneObject_isEnabled(JNIEnv * env,
+        jobject obj, jlong jscene_object);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_setEnable(JNIEnv * env,
+        jobject obj, jlong jscene_object, jboolean enable);
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneObject_isActive(JNIEnv * env,
+        jobject obj, jlong jscene_object);
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneObject_isVisibleLastFrame(JNIEnv * env,
+        jobject obj, jlong jscene_object);
+JNIEXPORT jfloat JNICALL
+Java_org_gearvrf_NativeSceneObject_getScreenSize(JNIEnv * env,
+        jobject obj, jlong jscene_object);
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneObject_getUpdateCulling(JNIEnv * env,
+        jobject obj, jlong jscene_object);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_setUpdateCulling(JNIEnv * env,
+        jobject obj, jlong jscene_object, jboolean update_culling);
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneObject_shouldUpdate(JNIEnv * env,
+        jobject obj, jlong jscene_object);
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeSceneObject_getUpdateState(JNIEnv * env,
+        jobject obj, jlong jscene_object);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_nextFrame(JNIEnv * env,
+        jobject obj);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_addTag(JNIEnv * env,
+        jobject obj, jlong jscene_object, jstring tag);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_removeTag(JNIEnv * env,
+        jobject obj, jlong jscene_object, jstring tag);
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneObject_hasTag(JNIEnv * env,
+        jobject obj, jlong jscene_object, jint tag_id);
 }
 ;
 
@@ -123,7 +186,7 @@ Java_org_gearvrf_NativeSceneObject_getName(JNIEnv * env,
         jobject obj, jlong jscene_object) {
     std::shared_ptr<SceneObject> scene_object =
             *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
-    std::string name = scene_object->name();
+    const std::string& name = scene_object->name();
     jstring jname = env->NewStringUTF(name.c_str());
     return jname;
 }
@@ -283,6 +346,66 @@ Java_org_gearvrf_NativeSceneObject_getEyePointeeHolder(
                     eye_pointee_holder));
 }
 
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_attachBillboard(
+        JNIEnv * env, jobject obj, jlong jscene_object, jlong jbillboard) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    std::shared_ptr<Billboard> billboard =
+            *reinterpret_cast<std::shared_ptr<Billboard>*>(jbillboard);
+    scene_object->attachBillboard(scene_object, billboard);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_detachBillboard(
+        JNIEnv * env, jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    scene_object->detachBillboard();
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeSceneObject_getBillboard(
+        JNIEnv * env, jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    std::shared_ptr<Billboard> billboard = scene_object->billboard();
+    return billboard.get() == NULL ?
+            0 :
+            reinterpret_cast<jlong>(new std::shared_ptr<Billboard>(billboard));
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_attachTriggerVolume(
+        JNIEnv * env, jobject obj, jlong jscene_object, jlong jtrigger_volume) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    std::shared_ptr<TriggerVolume> trigger_volume =
+            *reinterpret_cast<std::shared_ptr<TriggerVolume>*>(jtrigger_volume);
+    scene_object->attachTriggerVolume(scene_object, trigger_volume);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_detachTriggerVolume(
+        JNIEnv * env, jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    scene_object->detachTriggerVolume();
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeSceneObject_getTriggerVolume(
+        JNIEnv * env, jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    std::shared_ptr<TriggerVolume> trigger_volume =
+            scene_object->trigger_volume();
+    return trigger_volume.get() == NULL ?
+            0 :
+            reinterpret_cast<jlong>(new std::shared_ptr<TriggerVolume>(
+                    trigger_volume));
+}
+
 JNIEXPORT jlong JNICALL
 Java_org_gearvrf_NativeSceneObject_getParent(JNIEnv * env,
         jobject obj, jlong jscene_object) {
@@ -337,4 +460,140 @@ Java_org_gearvrf_NativeSceneObject_getChildByIndex(JNIEnv * env,
     }
 }
 
+JNIEXPORT jlongArray JNICALL
+Java_org_gearvrf_NativeSceneObject_getChildren(JNIEnv * env,
+        jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    std::vector<jlong> long_children;
+    long_children.reserve(scene_object->getChildrenCount());
+    for (const std::shared_ptr<SceneObject>* child =
+            &scene_object->first_child(); *child;
+            child = &(*child)->next_sibling()) {
+        long_children.push_back(
+                reinterpret_cast<jlong>(new std::shared_ptr<SceneObject>(
+                        *child)));
+    }
+    jlongArray jchildren = env->NewLongArray(long_children.size());
+    env->SetLongArrayRegion(jchildren, 0, long_children.size(),
+            long_children.data());
+    return jchildren;
+}
+
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeSceneObject_cloneHierarchy(JNIEnv * env,
+        jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    return reinterpret_cast<jlong>(new std::shared_ptr<SceneObject>(
+            scene_object->cloneHierarchy()));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneObject_isEnabled(JNIEnv * env,
+        jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    return static_cast<jboolean>(scene_object->enabled());
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_setEnable(JNIEnv * env,
+        jobject obj, jlong jscene_object, jboolean enable) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    scene_object->set_enabled(static_cast<bool>(enable));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneObject_isActive(JNIEnv * env,
+        jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    return static_cast<jboolean>(scene_object->active());
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneObject_isVisibleLastFrame(JNIEnv * env,
+        jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    return static_cast<jboolean>(scene_object->visible_last_frame());
+}
+
+JNIEXPORT jfloat JNICALL
+Java_org_gearvrf_NativeSceneObject_getScreenSize(JNIEnv * env,
+        jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    return scene_object->screen_size();
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneObject_getUpdateCulling(JNIEnv * env,
+        jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    return static_cast<jboolean>(scene_object->update_culling());
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_setUpdateCulling(JNIEnv * env,
+        jobject obj, jlong jscene_object, jboolean update_culling) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    scene_object->set_update_culling(static_cast<bool>(update_culling));
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneObject_shouldUpdate(JNIEnv * env,
+        jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    return static_cast<jboolean>(scene_object->shouldUpdate());
+}
+
+JNIEXPORT jint JNICALL
+Java_org_gearvrf_NativeSceneObject_getUpdateState(JNIEnv * env,
+        jobject obj, jlong jscene_object) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    return scene_object->update_state();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_nextFrame(JNIEnv * env,
+        jobject obj) {
+    ComponentRegistry::nextFrame();
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_addTag(JNIEnv * env,
+        jobject obj, jlong jscene_object, jstring tag) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    const char* native_tag = env->GetStringUTFChars(tag, 0);
+    scene_object->addTag(std::string(native_tag));
+    env->ReleaseStringUTFChars(tag, native_tag);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeSceneObject_removeTag(JNIEnv * env,
+        jobject obj, jlong jscene_object, jstring tag) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    const char* native_tag = env->GetStringUTFChars(tag, 0);
+    scene_object->removeTag(std::string(native_tag));
+    env->ReleaseStringUTFChars(tag, native_tag);
+}
+
+JNIEXPORT jboolean JNICALL
+Java_org_gearvrf_NativeSceneObject_hasTag(JNIEnv * env,
+        jobject obj, jlong jscene_object, jint tag_id) {
+    std::shared_ptr<SceneObject> scene_object =
+            *reinterpret_cast<std::shared_ptr<SceneObject>*>(jscene_object);
+    return static_cast<jboolean>(scene_object->hasTag(tag_id));
+}
+
 }
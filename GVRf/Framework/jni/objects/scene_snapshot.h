@@ -0,0 +1,135 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Immutable per-frame copy of a scene, safe to read from any thread.
+ ***************************************************************************/
+
+#ifndef SCENE_SNAPSHOT_H_
+#define SCENE_SNAPSHOT_H_
+
+#include <memory>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+namespace gvr {
+class Material;
+class Mesh;
+class PointCloud;
+class RenderData;
+
+/*
+ * Entries are grouped in fixed-size chunks indexed by entity id. Publishing
+ * a new snapshot clones only the chunks holding dirty entities and shares
+ * every other chunk with the previous snapshot.
+ */
+class SceneSnapshot {
+public:
+    static const int CHUNK_SIZE = 64;
+
+    struct Entry {
+        Entry() :
+                model_matrix(), render_data(), mesh(), material(), point_cloud(), parent(
+                        -1), render_mask(0), rendering_order(0), cull_test(
+                        true), offset(false), offset_factor(0.0f), offset_units(
+                        0.0f), depth_test(true), alpha_blend(true), line_width(
+                        1.0f), point_size(1.0f), frustum_culling(true), in_scene(
+                        false), active(false) {
+        }
+
+        glm::mat4 model_matrix;
+        std::shared_ptr<RenderData> render_data;
+        std::shared_ptr<Mesh> mesh;
+        std::shared_ptr<Material> material;
+        std::shared_ptr<PointCloud> point_cloud;
+        int parent;
+        int render_mask;
+        int rendering_order;
+        // draw state copied from render_data; the renderer reads these
+        // rather than the live component
+        bool cull_test;
+        bool offset;
+        float offset_factor;
+        float offset_units;
+        bool depth_test;
+        bool alpha_blend;
+        float line_width;
+        float point_size;
+        bool frustum_culling;
+        bool in_scene;
+        // false under a disabled object; such entries carry no matrix or
+        // render data
+        bool active;
+    };
+
+    struct Chunk {
+        Chunk() :
+                count(0) {
+        }
+
+        Entry entries[CHUNK_SIZE];
+        int count;
+    };
+
+    SceneSnapshot() :
+            chunks_(), frame_(0) {
+    }
+
+    SceneSnapshot(const SceneSnapshot& previous) :
+            chunks_(previous.chunks_), frame_(previous.frame_ + 1) {
+    }
+
+    ~SceneSnapshot() {
+    }
+
+    long long frame() const {
+        return frame_;
+    }
+
+    int chunk_count() const {
+        return chunks_.size();
+    }
+
+    // null when no entity of the chunk is in the scene
+    const Chunk* chunk(int index) const {
+        return chunks_[index].get();
+    }
+
+    bool contains(int entity) const {
+        int index = entity / CHUNK_SIZE;
+        return index < chunks_.size() && chunks_[index]
+                && chunks_[index]->entries[entity % CHUNK_SIZE].in_scene;
+    }
+
+    const Entry& entry(int entity) const {
+        return chunks_[entity / CHUNK_SIZE]->entries[entity % CHUNK_SIZE];
+    }
+
+private:
+    friend class Scene;
+
+    SceneSnapshot(SceneSnapshot&& snapshot);
+    SceneSnapshot& operator=(const SceneSnapshot& snapshot);
+    SceneSnapshot& operator=(SceneSnapshot&& snapshot);
+
+private:
+    std::vector<std::shared_ptr<const Chunk>> chunks_;
+    long long frame_;
+};
+
+}
+#endif
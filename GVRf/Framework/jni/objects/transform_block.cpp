@@ -0,0 +1,126 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Transforms shared with Java through direct buffers.
+ ***************************************************************************/
+
+#include "transform_block.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "glm/gtc/type_ptr.hpp"
+
+#include "objects/scene_object.h"
+#include "objects/components/transform.h"
+#include "util/gvr_log.h"
+
+namespace gvr {
+std::mutex TransformBlock::blocks_mutex_;
+std::vector<TransformBlock*> TransformBlock::blocks_;
+
+TransformBlock::TransformBlock(int capacity) :
+        HybridObject(), transforms_(capacity), written_versions_(capacity), poses_(
+                capacity * POSE_SIZE), matrices_(capacity * MATRIX_SIZE), dirty_words_(
+                (capacity + 3) / 4) {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    blocks_.push_back(this);
+}
+
+TransformBlock::~TransformBlock() {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    blocks_.erase(std::find(blocks_.begin(), blocks_.end(), this));
+}
+
+void TransformBlock::bind(int index,
+        const std::shared_ptr<Transform>& transform) {
+    if (!contains(index)) {
+        LOGE("TransformBlock::bind() : slot %d out of %d", index, capacity());
+        return;
+    }
+    transforms_[index] = transform;
+    // never equal to the version, so the slot is written back once
+    written_versions_[index] = transform->model_matrix_version() - 1;
+    float* pose = &poses_[index * POSE_SIZE];
+    pose[0] = transform->position_x();
+    pose[1] = transform->position_y();
+    pose[2] = transform->position_z();
+    pose[3] = transform->rotation_w();
+    pose[4] = transform->rotation_x();
+    pose[5] = transform->rotation_y();
+    pose[6] = transform->rotation_z();
+    pose[7] = transform->scale_x();
+    pose[8] = transform->scale_y();
+    pose[9] = transform->scale_z();
+    dirty_flags()[index] = 0;
+}
+
+void TransformBlock::unbind(int index) {
+    if (!contains(index)) {
+        LOGE("TransformBlock::unbind() : slot %d out of %d", index,
+                capacity());
+        return;
+    }
+    transforms_[index].reset();
+    dirty_flags()[index] = 0;
+}
+
+void TransformBlock::apply() {
+    unsigned char* dirty_flags = this->dirty_flags();
+    for (int word = 0; word < dirty_words_.size(); ++word) {
+        if (dirty_words_[word] == 0) {
+            continue;
+        }
+        int end = std::min(word * 4 + 4, capacity());
+        for (int i = word * 4; i < end; ++i) {
+            if (dirty_flags[i] != 0 && transforms_[i]) {
+                const float* pose = &poses_[i * POSE_SIZE];
+                transforms_[i]->set_position(pose[0], pose[1], pose[2]);
+                transforms_[i]->set_rotation(pose[3], pose[4], pose[5],
+                        pose[6]);
+                transforms_[i]->set_scale(pose[7], pose[8], pose[9]);
+            }
+        }
+        dirty_words_[word] = 0;
+    }
+
+    // matrices of disabled subtrees are left stale until they are enabled
+    for (int i = 0; i < transforms_.size(); ++i) {
+        if (!transforms_[i]
+                || transforms_[i]->model_matrix_version()
+                        == written_versions_[i]) {
+            continue;
+        }
+        std::shared_ptr<SceneObject> owner_object =
+                transforms_[i]->owner_object();
+        if (owner_object && owner_object->active()) {
+            glm::mat4 matrix = transforms_[i]->getModelMatrix();
+            memcpy(&matrices_[i * MATRIX_SIZE], glm::value_ptr(matrix),
+                    sizeof(matrix));
+            written_versions_[i] = transforms_[i]->model_matrix_version();
+        }
+    }
+}
+
+void TransformBlock::applyAll() {
+    std::lock_guard<std::mutex> lock(blocks_mutex_);
+    for (auto it = blocks_.begin(); it != blocks_.end(); ++it) {
+        (*it)->apply();
+    }
+}
+
+}
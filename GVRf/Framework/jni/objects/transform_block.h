@@ -0,0 +1,97 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Transforms shared with Java through direct buffers.
+ ***************************************************************************/
+
+#ifndef TRANSFORM_BLOCK_H_
+#define TRANSFORM_BLOCK_H_
+
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <vector>
+
+#include "objects/hybrid_object.h"
+
+namespace gvr {
+class Transform;
+
+/*
+ * Java writes the pose of a slot in place and sets its dirty byte; every
+ * block is applied once per frame with a single scan of the dirty bytes,
+ * after which the model matrices of the bound slots that changed are
+ * written back.
+ * Both sides must only touch the buffers from the GL thread.
+ */
+class TransformBlock: public HybridObject {
+public:
+    // position xyz, rotation wxyz, scale xyz
+    static const int POSE_SIZE = 10;
+    static const int MATRIX_SIZE = 16;
+
+    explicit TransformBlock(int capacity);
+    ~TransformBlock();
+
+    int capacity() const {
+        return transforms_.size();
+    }
+
+    float* poses() {
+        return poses_.data();
+    }
+
+    float* matrices() {
+        return matrices_.data();
+    }
+
+    unsigned char* dirty_flags() {
+        return reinterpret_cast<unsigned char*>(dirty_words_.data());
+    }
+
+    bool contains(int index) const {
+        return index >= 0 && index < transforms_.size();
+    }
+
+    // out-of-range slots are logged and ignored
+    void bind(int index, const std::shared_ptr<Transform>& transform);
+    void unbind(int index);
+    void apply();
+
+    static void applyAll();
+
+private:
+    TransformBlock(const TransformBlock& transform_block);
+    TransformBlock(TransformBlock&& transform_block);
+    TransformBlock& operator=(const TransformBlock& transform_block);
+    TransformBlock& operator=(TransformBlock&& transform_block);
+
+private:
+    std::vector<std::shared_ptr<Transform>> transforms_;
+    // model matrix version of each slot's transform when last written back
+    std::vector<unsigned int> written_versions_;
+    std::vector<float> poses_;
+    std::vector<float> matrices_;
+    // one byte per slot, scanned a word at a time
+    std::vector<uint32_t> dirty_words_;
+
+    static std::mutex blocks_mutex_;
+    static std::vector<TransformBlock*> blocks_;
+};
+
+}
+#endif
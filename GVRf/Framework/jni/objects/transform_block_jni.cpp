@@ -0,0 +1,111 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * JNI
+ ***************************************************************************/
+
+#include "transform_block.h"
+
+#include "objects/components/transform.h"
+#include "util/gvr_jni.h"
+
+namespace gvr {
+extern "C" {
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeTransformBlock_ctor(JNIEnv * env,
+        jobject obj, jint capacity);
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeTransformBlock_getPoses(JNIEnv * env,
+        jobject obj, jlong jtransform_block);
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeTransformBlock_getMatrices(JNIEnv * env,
+        jobject obj, jlong jtransform_block);
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeTransformBlock_getDirtyFlags(JNIEnv * env,
+        jobject obj, jlong jtransform_block);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTransformBlock_bind(JNIEnv * env,
+        jobject obj, jlong jtransform_block, jint index, jlong jtransform);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTransformBlock_unbind(JNIEnv * env,
+        jobject obj, jlong jtransform_block, jint index);
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTransformBlock_applyAll(JNIEnv * env,
+        jobject obj);
+}
+
+JNIEXPORT jlong JNICALL
+Java_org_gearvrf_NativeTransformBlock_ctor(JNIEnv * env,
+        jobject obj, jint capacity) {
+    return reinterpret_cast<jlong>(new std::shared_ptr<TransformBlock>(
+            new TransformBlock(capacity)));
+}
+
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeTransformBlock_getPoses(JNIEnv * env,
+        jobject obj, jlong jtransform_block) {
+    std::shared_ptr<TransformBlock> transform_block =
+            *reinterpret_cast<std::shared_ptr<TransformBlock>*>(jtransform_block);
+    return env->NewDirectByteBuffer(transform_block->poses(),
+            transform_block->capacity() * TransformBlock::POSE_SIZE
+                    * sizeof(float));
+}
+
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeTransformBlock_getMatrices(JNIEnv * env,
+        jobject obj, jlong jtransform_block) {
+    std::shared_ptr<TransformBlock> transform_block =
+            *reinterpret_cast<std::shared_ptr<TransformBlock>*>(jtransform_block);
+    return env->NewDirectByteBuffer(transform_block->matrices(),
+            transform_block->capacity() * TransformBlock::MATRIX_SIZE
+                    * sizeof(float));
+}
+
+JNIEXPORT jobject JNICALL
+Java_org_gearvrf_NativeTransformBlock_getDirtyFlags(JNIEnv * env,
+        jobject obj, jlong jtransform_block) {
+    std::shared_ptr<TransformBlock> transform_block =
+            *reinterpret_cast<std::shared_ptr<TransformBlock>*>(jtransform_block);
+    return env->NewDirectByteBuffer(transform_block->dirty_flags(),
+            transform_block->capacity());
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTransformBlock_bind(JNIEnv * env,
+        jobject obj, jlong jtransform_block, jint index, jlong jtransform) {
+    std::shared_ptr<TransformBlock> transform_block =
+            *reinterpret_cast<std::shared_ptr<TransformBlock>*>(jtransform_block);
+    std::shared_ptr<Transform> transform =
+            *reinterpret_cast<std::shared_ptr<Transform>*>(jtransform);
+    transform_block->bind(index, transform);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTransformBlock_unbind(JNIEnv * env,
+        jobject obj, jlong jtransform_block, jint index) {
+    std::shared_ptr<TransformBlock> transform_block =
+            *reinterpret_cast<std::shared_ptr<TransformBlock>*>(jtransform_block);
+    transform_block->unbind(index);
+}
+
+JNIEXPORT void JNICALL
+Java_org_gearvrf_NativeTransformBlock_applyAll(JNIEnv * env,
+        jobject obj) {
+    TransformBlock::applyAll();
+}
+
+}
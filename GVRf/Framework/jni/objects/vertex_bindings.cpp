@@ -0,0 +1,69 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/***************************************************************************
+ * The vertex attributes a shader program reads, and where from.
+ ***************************************************************************/
+
+#include "vertex_bindings.h"
+
+#include <map>
+#include <mutex>
+#include <sstream>
+
+namespace gvr {
+static std::mutex ids_mutex;
+// ids by the text of the bindings; there are about as many as programs
+static std::map<std::string, int> ids;
+
+void VertexBindings::add(GLuint location, SourceType type,
+        const std::string& key) {
+    if (location == static_cast<GLuint>(-1)) {
+        return;
+    }
+    Binding binding = { location, { type, key } };
+    id_ = 0;
+    for (auto it = bindings_.begin(); it != bindings_.end(); ++it) {
+        if (it->location == location) {
+            *it = binding;
+            return;
+        }
+        if (it->location > location) {
+            bindings_.insert(it, binding);
+            return;
+        }
+    }
+    bindings_.push_back(binding);
+}
+
+int VertexBindings::id() const {
+    if (id_ != 0) {
+        return id_;
+    }
+    // the bindings are kept sorted by location, so equal ones read alike
+    std::ostringstream text;
+    for (auto it = bindings_.begin(); it != bindings_.end(); ++it) {
+        text << it->location << ' ' << it->source.type << ' '
+                << it->source.key.size() << ' ' << it->source.key << ';';
+    }
+    std::lock_guard<std::mutex> lock(ids_mutex);
+    auto inserted = ids.insert(std::make_pair(text.str(), ids.size() + 1));
+    id_ = inserted.first->second;
+    return id_;
+}
+
+}
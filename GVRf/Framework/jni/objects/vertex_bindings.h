@@ -0,0 +1,90 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+
+/***************************************************************************
+ * The vertex attributes a shader program reads, and where from.
+ ***************************************************************************/
+
+#ifndef VERTEX_BINDINGS_H_
+#define VERTEX_BINDINGS_H_
+
+#include <string>
+#include <vector>
+
+#include "GLES3/gl3.h"
+
+namespace gvr {
+
+/*
+ * Built once per shader program, from its attribute locations, and handed
+ * to Mesh::generateVAO(), which keeps a vertex array object for each
+ * different set of bindings. Programs that bind the same mesh attributes
+ * to the same locations get the same id(), so they share vertex array
+ * objects.
+ */
+class VertexBindings {
+public:
+    // the built-in arrays of a mesh, or its vectors of a type by key
+    enum SourceType {
+        POSITION, NORMAL, TEX_COORD, FLOAT_VECTOR, VEC2_VECTOR, VEC3_VECTOR,
+        VEC4_VECTOR
+    };
+
+    struct Source {
+        SourceType type;
+        std::string key;
+
+        bool operator==(const Source& other) const {
+            return type == other.type && key == other.key;
+        }
+    };
+
+    struct Binding {
+        GLuint location;
+        Source source;
+    };
+
+    VertexBindings() :
+            bindings_(), id_(0) {
+    }
+
+    ~VertexBindings() {
+    }
+
+    // a location of -1, for an attribute the program does not have, is
+    // left out; binding a location again replaces its source
+    void add(GLuint location, SourceType type,
+            const std::string& key = std::string());
+
+    const std::vector<Binding>& bindings() const {
+        return bindings_;
+    }
+
+    bool empty() const {
+        return bindings_.empty();
+    }
+
+    // the same for the same bindings; worked out on first use after add()
+    int id() const;
+
+private:
+    std::vector<Binding> bindings_;
+    mutable int id_;
+};
+
+}
+#endif
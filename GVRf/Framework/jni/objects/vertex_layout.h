@@ -0,0 +1,141 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Where each vertex attribute of a mesh lives in its vertex buffers.
+ ***************************************************************************/
+
+#ifndef VERTEX_LAYOUT_H_
+#define VERTEX_LAYOUT_H_
+
+#include <vector>
+
+#include "GLES3/gl3.h"
+
+namespace gvr {
+
+/*
+ * An interleaved layout packs every attribute of a vertex next to each
+ * other, in the order they were added, so one buffer holds the whole mesh
+ * and a vertex is fetched with one read; the stride is rounded up to 4
+ * bytes. A separate layout gives each attribute its own tightly packed
+ * buffer. Attributes are known by the order they were added in; the
+ * location a program reads one from is given when it is applied.
+ */
+class VertexLayout {
+public:
+    struct Attribute {
+        GLint size;
+        GLenum type;
+        GLboolean normalized;
+        // bytes from the start of the vertex, or of the attribute's own
+        // buffer in a separate layout
+        int offset;
+    };
+
+    explicit VertexLayout(bool interleaved) :
+            interleaved_(interleaved), attributes_(), stride_(0) {
+    }
+
+    ~VertexLayout() {
+    }
+
+    bool interleaved() const {
+        return interleaved_;
+    }
+
+    const std::vector<Attribute>& attributes() const {
+        return attributes_;
+    }
+
+    // bytes between two vertices of an interleaved buffer; 0 otherwise
+    int stride() const {
+        return stride_;
+    }
+
+    void add(GLint size, GLenum type = GL_FLOAT,
+            GLboolean normalized = GL_FALSE) {
+        Attribute attribute;
+        attribute.size = size;
+        attribute.type = type;
+        attribute.normalized = normalized;
+        attribute.offset = 0;
+        if (interleaved_) {
+            attribute.offset = stride_;
+            stride_ = (stride_ + attributeSize(size, type) + 3) & ~3;
+        }
+        attributes_.push_back(attribute);
+    }
+
+    // enables an attribute at location in the vertex array object being
+    // set up, reading it from buffer: the interleaved one, or the
+    // attribute's own
+    void apply(int attribute, GLuint location, GLuint buffer) const {
+        const Attribute& applied = attributes_[attribute];
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glEnableVertexAttribArray(location);
+        glVertexAttribPointer(location, applied.size, applied.type,
+                applied.normalized, stride_,
+                reinterpret_cast<const GLvoid*>(applied.offset));
+    }
+
+    bool operator==(const VertexLayout& other) const {
+        if (interleaved_ != other.interleaved_
+                || attributes_.size() != other.attributes_.size()) {
+            return false;
+        }
+        for (int i = 0; i < attributes_.size(); ++i) {
+            const Attribute& a = attributes_[i];
+            const Attribute& b = other.attributes_[i];
+            if (a.size != b.size || a.type != b.type
+                    || a.normalized != b.normalized || a.offset != b.offset) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // bytes of one vertex of an attribute
+    static int attributeSize(GLint size, GLenum type) {
+        if (type == GL_INT_2_10_10_10_REV
+                || type == GL_UNSIGNED_INT_2_10_10_10_REV) {
+            return 4;
+        }
+        return size * typeSize(type);
+    }
+
+    static int typeSize(GLenum type) {
+        switch (type) {
+        case GL_BYTE:
+        case GL_UNSIGNED_BYTE:
+            return 1;
+        case GL_SHORT:
+        case GL_UNSIGNED_SHORT:
+        case GL_HALF_FLOAT:
+            return 2;
+        default:
+            return 4;
+        }
+    }
+
+private:
+    bool interleaved_;
+    std::vector<Attribute> attributes_;
+    int stride_;
+};
+
+}
+#endif
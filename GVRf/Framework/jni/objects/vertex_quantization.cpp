@@ -0,0 +1,164 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * The compressed vertex format of a quantized mesh.
+ ***************************************************************************/
+
+#include "vertex_quantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "glm/gtc/matrix_transform.hpp"
+#include "glm/gtc/packing.hpp"
+
+namespace gvr {
+// keeps flat meshes from dividing by zero
+static const float MIN_POSITION_SCALE = 1e-20f;
+
+// as GLES3 converts normalized attributes to floats
+static GLshort packSnorm16(float value) {
+    return static_cast<GLshort>(floorf(
+            glm::clamp(value, -1.0f, 1.0f) * 32767.0f + 0.5f));
+}
+
+static float unpackSnorm16(GLshort value) {
+    return std::max(value / 32767.0f, -1.0f);
+}
+
+static GLushort packUnorm16(float value) {
+    return static_cast<GLushort>(floorf(
+            glm::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f));
+}
+
+static float unpackUnorm16(GLushort value) {
+    return value / 65535.0f;
+}
+
+VertexQuantization::VertexQuantization() :
+        position_offset_(), position_scale_(1.0f), dequantization_matrix_(), unorm_tex_coords_(
+                true), position_error_(0.0f), normal_error_(0.0f), tex_coord_error_(
+                0.0f) {
+}
+
+void VertexQuantization::analyze(const std::vector<glm::vec3>& vertices,
+        const std::vector<glm::vec3>& normals,
+        const std::vector<glm::vec2>& tex_coords) {
+    glm::vec3 min(std::numeric_limits<float>::infinity());
+    glm::vec3 max(-std::numeric_limits<float>::infinity());
+    for (auto it = vertices.begin(); it != vertices.end(); ++it) {
+        min = glm::min(min, *it);
+        max = glm::max(max, *it);
+    }
+    if (vertices.empty()) {
+        min = max = glm::vec3();
+    }
+    position_offset_ = (min + max) * 0.5f;
+    position_scale_ = glm::max((max - min) * 0.5f,
+            glm::vec3(MIN_POSITION_SCALE));
+    dequantization_matrix_ = glm::scale(
+            glm::translate(glm::mat4(), position_offset_), position_scale_);
+
+    unorm_tex_coords_ = true;
+    for (auto it = tex_coords.begin(); it != tex_coords.end(); ++it) {
+        if (it->x < 0.0f || it->x > 1.0f || it->y < 0.0f || it->y > 1.0f) {
+            unorm_tex_coords_ = false;
+            break;
+        }
+    }
+
+    position_error_ = 0.0f;
+    for (auto it = vertices.begin(); it != vertices.end(); ++it) {
+        GLshort encoded[4];
+        encodePosition(*it, encoded);
+        glm::vec3 error = glm::abs(decodePosition(encoded) - *it);
+        position_error_ = std::max(position_error_,
+                std::max(std::max(error.x, error.y), error.z));
+    }
+    float min_cosine = 1.0f;
+    for (auto it = normals.begin(); it != normals.end(); ++it) {
+        float length = glm::length(*it);
+        if (length > 0.0f) {
+            glm::vec3 decoded = decodeNormal(encodeNormal(*it));
+            float decoded_length = glm::length(decoded);
+            if (decoded_length > 0.0f) {
+                min_cosine = std::min(min_cosine,
+                        glm::dot(*it, decoded) / (length * decoded_length));
+            }
+        }
+    }
+    normal_error_ = glm::degrees(acosf(std::max(-1.0f, min_cosine)));
+    tex_coord_error_ = 0.0f;
+    for (auto it = tex_coords.begin(); it != tex_coords.end(); ++it) {
+        GLushort encoded[2];
+        encodeTexCoord(*it, encoded);
+        glm::vec2 error = glm::abs(decodeTexCoord(encoded) - *it);
+        tex_coord_error_ = std::max(tex_coord_error_,
+                std::max(error.x, error.y));
+    }
+}
+
+void VertexQuantization::encodePosition(const glm::vec3& position,
+        GLshort* encoded) const {
+    glm::vec3 normalized = (position - position_offset_) / position_scale_;
+    for (int i = 0; i < 3; ++i) {
+        encoded[i] = packSnorm16(normalized[i]);
+    }
+    encoded[3] = 32767;
+}
+
+GLuint VertexQuantization::encodeNormal(const glm::vec3& normal) {
+    float length = glm::length(normal);
+    glm::vec3 unit = length > 0.0f ? normal / length : normal;
+    return glm::packSnorm3x10_1x2(glm::vec4(unit, 0.0f));
+}
+
+void VertexQuantization::encodeTexCoord(const glm::vec2& tex_coord,
+        GLushort* encoded) const {
+    for (int i = 0; i < 2; ++i) {
+        encoded[i] =
+                unorm_tex_coords_ ?
+                        packUnorm16(tex_coord[i]) :
+                        glm::packHalf1x16(tex_coord[i]);
+    }
+}
+
+glm::vec3 VertexQuantization::decodePosition(const GLshort* encoded) const {
+    glm::vec3 normalized;
+    for (int i = 0; i < 3; ++i) {
+        normalized[i] = unpackSnorm16(encoded[i]);
+    }
+    return position_offset_ + normalized * position_scale_;
+}
+
+glm::vec3 VertexQuantization::decodeNormal(GLuint encoded) {
+    return glm::vec3(glm::unpackSnorm3x10_1x2(encoded));
+}
+
+glm::vec2 VertexQuantization::decodeTexCoord(const GLushort* encoded) const {
+    glm::vec2 tex_coord;
+    for (int i = 0; i < 2; ++i) {
+        tex_coord[i] =
+                unorm_tex_coords_ ?
+                        unpackUnorm16(encoded[i]) :
+                        glm::unpackHalf1x16(encoded[i]);
+    }
+    return tex_coord;
+}
+
+}
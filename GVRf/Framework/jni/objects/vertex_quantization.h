@@ -0,0 +1,98 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * The compressed vertex format of a quantized mesh.
+ ***************************************************************************/
+
+#ifndef VERTEX_QUANTIZATION_H_
+#define VERTEX_QUANTIZATION_H_
+
+#include <vector>
+
+#include "GLES3/gl3.h"
+#include "glm/glm.hpp"
+
+namespace gvr {
+
+/*
+ * Every part of the format is decoded by the vertex fetch, so shaders read
+ * the attributes as floats, as before:
+ * - positions are normalized 16-bit ints over the bounding box; the box
+ *   center and half size are folded into the model-view-projection matrix;
+ * - normals are packed 10:10:10:2 (GL_INT_2_10_10_10_REV);
+ * - texture coordinates are normalized unsigned 16-bit ints when all of
+ *   them are within [0, 1], and half floats otherwise.
+ * A vertex takes 8 + 4 + 4 bytes instead of 12 + 12 + 8.
+ */
+class VertexQuantization {
+public:
+    VertexQuantization();
+
+    ~VertexQuantization() {
+    }
+
+    // fits the format to the data and measures its error bounds
+    void analyze(const std::vector<glm::vec3>& vertices,
+            const std::vector<glm::vec3>& normals,
+            const std::vector<glm::vec2>& tex_coords);
+
+    const glm::mat4& dequantization_matrix() const {
+        return dequantization_matrix_;
+    }
+
+    GLenum tex_coord_type() const {
+        return unorm_tex_coords_ ? GL_UNSIGNED_SHORT : GL_HALF_FLOAT;
+    }
+
+    // largest error of a coordinate, in mesh units
+    float position_error() const {
+        return position_error_;
+    }
+
+    // largest angle between a normal and its decoded value, in degrees
+    float normal_error() const {
+        return normal_error_;
+    }
+
+    float tex_coord_error() const {
+        return tex_coord_error_;
+    }
+
+    // four components, the last 1, as GL_SHORT normalized
+    void encodePosition(const glm::vec3& position, GLshort* encoded) const;
+    // as GL_INT_2_10_10_10_REV normalized
+    static GLuint encodeNormal(const glm::vec3& normal);
+    // as tex_coord_type(), normalized if unsigned short
+    void encodeTexCoord(const glm::vec2& tex_coord, GLushort* encoded) const;
+
+private:
+    glm::vec3 decodePosition(const GLshort* encoded) const;
+    static glm::vec3 decodeNormal(GLuint encoded);
+    glm::vec2 decodeTexCoord(const GLushort* encoded) const;
+
+private:
+    glm::vec3 position_offset_;
+    glm::vec3 position_scale_;
+    glm::mat4 dequantization_matrix_;
+    bool unorm_tex_coords_;
+    float position_error_;
+    float normal_error_;
+    float tex_coord_error_;
+};
+
+}
+#endif
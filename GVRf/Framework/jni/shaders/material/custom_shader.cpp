@@ -31,13 +31,17 @@ namespace gvr {
 CustomShader::CustomShader(std::string vertex_shader,
         std::string fragment_shader) :
         program_(0), a_position_(0), a_normal_(0), a_tex_coord_(0), u_mvp_(0), u_right_(
-                0), texture_keys_(), attribute_float_keys_(), attribute_vec2_keys_(), attribute_vec3_keys_(), attribute_vec4_keys_(), uniform_float_keys_(), uniform_vec2_keys_(), uniform_vec3_keys_(), uniform_vec4_keys_(), uniform_mat4_keys_() {
+                0), u_point_size_(0), texture_keys_(), attribute_float_keys_(), attribute_vec2_keys_(), attribute_vec3_keys_(), attribute_vec4_keys_(), bindings_(), uniform_float_keys_(), uniform_vec2_keys_(), uniform_vec3_keys_(), uniform_vec4_keys_(), uniform_mat4_keys_() {
     program_ = new GLProgram(vertex_shader.c_str(), fragment_shader.c_str());
     a_position_ = glGetAttribLocation(program_->id(), "a_position");
     a_normal_ = glGetAttribLocation(program_->id(), "a_normal");
     a_tex_coord_ = glGetAttribLocation(program_->id(), "a_tex_coord");
+    bindings_.add(a_position_, VertexBindings::POSITION);
+    bindings_.add(a_normal_, VertexBindings::NORMAL);
+    bindings_.add(a_tex_coord_, VertexBindings::TEX_COORD);
     u_mvp_ = glGetUniformLocation(program_->id(), "u_mvp");
     u_right_ = glGetUniformLocation(program_->id(), "u_right");
+    u_point_size_ = glGetUniformLocation(program_->id(), "u_point_size");
 }
 
 CustomShader::~CustomShader() {
@@ -60,24 +64,28 @@ void CustomShader::addAttributeFloatKey(std::string variable_name,
         std::string key) {
     int location = glGetAttribLocation(program_->id(), variable_name.c_str());
     attribute_float_keys_[location] = key;
+    bindings_.add(location, VertexBindings::FLOAT_VECTOR, key);
 }
 
 void CustomShader::addAttributeVec2Key(std::string variable_name,
         std::string key) {
     int location = glGetAttribLocation(program_->id(), variable_name.c_str());
     attribute_vec2_keys_[location] = key;
+    bindings_.add(location, VertexBindings::VEC2_VECTOR, key);
 }
 
 void CustomShader::addAttributeVec3Key(std::string variable_name,
         std::string key) {
     int location = glGetAttribLocation(program_->id(), variable_name.c_str());
     attribute_vec3_keys_[location] = key;
+    bindings_.add(location, VertexBindings::VEC3_VECTOR, key);
 }
 
 void CustomShader::addAttributeVec4Key(std::string variable_name,
         std::string key) {
     int location = glGetAttribLocation(program_->id(), variable_name.c_str());
     attribute_vec4_keys_[location] = key;
+    bindings_.add(location, VertexBindings::VEC4_VECTOR, key);
 }
 
 void CustomShader::addUniformFloatKey(std::string variable_name,
@@ -111,53 +119,18 @@ void CustomShader::addUniformMat4Key(std::string variable_name,
 }
 
 void CustomShader::render(const glm::mat4& mvp_matrix,
-        std::shared_ptr<RenderData> render_data, bool right) {
-    std::shared_ptr<Mesh> mesh = render_data->mesh();
+        const SceneSnapshot::Entry& entry, bool right) {
+    std::shared_ptr<Mesh> mesh = entry.mesh;
 
 #if _GVRF_USE_GLES3_
     glUseProgram(program_->id());
 
-    if(a_position_ != -1)
-    {
-        mesh->setVertexLoc(a_position_);
-    }
-
-    if(a_normal_ != -1)
-    {
-        mesh->setNormalLoc(a_normal_);
-    }
-
-    if(a_tex_coord_ != -1)
-    {
-        mesh->setTexCoordLoc(a_tex_coord_);
-    }
-
-    for(auto it = attribute_float_keys_.begin(); it != attribute_float_keys_.end(); ++it)
-    {
-        mesh->setVertexAttribLocF(it->first, it->second);
-    }
-
-    for(auto it = attribute_vec2_keys_.begin(); it != attribute_vec2_keys_.end(); ++it)
-    {
-        mesh->setVertexAttribLocV2(it->first, it->second);
-    }
-
-    for(auto it = attribute_vec3_keys_.begin(); it != attribute_vec3_keys_.end(); ++it)
-    {
-        mesh->setVertexAttribLocV3(it->first, it->second);
-    }
-
-    for(auto it = attribute_vec4_keys_.begin(); it != attribute_vec4_keys_.end(); ++it)
-    {
-        mesh->setVertexAttribLocV4(it->first, it->second);
-    }
-
-    mesh->generateVAO();  // setup VAO
+    mesh->generateVAO(bindings_);
 
     ///////////// uniform /////////
     for(auto it = uniform_float_keys_.begin(); it != uniform_float_keys_.end(); ++it)
     {
-        glUniform1f(it->first, render_data->material()->getFloat(it->second));
+        glUniform1f(it->first, entry.material->getFloat(it->second));
     }
 
     if(u_mvp_ != -1)
@@ -168,42 +141,46 @@ void CustomShader::render(const glm::mat4& mvp_matrix,
     {
         glUniform1i(u_right_, right ? 1 : 0);
     }
+    if(u_point_size_ != -1)
+    {
+        glUniform1f(u_point_size_, entry.point_size);
+    }
 
     int texture_index = 0;
     for(auto it = texture_keys_.begin(); it != texture_keys_.end(); ++it)
     {
         glActiveTexture(getGLTexture(texture_index));
-        std::shared_ptr<Texture> texture = render_data->material()->getTexture(it->second);
+        std::shared_ptr<Texture> texture = entry.material->getTexture(it->second);
         glBindTexture(texture->getTarget(), texture->getId());
         glUniform1i(it->first, texture_index++);
     }
 
     for(auto it = uniform_vec2_keys_.begin(); it != uniform_vec2_keys_.end(); ++it)
     {
-        glm::vec2 v = render_data->material()->getVec2(it->second);
+        glm::vec2 v = entry.material->getVec2(it->second);
         glUniform2f(it->first, v.x, v.y);
     }
 
     for(auto it = uniform_vec3_keys_.begin(); it != uniform_vec3_keys_.end(); ++it)
     {
-        glm::vec3 v = render_data->material()->getVec3(it->second);
+        glm::vec3 v = entry.material->getVec3(it->second);
         glUniform3f(it->first, v.x, v.y, v.z);
     }
 
     for(auto it = uniform_vec4_keys_.begin(); it != uniform_vec4_keys_.end(); ++it)
     {
-        glm::vec4 v = render_data->material()->getVec4(it->second);
+        glm::vec4 v = entry.material->getVec4(it->second);
         glUniform4f(it->first, v.x, v.y, v.z, v.w);
     }
 
     for(auto it = uniform_mat4_keys_.begin(); it != uniform_mat4_keys_.end(); ++it)
     {
-        glm::mat4 m = render_data->material()->getMat4(it->second);
+        glm::mat4 m = entry.material->getMat4(it->second);
         glUniformMatrix4fv(it->first, 1, GL_FALSE, glm::value_ptr(m));
     }
 
     glBindVertexArray(mesh->getVAOId());
-    glDrawElements(GL_TRIANGLES, mesh->triangles().size(), GL_UNSIGNED_SHORT, 0);
+    mesh->drawElements();
     glBindVertexArray(0);
 #else
     glUseProgram(program_->id());
@@ -233,12 +210,15 @@ void CustomShader::render(const glm::mat4& mvp_matrix,
     if (u_right_ != 0) {
         glUniform1i(u_right_, right ? 1 : 0);
     }
+    if (u_point_size_ != -1) {
+        glUniform1f(u_point_size_, entry.point_size);
+    }
 
     int texture_index = 0;
 
     for (auto it = texture_keys_.begin(); it != texture_keys_.end(); ++it) {
         glActiveTexture(getGLTexture(texture_index));
-        std::shared_ptr<Texture> texture = render_data->material()->getTexture(
+        std::shared_ptr<Texture> texture = entry.material->getTexture(
                 it->second);
         glBindTexture(texture->getTarget(), texture->getId());
         glUniform1i(it->first, texture_index++);
@@ -274,35 +254,34 @@ void CustomShader::render(const glm::mat4& mvp_matrix,
 
     for (auto it = uniform_float_keys_.begin(); it != uniform_float_keys_.end();
             ++it) {
-        glUniform1f(it->first, render_data->material()->getFloat(it->second));
+        glUniform1f(it->first, entry.material->getFloat(it->second));
     }
 
     for (auto it = uniform_vec2_keys_.begin(); it != uniform_vec2_keys_.end();
             ++it) {
-        glm::vec2 v = render_data->material()->getVec2(it->second);
+        glm::vec2 v = entry.material->getVec2(it->second);
         glUniform2f(it->first, v.x, v.y);
     }
 
     for (auto it = uniform_vec3_keys_.begin(); it != uniform_vec3_keys_.end();
             ++it) {
-        glm::vec3 v = render_data->material()->getVec3(it->second);
+        glm::vec3 v = entry.material->getVec3(it->second);
         glUniform3f(it->first, v.x, v.y, v.z);
     }
 
     for (auto it = uniform_vec4_keys_.begin(); it != uniform_vec4_keys_.end();
             ++it) {
-        glm::vec4 v = render_data->material()->getVec4(it->second);
+        glm::vec4 v = entry.material->getVec4(it->second);
         glUniform4f(it->first, v.x, v.y, v.z, v.w);
     }
 
     for (auto it = uniform_mat4_keys_.begin(); it != uniform_mat4_keys_.end();
             ++it) {
-        glm::mat4 m = render_data->material()->getMat4(it->second);
+        glm::mat4 m = entry.material->getMat4(it->second);
         glUniformMatrix4fv(it->first, 1, GL_FALSE, glm::value_ptr(m));
     }
 
-    glDrawElements(GL_TRIANGLES, mesh->triangles().size(), GL_UNSIGNED_SHORT,
-            mesh->triangles().data());
+    mesh->drawElements();
 #endif
 
     checkGlError("CustomShader::render");
@@ -31,11 +31,12 @@
 
 #include "objects/eye_type.h"
 #include "objects/recyclable_object.h"
+#include "objects/scene_snapshot.h"
+#include "objects/vertex_bindings.h"
 
 namespace gvr {
 
 class GLProgram;
-class RenderData;
 
 class CustomShader: public RecyclableObject {
 public:
@@ -54,7 +55,7 @@ public:
     void addUniformVec4Key(std::string variable_name, std::string key);
     void addUniformMat4Key(std::string variable_name, std::string key);
     void render(const glm::mat4& mvp_matrix,
-            std::shared_ptr<RenderData> render_data, bool right);
+            const SceneSnapshot::Entry& entry, bool right);
     static int getGLTexture(int n);
 
 private:
@@ -70,11 +71,13 @@ private:
     GLuint a_tex_coord_;
     GLuint u_mvp_;
     GLuint u_right_;
+    GLuint u_point_size_;
     std::map<int, std::string> texture_keys_;
     std::map<int, std::string> attribute_float_keys_;
     std::map<int, std::string> attribute_vec2_keys_;
     std::map<int, std::string> attribute_vec3_keys_;
     std::map<int, std::string> attribute_vec4_keys_;
+    VertexBindings bindings_;
     std::map<int, std::string> uniform_float_keys_;
     std::map<int, std::string> uniform_vec2_keys_;
     std::map<int, std::string> uniform_vec3_keys_;
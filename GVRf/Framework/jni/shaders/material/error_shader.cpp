@@ -41,9 +41,10 @@ static const char FRAGMENT_SHADER[] = "precision highp float;\n"
         "}\n";
 
 ErrorShader::ErrorShader() :
-        program_(0), a_position_(0), u_mvp_(0), u_color_(0) {
+        program_(0), a_position_(0), bindings_(), u_mvp_(0), u_color_(0) {
     program_ = new GLProgram(VERTEX_SHADER, FRAGMENT_SHADER);
     a_position_ = glGetAttribLocation(program_->id(), "a_position");
+    bindings_.add(a_position_, VertexBindings::POSITION);
     u_mvp_ = glGetUniformLocation(program_->id(), "u_mvp");
     u_color_ = glGetUniformLocation(program_->id(), "u_color");
 }
@@ -60,16 +61,15 @@ void ErrorShader::recycle() {
 }
 
 void ErrorShader::render(const glm::mat4& mvp_matrix,
-        std::shared_ptr<RenderData> render_data) {
-    std::shared_ptr<Mesh> mesh = render_data->mesh();
+        const SceneSnapshot::Entry& entry) {
+    std::shared_ptr<Mesh> mesh = entry.mesh;
     float r = 0.0f;
     float g = 1.0f;
     float b = 0.0f;
     float a = 1.0f;
 
 #if _GVRF_USE_GLES3_
-    mesh->setVertexLoc(a_position_);
-    mesh->generateVAO();
+    mesh->generateVAO(bindings_);
 
     glUseProgram(program_->id());
 
@@ -77,7 +77,7 @@ void ErrorShader::render(const glm::mat4& mvp_matrix,
     glUniform4f(u_color_, r, g, b, a);
 
     glBindVertexArray(mesh->getVAOId());
-    glDrawElements(GL_TRIANGLES, mesh->triangles().size(), GL_UNSIGNED_SHORT, 0);
+    mesh->drawElements();
     glBindVertexArray(0);
 #else
     glUseProgram(program_->id());
@@ -90,8 +90,7 @@ void ErrorShader::render(const glm::mat4& mvp_matrix,
 
     glUniform4f(u_color_, r, g, b, a);
 
-    glDrawElements(GL_TRIANGLES, mesh->triangles().size(), GL_UNSIGNED_SHORT,
-            mesh->triangles().data());
+    mesh->drawElements();
 #endif
     checkGlError("ErrorShader::render");
 }
@@ -28,11 +28,12 @@
 #include "glm/gtc/type_ptr.hpp"
 
 #include "objects/recyclable_object.h"
+#include "objects/scene_snapshot.h"
+#include "objects/vertex_bindings.h"
 
 namespace gvr {
 class Color;
 class GLProgram;
-class RenderData;
 
 class ErrorShader: public RecyclableObject {
 public:
@@ -40,7 +41,7 @@ public:
     ~ErrorShader();
     void recycle();
     void render(const glm::mat4& mvp_matrix,
-            std::shared_ptr<RenderData> render_data);
+            const SceneSnapshot::Entry& entry);
 
 private:
     ErrorShader(const ErrorShader& error_shader);
@@ -51,6 +52,7 @@ private:
 private:
     GLProgram* program_;
     GLuint a_position_;
+    VertexBindings bindings_;
     GLuint u_mvp_;
     GLuint u_color_;
 };
@@ -32,10 +32,11 @@
 
 #include "objects/eye_type.h"
 #include "objects/recyclable_object.h"
+#include "objects/scene_snapshot.h"
+#include "objects/vertex_bindings.h"
 
 namespace gvr {
 class GLProgram;
-class RenderData;
 
 class OESHorizontalStereoShader: public RecyclableObject {
 public:
@@ -43,7 +44,7 @@ public:
     ~OESHorizontalStereoShader();
     void recycle();
     void render(const glm::mat4& mvp_matrix,
-            std::shared_ptr<RenderData> render_data, bool right);
+            const SceneSnapshot::Entry& entry, bool right);
 
 private:
     OESHorizontalStereoShader(
@@ -59,6 +60,7 @@ private:
     GLProgram* program_;
     GLuint a_position_;
     GLuint a_tex_coord_;
+    VertexBindings bindings_;
     GLuint u_mvp_;
     GLuint u_texture_;
     GLuint u_color_;
@@ -50,11 +50,13 @@ static const char FRAGMENT_SHADER[] =
                 "}\n";
 
 OESShader::OESShader() :
-        program_(0), a_position_(0), a_tex_coord_(0), u_mvp_(0), u_texture_(0), u_color_(
+        program_(0), a_position_(0), a_tex_coord_(0), bindings_(), u_mvp_(0), u_texture_(0), u_color_(
                 0), u_opacity_(0) {
     program_ = new GLProgram(VERTEX_SHADER, FRAGMENT_SHADER);
     a_position_ = glGetAttribLocation(program_->id(), "a_position");
     a_tex_coord_ = glGetAttribLocation(program_->id(), "a_tex_coord");
+    bindings_.add(a_position_, VertexBindings::POSITION);
+    bindings_.add(a_tex_coord_, VertexBindings::TEX_COORD);
     u_mvp_ = glGetUniformLocation(program_->id(), "u_mvp");
     u_texture_ = glGetUniformLocation(program_->id(), "u_texture");
     u_color_ = glGetUniformLocation(program_->id(), "u_color");
@@ -73,12 +75,12 @@ void OESShader::recycle() {
 }
 
 void OESShader::render(const glm::mat4& mvp_matrix,
-        std::shared_ptr<RenderData> render_data) {
-    std::shared_ptr<Mesh> mesh = render_data->mesh();
-    std::shared_ptr<Texture> texture = render_data->material()->getTexture(
+        const SceneSnapshot::Entry& entry) {
+    std::shared_ptr<Mesh> mesh = entry.mesh;
+    std::shared_ptr<Texture> texture = entry.material->getTexture(
             "main_texture");
-    glm::vec3 color = render_data->material()->getVec3("color");
-    float opacity = render_data->material()->getFloat("opacity");
+    glm::vec3 color = entry.material->getVec3("color");
+    float opacity = entry.material->getFloat("opacity");
 
     if (texture->getTarget() != GL_TEXTURE_EXTERNAL_OES) {
         std::string error = "OESShader::render : texture with wrong target";
@@ -86,9 +88,7 @@ void OESShader::render(const glm::mat4& mvp_matrix,
     }
 
 #if _GVRF_USE_GLES3_
-    mesh->setVertexLoc(a_position_);
-    mesh->setTexCoordLoc(a_tex_coord_);
-    mesh->generateVAO();
+    mesh->generateVAO(bindings_);
 
     glUseProgram(program_->id());
 
@@ -100,7 +100,7 @@ void OESShader::render(const glm::mat4& mvp_matrix,
     glUniform1f(u_opacity_, opacity);
 
     glBindVertexArray(mesh->getVAOId());
-    glDrawElements(GL_TRIANGLES, mesh->triangles().size(), GL_UNSIGNED_SHORT, 0);
+    mesh->drawElements();
     glBindVertexArray(0);
 #else
 
@@ -124,8 +124,7 @@ void OESShader::render(const glm::mat4& mvp_matrix,
 
     glUniform1f(u_opacity_, opacity);
 
-    glDrawElements(GL_TRIANGLES, mesh->triangles().size(), GL_UNSIGNED_SHORT,
-            mesh->triangles().data());
+    mesh->drawElements();
 #endif
     checkGlError("OESShader::render");
 }
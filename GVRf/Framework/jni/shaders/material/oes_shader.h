@@ -30,10 +30,11 @@
 #include "glm/gtc/type_ptr.hpp"
 
 #include "objects/recyclable_object.h"
+#include "objects/scene_snapshot.h"
+#include "objects/vertex_bindings.h"
 
 namespace gvr {
 class GLProgram;
-class RenderData;
 
 class OESShader: public RecyclableObject {
 public:
@@ -41,7 +42,7 @@ public:
     ~OESShader();
     void recycle();
     void render(const glm::mat4& mvp_matrix,
-            std::shared_ptr<RenderData> render_data);
+            const SceneSnapshot::Entry& entry);
 
 private:
     OESShader(const OESShader& oes_shader);
@@ -53,6 +54,7 @@ private:
     GLProgram* program_;
     GLuint a_position_;
     GLuint a_tex_coord_;
+    VertexBindings bindings_;
     GLuint u_mvp_;
     GLuint u_texture_;
     GLuint u_color_;
@@ -0,0 +1,148 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Bump allocator for creating many shared objects at once.
+ ***************************************************************************/
+
+#ifndef BLOCK_ALLOCATOR_H_
+#define BLOCK_ALLOCATOR_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace gvr {
+
+/*
+ * One contiguous allocation carved up front to back. Memory is never
+ * returned to the block; the block is freed when the last allocator
+ * referring to it goes away. Not thread safe while allocating.
+ */
+class MemoryBlock {
+public:
+    explicit MemoryBlock(size_t capacity) :
+            data_(static_cast<char*>(::operator new(capacity))), capacity_(
+                    capacity), used_(0) {
+    }
+
+    ~MemoryBlock() {
+        ::operator delete(data_);
+    }
+
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    size_t used() const {
+        return used_;
+    }
+
+    // falls back to the heap once the block is full
+    void* allocate(size_t size, size_t alignment) {
+        size_t offset = (used_ + alignment - 1) & ~(alignment - 1);
+        if (offset + size > capacity_) {
+            return ::operator new(size);
+        }
+        used_ = offset + size;
+        return data_ + offset;
+    }
+
+    void deallocate(void* pointer) {
+        if (!owns(pointer)) {
+            ::operator delete(pointer);
+        }
+    }
+
+    bool owns(const void* pointer) const {
+        const char* address = static_cast<const char*>(pointer);
+        return address >= data_ && address < data_ + capacity_;
+    }
+
+private:
+    MemoryBlock(const MemoryBlock& memory_block);
+    MemoryBlock(MemoryBlock&& memory_block);
+    MemoryBlock& operator=(const MemoryBlock& memory_block);
+    MemoryBlock& operator=(MemoryBlock&& memory_block);
+
+private:
+    char* data_;
+    size_t capacity_;
+    size_t used_;
+};
+
+/*
+ * For std::allocate_shared. Each control block keeps a copy of the
+ * allocator, so the memory block outlives every object placed in it.
+ */
+template<class T>
+class BlockAllocator {
+public:
+    typedef T value_type;
+
+    template<class U>
+    struct rebind {
+        typedef BlockAllocator<U> other;
+    };
+
+    explicit BlockAllocator(const std::shared_ptr<MemoryBlock>& block) :
+            block_(block) {
+    }
+
+    template<class U>
+    BlockAllocator(const BlockAllocator<U>& other) :
+            block_(other.block()) {
+    }
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(block_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* pointer, size_t n) {
+        block_->deallocate(pointer);
+    }
+
+    const std::shared_ptr<MemoryBlock>& block() const {
+        return block_;
+    }
+
+private:
+    std::shared_ptr<MemoryBlock> block_;
+};
+
+template<class T, class U>
+inline bool operator==(const BlockAllocator<T>& a, const BlockAllocator<U>& b) {
+    return a.block() == b.block();
+}
+
+template<class T, class U>
+inline bool operator!=(const BlockAllocator<T>& a, const BlockAllocator<U>& b) {
+    return a.block() != b.block();
+}
+
+/*
+ * What one std::allocate_shared<T> takes from a block: the object, and a
+ * control block holding a vtable pointer, both counts and a copy of the
+ * allocator, padded to the object's alignment. Use it to size blocks.
+ */
+template<class T>
+inline size_t sharedAllocationSize() {
+    return sizeof(T) + sizeof(void*) + 2 * sizeof(int)
+            + sizeof(BlockAllocator<T>) + alignof(T);
+}
+
+}
+#endif
@@ -0,0 +1,57 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Interns strings as small integer ids.
+ ***************************************************************************/
+
+#include "string_table.h"
+
+namespace gvr {
+std::mutex StringTable::mutex_;
+std::unordered_map<std::string, int> StringTable::ids_;
+std::deque<std::string> StringTable::strings_(1);
+
+int StringTable::intern(const std::string& string) {
+    if (string.empty()) {
+        return EMPTY;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(string);
+    if (it != ids_.end()) {
+        return it->second;
+    }
+    int id = strings_.size();
+    strings_.push_back(string);
+    ids_[string] = id;
+    return id;
+}
+
+int StringTable::find(const std::string& string) {
+    if (string.empty()) {
+        return EMPTY;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = ids_.find(string);
+    return it != ids_.end() ? it->second : EMPTY;
+}
+
+const std::string& StringTable::string(int id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return strings_[id];
+}
+
+}
@@ -0,0 +1,65 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+/***************************************************************************
+ * Interns strings as small integer ids.
+ ***************************************************************************/
+
+#ifndef STRING_TABLE_H_
+#define STRING_TABLE_H_
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace gvr {
+
+/*
+ * Ids are dense, start at 1 and are never recycled; 0 is the empty string.
+ * Comparing ids replaces comparing strings, and an id can be resolved once
+ * and reused for every later lookup.
+ */
+class StringTable {
+private:
+    StringTable();
+
+public:
+    static const int EMPTY = 0;
+
+    // adds the string if it is not in the table yet
+    static int intern(const std::string& string);
+
+    // returns EMPTY if the string has never been interned
+    static int find(const std::string& string);
+
+    static const std::string& string(int id);
+
+private:
+    StringTable(const StringTable& string_table);
+    StringTable(StringTable&& string_table);
+    StringTable& operator=(const StringTable& string_table);
+    StringTable& operator=(StringTable&& string_table);
+
+private:
+    static std::mutex mutex_;
+    static std::unordered_map<std::string, int> ids_;
+    // a deque so references to the strings stay valid as it grows
+    static std::deque<std::string> strings_;
+};
+
+}
+#endif
@@ -45,18 +45,47 @@ class GVRAssimpImporter extends GVRHybridObject {
     /**
      * Retrieves a specific mesh from the imported 3D model.
      * 
+     * <p>
+     * Meshes with the same content are shared, so changes to the mesh are
+     * seen wherever else it is used.
+     * 
      * @param index
      *            Index of the mesh to get
      * @return The mesh, encapsulated as a {@link GVRMesh}.
+     * @see GVRMesh#getSharingStatistics()
      */
     GVRMesh getMesh(int index) {
         return GVRMesh.factory(getGVRContext(),
                 NativeAssimpImporter.getMesh(getPtr(), index));
     }
+
+    /**
+     * Retrieves a specific mesh from the imported 3D model, simplified to
+     * levels of detail as by {@link GVRMesh#generateLods(float[], float[])}.
+     * 
+     * @param index
+     *            Index of the mesh to get
+     * @param ratios
+     *            The share of the triangles each level keeps, from 0 to 1.
+     * @param errors
+     *            Receives the geometric error of each level, in mesh units.
+     * @return The levels, in the order of {@code ratios}.
+     */
+    GVRMesh[] getMeshLods(int index, float[] ratios, float[] errors) {
+        long[] ptrs = NativeAssimpImporter.getMeshLods(getPtr(), index,
+                ratios, errors);
+        GVRMesh[] lods = new GVRMesh[ptrs.length];
+        for (int i = 0; i < ptrs.length; ++i) {
+            lods[i] = new GVRMesh(getGVRContext(), ptrs[i]);
+        }
+        return lods;
+    }
 }
 
 class NativeAssimpImporter {
     static native int getNumberOfMeshes(long assimpImporter);
     static native long loadScene(long assimpImporter, Bitmap defaultBitmap, GVRContext gvrContext);
     static native long getMesh(long assimpImporter, int index);
+    static native long[] getMeshLods(long assimpImporter, int index,
+            float[] ratios, float[] errors);
 }
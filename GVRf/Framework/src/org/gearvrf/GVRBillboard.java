@@ -0,0 +1,107 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+/**
+ * Keeps its {@linkplain GVRSceneObject owner object} facing the main
+ * {@link GVRCameraRig} of the scene.
+ * 
+ * The owner's +z axis is turned toward the position of the camera rig once
+ * per frame, right after {@link GVRScript#onStep()}, so both eyes see the
+ * same rotation; the rotation of its {@link GVRTransform} is overwritten.
+ * All billboards are evaluated natively in one batch, so labels and sprites
+ * need no per-frame Java code.
+ */
+public class GVRBillboard extends GVRComponent {
+    /** Turns freely to face the camera. */
+    public static final int SPHERICAL = 0;
+    /**
+     * Only spins around the {@linkplain #setAxis(float, float, float) axis},
+     * like a tree sprite.
+     */
+    public static final int AXIS_LOCKED = 1;
+
+    /**
+     * Constructs a spherical billboard.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     */
+    public GVRBillboard(GVRContext gvrContext) {
+        super(gvrContext, NativeBillboard.ctor());
+    }
+
+    private GVRBillboard(GVRContext gvrContext, long ptr) {
+        super(gvrContext, ptr);
+    }
+
+    static GVRBillboard factory(GVRContext gvrContext, long ptr) {
+        GVRHybridObject wrapper = wrapper(ptr);
+        return wrapper == null ? new GVRBillboard(gvrContext, ptr)
+                : (GVRBillboard) wrapper;
+    }
+
+    @Override
+    protected final boolean registerWrapper() {
+        return true;
+    }
+
+    /**
+     * @return {@link #SPHERICAL} or {@link #AXIS_LOCKED}.
+     */
+    public int getMode() {
+        return NativeBillboard.getMode(getPtr());
+    }
+
+    /**
+     * @param mode
+     *            {@link #SPHERICAL} or {@link #AXIS_LOCKED}.
+     */
+    public void setMode(int mode) {
+        NativeBillboard.setMode(getPtr(), mode);
+    }
+
+    /**
+     * Sets the axis an {@link #AXIS_LOCKED} billboard spins around, in world
+     * space. The default is +y.
+     * 
+     * @param x
+     *            X of the axis.
+     * @param y
+     *            Y of the axis.
+     * @param z
+     *            Z of the axis.
+     */
+    public void setAxis(float x, float y, float z) {
+        NativeBillboard.setAxis(getPtr(), x, y, z);
+    }
+
+    static void updateAll(GVRScene scene) {
+        NativeBillboard.updateAll(scene.getPtr());
+    }
+}
+
+class NativeBillboard {
+    public static native long ctor();
+
+    public static native int getMode(long billboard);
+
+    public static native void setMode(long billboard, int mode);
+
+    public static native void setAxis(long billboard, float x, float y, float z);
+
+    public static native void updateAll(long scene);
+}
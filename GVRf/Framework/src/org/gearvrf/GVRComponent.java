@@ -34,8 +34,39 @@ class GVRComponent extends GVRHybridObject {
         return ptr == 0 ? null : GVRSceneObject.factory(getGVRContext(),
                 NativeComponent.getOwnerObject(getPtr()));
     }
+
+    /**
+     * @return {@code false} if the owner object, or one of its ancestors, is
+     *         disabled.
+     */
+    public boolean isActive() {
+        return NativeComponent.isActive(getPtr());
+    }
+
+    /**
+     * @return {@code false} if updates of the owner object may be skipped
+     *         this frame; see {@link GVRSceneObject#shouldUpdate()}.
+     */
+    public boolean shouldUpdate() {
+        return NativeComponent.shouldUpdate(getPtr());
+    }
+
+    /**
+     * @return The {@linkplain GVRSceneObject#getUpdateState() update state}
+     *         of the owner object; {@link GVRSceneObject#UPDATE_NOW} if there
+     *         is none.
+     */
+    public int getUpdateState() {
+        return NativeComponent.getUpdateState(getPtr());
+    }
 }
 
 class NativeComponent {
     public static native long getOwnerObject(long component);
+
+    public static native boolean isActive(long component);
+
+    public static native boolean shouldUpdate(long component);
+
+    public static native int getUpdateState(long component);
 }
@@ -26,6 +26,47 @@ import static org.gearvrf.utility.Preconditions.*;
  * A GL mesh is a net of triangles that define an object's surface geometry.
  */
 public class GVRMesh extends GVRHybridObject {
+    /**
+     * How often the vertices of a mesh change after it is first drawn.
+     */
+    public abstract static class GVRMeshUsage {
+        /** Changes are rare; the GPU buffers are filled again on each. */
+        public static final int STATIC = 0;
+        /** Changes now and then; only the changed vertices are uploaded. */
+        public static final int DYNAMIC = 1;
+        /** Changes about every frame; only the changed vertices are uploaded. */
+        public static final int STREAM = 2;
+    }
+
+    /**
+     * What a mesh keeps in memory once its GPU buffers are filled. Only
+     * {@linkplain GVRMeshUsage#STATIC static} meshes release their data.
+     */
+    public abstract static class GVRMeshResidency {
+        /** Keeps all of the data; the default. */
+        public static final int KEEP = 0;
+        /** Keeps none of the data: the mesh can be drawn, not picked. */
+        public static final int RELEASE = 1;
+        /** Keeps only positions and triangles, for picking. */
+        public static final int PICKING = 2;
+    }
+
+    /**
+     * What the triangles array of a mesh describes. Only
+     * {@link GVRPrimitiveType#TRIANGLES} can be picked, clustered,
+     * simplified or optimized for overdraw.
+     */
+    public abstract static class GVRPrimitiveType {
+        /** Three indices per triangle; the default. */
+        public static final int TRIANGLES = 0;
+        /** Two indices per line. */
+        public static final int LINES = 1;
+        /** Lines joining the indexed vertices in order. */
+        public static final int LINE_STRIP = 2;
+        /** One point per index. */
+        public static final int POINTS = 3;
+    }
+
     public GVRMesh(GVRContext gvrContext) {
         super(gvrContext, NativeMesh.ctor());
     }
@@ -73,6 +114,28 @@ public class GVRMesh extends GVRHybridObject {
         NativeMesh.setVertices(getPtr(), vertices);
     }
 
+    /**
+     * Replaces some of the vertices of the mesh, packed as in
+     * {@link #setVertices(float[])}. Only these vertices are uploaded to the
+     * GPU again, so a {@linkplain #setUsage(int) dynamic} mesh can be edited
+     * every frame.
+     * 
+     * @param firstVertex
+     *            Index of the first vertex to replace.
+     * @param vertices
+     *            Array containing the packed vertex data.
+     * @throws IllegalArgumentException
+     *             if the vertices do not fit in the mesh.
+     */
+    public void updateVertices(int firstVertex, float[] vertices) {
+        checkValidFloatArray("vertices", vertices, 3);
+        if (!NativeMesh.updateVertices(getPtr(), firstVertex, vertices)) {
+            throw Exceptions.IllegalArgument(
+                    "%d vertices from %d do not fit in the mesh",
+                    vertices.length / 3, firstVertex);
+        }
+    }
+
     /**
      * Get the normal vectors of the mesh. Each normal vector is represented as
      * a packed {@code float} triplet:
@@ -158,6 +221,32 @@ public class GVRMesh extends GVRHybridObject {
         NativeMesh.setTriangles(getPtr(), triangles);
     }
 
+    /**
+     * Get the triangle vertex indices of the mesh as {@code int}s, packed as
+     * in {@link #getTriangles()}. Unlike {@code getTriangles()}, this returns
+     * indices of meshes with more than 65536 vertices unchanged.
+     * 
+     * @return Array with the packed triangle index data.
+     */
+    public int[] getIndices() {
+        return NativeMesh.getIndices(getPtr());
+    }
+
+    /**
+     * Sets the triangle vertex indices of the mesh as {@code int}s, packed as
+     * in {@link #setTriangles(char[])}. The mesh is drawn with the smallest
+     * index type that addresses all of its vertices: bytes, shorts or, for
+     * meshes with more than 65536 vertices, ints.
+     * 
+     * @param indices
+     *            Array containing the packed triangle index data.
+     */
+    public void setIndices(int[] indices) {
+        checkNotNull("indices", indices);
+        checkDivisibleDataLength("indices", indices.length, 3);
+        NativeMesh.setIndices(getPtr(), indices);
+    }
+
     /**
      * Get the array of {@code float} scalars bound to the shader attribute
      * {@code key}.
@@ -283,6 +372,265 @@ public class GVRMesh extends GVRHybridObject {
         return new GVRMesh(getGVRContext(), NativeMesh.getBoundingBox(getPtr()));
     }
 
+    /**
+     * Reads the axis-aligned bounds of the mesh without allocating. They are
+     * cached, and computed again only after the vertices change.
+     * 
+     * @param bounds
+     *            Receives {@code minX, minY, minZ, maxX, maxY, maxZ}.
+     */
+    public void getBounds(float[] bounds) {
+        checkNotNull("bounds", bounds);
+        if (bounds.length < 6) {
+            throw Exceptions.IllegalArgument("bounds needs 6 elements");
+        }
+        NativeMesh.getBounds(getPtr(), bounds);
+    }
+
+    /**
+     * Reads a sphere around the mesh without allocating. It is centered on
+     * the {@linkplain #getBounds(float[]) bounds}, and cached with them.
+     * 
+     * @param sphere
+     *            Receives {@code centerX, centerY, centerZ, radius}.
+     */
+    public void getBoundingSphere(float[] sphere) {
+        checkNotNull("sphere", sphere);
+        if (sphere.length < 4) {
+            throw Exceptions.IllegalArgument("sphere needs 4 elements");
+        }
+        NativeMesh.getBoundingSphere(getPtr(), sphere);
+    }
+
+    /**
+     * Tells the engine how often the mesh will change, so that vertex data
+     * set after the first draw is uploaded the cheapest way. The default is
+     * {@link GVRMeshUsage#STATIC}.
+     * 
+     * @param usage
+     *            One of the {@link GVRMeshUsage} constants.
+     */
+    public void setUsage(int usage) {
+        NativeMesh.setUsage(getPtr(), usage);
+    }
+
+    /**
+     * Lets the mesh free its data once it has been uploaded to the GPU,
+     * which roughly halves the memory taken by large models. A released
+     * mesh is still drawn; {@link #getVertices()} and the other getters
+     * return what is left, and the data comes back only by
+     * {@link #reload(GVRMesh, boolean)}. Ignored on GLES2, which draws from
+     * the data.
+     * 
+     * @param residency
+     *            One of the {@link GVRMeshResidency} constants.
+     * @param pickingRatio
+     *            With {@link GVRMeshResidency#PICKING}, the share of the
+     *            triangles kept for picking, from 0 to 1; fewer triangles
+     *            are cheaper to keep and to pick, but less exact.
+     */
+    public void setResidency(int residency, float pickingRatio) {
+        NativeMesh.setResidency(getPtr(), residency, pickingRatio);
+    }
+
+    /**
+     * @return Whether the mesh has released its data, as set by
+     *         {@link #setResidency(int, float)}.
+     */
+    public boolean isReleased() {
+        return NativeMesh.isReleased(getPtr());
+    }
+
+    /**
+     * Gives a released mesh its data back, from a mesh loaded again from
+     * the same source, and uploads it again. Everything drawing this mesh
+     * keeps doing so.
+     * 
+     * @param source
+     *            The mesh to copy the data of.
+     * @param contextLost
+     *            {@code true} after the GL context was lost, so the mesh
+     *            forgets its GPU buffers instead of deleting them.
+     */
+    public void reload(GVRMesh source, boolean contextLost) {
+        checkNotNull("source", source);
+        NativeMesh.reload(getPtr(), source.getPtr(), contextLost);
+    }
+
+    /**
+     * @return One of the {@link GVRPrimitiveType} constants.
+     */
+    public int getPrimitiveType() {
+        return NativeMesh.getPrimitiveType(getPtr());
+    }
+
+    /**
+     * Set what the indices of {@link #setTriangles(char[])} describe, for
+     * point clouds and line drawings. Points are drawn with the size a
+     * custom shader gives {@code gl_PointSize}, see
+     * {@link GVRRenderData#setPointSize(float)}; lines with the width of
+     * {@link GVRRenderData#setLineWidth(float)}.
+     * 
+     * @param primitiveType
+     *            One of the {@link GVRPrimitiveType} constants.
+     */
+    public void setPrimitiveType(int primitiveType) {
+        NativeMesh.setPrimitiveType(getPtr(), primitiveType);
+    }
+
+    /**
+     * Builds a wireframe of the mesh, to draw over it: a
+     * {@link GVRPrimitiveType#LINES} mesh with the same vertices and every
+     * edge of the triangles once.
+     * 
+     * @return A new {@link GVRMesh}.
+     */
+    public GVRMesh getWireframe() {
+        if (getPrimitiveType() != GVRPrimitiveType.TRIANGLES) {
+            throw Exceptions.IllegalArgument(
+                    "Only a mesh of triangles has a wireframe");
+        }
+        return new GVRMesh(getGVRContext(), NativeMesh.getWireframe(getPtr()));
+    }
+
+    /**
+     * Choose how the mesh is laid out in GPU memory. By default all the
+     * attributes of a vertex are packed next to each other in one buffer,
+     * which is friendlier to the vertex fetch cache; {@code false} puts each
+     * attribute in a buffer of its own.
+     * 
+     * @param interleaved
+     *            {@code false} for one buffer per attribute.
+     */
+    public void setInterleaved(boolean interleaved) {
+        NativeMesh.setInterleaved(getPtr(), interleaved);
+    }
+
+    /**
+     * Reorders the triangles and vertices of the mesh so the GPU transforms
+     * fewer vertices and shades fewer hidden pixels. The mesh looks the
+     * same; only {@link #getTriangles()} and the vertex order change. Meshes
+     * loaded with {@link GVRContext#loadMesh(GVRAndroidResource)} or
+     * imported as scenes are already optimized.
+     * 
+     * @param overdrawThreshold
+     *            How much vertex cache efficiency, as a ratio, may be traded
+     *            for less overdraw; {@code 1.05f} is a good default.
+     */
+    public void optimize(float overdrawThreshold) {
+        NativeMesh.optimize(getPtr(), overdrawThreshold);
+    }
+
+    /**
+     * Same as {@link #optimize(float)} with an overdraw threshold of
+     * {@code 1.05f}.
+     */
+    public void optimize() {
+        optimize(1.05f);
+    }
+
+    /**
+     * Generates levels of detail by collapsing the edges whose removal
+     * changes the surface least. Borders and texture seams are kept. Each
+     * level is simplified on its own worker thread; the call returns once
+     * all are done, so call it at load time rather than while rendering.
+     * 
+     * @param ratios
+     *            The share of the triangles each level keeps, from 0 to 1.
+     * @param errors
+     *            Receives the geometric error of each level, in mesh units:
+     *            how far its surface may be from this mesh's. Switch to a
+     *            level once its error projects to less than a pixel or so.
+     *            Needs {@code ratios.length} elements.
+     * @return The levels, in the order of {@code ratios}.
+     */
+    public GVRMesh[] generateLods(float[] ratios, float[] errors) {
+        checkNotNull("ratios", ratios);
+        checkNotNull("errors", errors);
+        if (errors.length < ratios.length) {
+            throw Exceptions.IllegalArgument(
+                    "errors needs %d elements", ratios.length);
+        }
+        long[] ptrs = NativeMesh.generateLods(getPtr(), ratios, errors);
+        GVRMesh[] lods = new GVRMesh[ptrs.length];
+        for (int i = 0; i < ptrs.length; ++i) {
+            lods[i] = new GVRMesh(getGVRContext(), ptrs[i]);
+        }
+        return lods;
+    }
+
+    /**
+     * Measures how well the triangle order uses a FIFO post-transform vertex
+     * cache.
+     * 
+     * @param cacheSize
+     *            Number of vertices the simulated cache holds.
+     * @return The average cache miss ratio (ACMR), transformed vertices per
+     *         triangle, and the average transform to vertex ratio (ATVR),
+     *         transformed vertices per vertex.
+     */
+    public float[] getVertexCacheStatistics(int cacheSize) {
+        return NativeMesh.getVertexCacheStatistics(getPtr(), cacheSize);
+    }
+
+    /**
+     * Choose a compressed vertex format for the GPU copy of the mesh: 16-bit
+     * positions scaled to the mesh bounds, 10-bit normals and 16-bit texture
+     * coordinates. It roughly halves vertex memory and bandwidth, and every
+     * shader, including {@link GVRCustomMaterialShaderId custom} ones,
+     * still reads floats. The mesh's own data is not changed.
+     * 
+     * @param quantized
+     *            {@code true} for the compressed format; {@code false}, the
+     *            default, for floats.
+     * @see #getQuantizationErrors()
+     */
+    public void setQuantized(boolean quantized) {
+        NativeMesh.setQuantized(getPtr(), quantized);
+    }
+
+    /**
+     * The largest errors the compressed vertex format introduces for this
+     * mesh, whether or not it is {@linkplain #setQuantized(boolean) in use}.
+     * 
+     * @return The largest position error in mesh units, the largest normal
+     *         error in degrees and the largest texture coordinate error.
+     */
+    public float[] getQuantizationErrors() {
+        return NativeMesh.getQuantizationErrors(getPtr());
+    }
+
+    /**
+     * Splits the triangles into clusters of about a hundred, each culled
+     * on its own against the view frustum and, when the mesh's
+     * {@linkplain GVRRenderData#setCullTest(boolean) back faces are
+     * culled}, by the directions its triangles face. Only the visible
+     * clusters are drawn. Worth it for large meshes seen a part at a time,
+     * such as terrain and building shells; best after {@link #optimize()},
+     * whose triangle order gives compact clusters.
+     * 
+     * @param clustered
+     *            {@code true} to cull clusters; {@code false}, the default,
+     *            to draw the mesh whole.
+     */
+    public void setClustered(boolean clustered) {
+        NativeMesh.setClustered(getPtr(), clustered);
+    }
+
+    /**
+     * How much imported models share: meshes with the same content, from
+     * other nodes of a model or other imports, are loaded once and drawn
+     * from the same GPU buffers.
+     * 
+     * @return The number of imported meshes alive, the number of imports
+     *         answered with one of them, and the bytes of vertex and index
+     *         data those imports did not duplicate, in memory and again in
+     *         GPU buffers.
+     */
+    public static long[] getSharingStatistics() {
+        return NativeMesh.getSharingStatistics();
+    }
+
     private void checkValidFloatVector(String keyName, String key,
             String vectorName, float[] vector, int expectedComponents) {
         checkStringNotNullOrEmpty(keyName, key);
@@ -331,6 +679,10 @@ class NativeMesh {
 
     public static native void setTriangles(long mesh, char[] triangles);
 
+    public static native int[] getIndices(long mesh);
+
+    public static native void setIndices(long mesh, int[] indices);
+
     public static native float[] getFloatVector(long mesh, String key);
 
     public static native void setFloatVector(long mesh, String key,
@@ -352,4 +704,45 @@ class NativeMesh {
             float[] vec4Vector);
 
     public static native long getBoundingBox(long mesh);
+
+    public static native void getBounds(long mesh, float[] bounds);
+
+    public static native void getBoundingSphere(long mesh, float[] sphere);
+
+    public static native void setInterleaved(long mesh, boolean interleaved);
+
+    public static native void optimize(long mesh, float overdrawThreshold);
+
+    public static native long[] generateLods(long mesh, float[] ratios,
+            float[] errors);
+
+    public static native void setClustered(long mesh, boolean clustered);
+
+    public static native long[] getSharingStatistics();
+
+    public static native void setResidency(long mesh, int residency,
+            float pickingRatio);
+
+    public static native boolean isReleased(long mesh);
+
+    public static native void reload(long mesh, long source,
+            boolean contextLost);
+
+    public static native int getPrimitiveType(long mesh);
+
+    public static native void setPrimitiveType(long mesh, int primitiveType);
+
+    public static native long getWireframe(long mesh);
+
+    public static native float[] getVertexCacheStatistics(long mesh,
+            int cacheSize);
+
+    public static native void setQuantized(long mesh, boolean quantized);
+
+    public static native void setUsage(long mesh, int usage);
+
+    public static native boolean updateVertices(long mesh, int firstVertex,
+            float[] vertices);
+
+    public static native float[] getQuantizationErrors(long mesh);
 }
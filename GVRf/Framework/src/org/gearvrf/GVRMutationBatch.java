@@ -0,0 +1,240 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.charset.Charset;
+import java.util.ArrayList;
+import java.util.List;
+
+/**
+ * Records scene graph edits and submits them to the GL thread in one call.
+ * 
+ * Edits made through a batch are not applied immediately: {@link #submit()}
+ * hands the whole batch to a lock-free native queue, and the GL thread
+ * applies every submitted batch, in submission order, once per frame right
+ * after {@link GVRScript#onStep()}. Any thread may submit, which makes it
+ * safe to build scene graphs in the background. A single batch must not be
+ * shared between threads.
+ */
+public class GVRMutationBatch {
+    private static final int ADD_SCENE_OBJECT = 1;
+    private static final int REMOVE_SCENE_OBJECT = 2;
+    private static final int ADD_CHILD_OBJECT = 3;
+    private static final int REMOVE_CHILD_OBJECT = 4;
+    private static final int ATTACH_TRANSFORM = 5;
+    private static final int ATTACH_RENDER_DATA = 6;
+    private static final int SET_POSITION = 7;
+    private static final int SET_ROTATION = 8;
+    private static final int SET_SCALE = 9;
+    private static final int SET_MESH = 10;
+    private static final int SET_MATERIAL = 11;
+    private static final int SET_TEXTURE = 12;
+    private static final int SET_FLOAT = 13;
+    private static final int SET_VEC2 = 14;
+    private static final int SET_VEC3 = 15;
+    private static final int SET_VEC4 = 16;
+    private static final int SET_ENABLED = 17;
+
+    private static final Charset UTF8 = Charset.forName("UTF-8");
+
+    private ByteBuffer mBuffer;
+    // keeps the wrappers, and so the native objects, alive until submit
+    private final List<GVRHybridObject> mObjects = new ArrayList<GVRHybridObject>();
+
+    public GVRMutationBatch() {
+        this(1024);
+    }
+
+    /**
+     * @param capacity
+     *            Initial size of the command buffer, in bytes.
+     */
+    public GVRMutationBatch(int capacity) {
+        mBuffer = ByteBuffer.allocateDirect(capacity).order(
+                ByteOrder.nativeOrder());
+    }
+
+    public void addSceneObject(GVRScene scene, GVRSceneObject sceneObject) {
+        command(ADD_SCENE_OBJECT, scene, sceneObject);
+    }
+
+    public void removeSceneObject(GVRScene scene, GVRSceneObject sceneObject) {
+        command(REMOVE_SCENE_OBJECT, scene, sceneObject);
+    }
+
+    public void addChildObject(GVRSceneObject parent, GVRSceneObject child) {
+        command(ADD_CHILD_OBJECT, parent, child);
+    }
+
+    public void removeChildObject(GVRSceneObject parent, GVRSceneObject child) {
+        command(REMOVE_CHILD_OBJECT, parent, child);
+    }
+
+    public void attachTransform(GVRSceneObject sceneObject,
+            GVRTransform transform) {
+        command(ATTACH_TRANSFORM, sceneObject, transform);
+    }
+
+    public void attachRenderData(GVRSceneObject sceneObject,
+            GVRRenderData renderData) {
+        command(ATTACH_RENDER_DATA, sceneObject, renderData);
+    }
+
+    public void setPosition(GVRTransform transform, float x, float y, float z) {
+        command(SET_POSITION, transform);
+        putFloats(x, y, z);
+    }
+
+    public void setRotation(GVRTransform transform, float w, float x, float y,
+            float z) {
+        command(SET_ROTATION, transform);
+        putFloats(w, x, y, z);
+    }
+
+    public void setScale(GVRTransform transform, float x, float y, float z) {
+        command(SET_SCALE, transform);
+        putFloats(x, y, z);
+    }
+
+    public void setMesh(GVRRenderData renderData, GVRMesh mesh) {
+        command(SET_MESH, renderData, mesh);
+    }
+
+    public void setMaterial(GVRRenderData renderData, GVRMaterial material) {
+        command(SET_MATERIAL, renderData, material);
+    }
+
+    public void setTexture(GVRMaterial material, String key,
+            GVRTexture texture) {
+        command(SET_TEXTURE, material);
+        putKey(key);
+        putObject(texture);
+    }
+
+    public void setFloat(GVRMaterial material, String key, float value) {
+        command(SET_FLOAT, material);
+        putKey(key);
+        putFloats(value);
+    }
+
+    public void setVec2(GVRMaterial material, String key, float x, float y) {
+        command(SET_VEC2, material);
+        putKey(key);
+        putFloats(x, y);
+    }
+
+    public void setVec3(GVRMaterial material, String key, float x, float y,
+            float z) {
+        command(SET_VEC3, material);
+        putKey(key);
+        putFloats(x, y, z);
+    }
+
+    public void setVec4(GVRMaterial material, String key, float x, float y,
+            float z, float w) {
+        command(SET_VEC4, material);
+        putKey(key);
+        putFloats(x, y, z, w);
+    }
+
+    public void setEnable(GVRSceneObject sceneObject, boolean enable) {
+        command(SET_ENABLED, sceneObject);
+        putFloats(enable ? 1.0f : 0.0f);
+    }
+
+    /**
+     * @return {@code true} if no command has been recorded since the last
+     *         submit.
+     */
+    public boolean isEmpty() {
+        return mBuffer.position() == 0;
+    }
+
+    /**
+     * Queues every recorded command for the GL thread and empties the batch.
+     * 
+     * @throws IllegalArgumentException
+     *             If the batch holds a command the native side rejects; no
+     *             command of the batch is queued in that case.
+     */
+    public void submit() {
+        if (isEmpty()) {
+            return;
+        }
+        boolean accepted = NativeMutationQueue.submit(mBuffer,
+                mBuffer.position());
+        mBuffer.clear();
+        mObjects.clear();
+        if (!accepted) {
+            throw new IllegalArgumentException("Malformed mutation batch");
+        }
+    }
+
+    static void applyAll() {
+        NativeMutationQueue.apply();
+    }
+
+    private void command(int opcode, GVRHybridObject... objects) {
+        reserve(4 + 8 * objects.length);
+        mBuffer.putInt(opcode);
+        for (GVRHybridObject object : objects) {
+            putObject(object);
+        }
+    }
+
+    private void putObject(GVRHybridObject object) {
+        reserve(8);
+        mBuffer.putLong(object.getPtr());
+        mObjects.add(object);
+    }
+
+    private void putFloats(float... values) {
+        reserve(4 * values.length);
+        for (float value : values) {
+            mBuffer.putFloat(value);
+        }
+    }
+
+    private void putKey(String key) {
+        byte[] bytes = key.getBytes(UTF8);
+        int padded = (bytes.length + 3) & ~3;
+        reserve(4 + padded);
+        mBuffer.putInt(bytes.length);
+        mBuffer.put(bytes);
+        for (int i = bytes.length; i < padded; ++i) {
+            mBuffer.put((byte) 0);
+        }
+    }
+
+    private void reserve(int size) {
+        if (mBuffer.remaining() < size) {
+            ByteBuffer buffer = ByteBuffer.allocateDirect(
+                    Math.max(mBuffer.capacity() * 2, mBuffer.position() + size))
+                    .order(ByteOrder.nativeOrder());
+            mBuffer.flip();
+            buffer.put(mBuffer);
+            mBuffer = buffer;
+        }
+    }
+}
+
+class NativeMutationQueue {
+    static native boolean submit(ByteBuffer buffer, int size);
+
+    static native void apply();
+}
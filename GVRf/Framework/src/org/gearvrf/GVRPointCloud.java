@@ -0,0 +1,147 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+import java.io.File;
+
+/**
+ * A point cloud of up to tens of millions of points, drawn a part at a time
+ * through {@link GVRRenderData#setPointCloud(GVRPointCloud)}.
+ * 
+ * The points are sorted into an octree whose nodes hold up to
+ * {@link #CHUNK_POINTS} points each: a sample of their box, which their
+ * children refine. They are kept compressed to 10 bytes a point, in memory
+ * or in a cache file, with colors clamped to [0, 1]. Once every frame the
+ * nodes either eye sees are chosen, largest on screen first, up to the
+ * point budget, and the ones not on the GPU yet are streamed into its
+ * mesh, up to the upload budget; so far away parts of the cloud are drawn
+ * coarser, and the cloud fills in over a few frames as the view changes.
+ * The mesh keeps no copy of the points once on the GPU.
+ * 
+ * The mesh is of {@link GVRMesh.GVRPrimitiveType#POINTS points} with the
+ * colors in its vec4 vector {@link #COLOR_KEY}, to draw with a custom shader
+ * that binds them as an attribute and sets {@code gl_PointSize} from
+ * {@code u_point_size}.
+ */
+public class GVRPointCloud extends GVRHybridObject {
+    /** The most points in one node of the octree. */
+    public static final int CHUNK_POINTS = 8192;
+
+    /** The key of the colors in {@link #getMesh()}. */
+    public static final String COLOR_KEY = "color";
+
+    /**
+     * Constructs a point cloud. The points are copied, so the arrays can be
+     * let go of.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param positions
+     *            The positions as packed {@code x, y, z} triplets.
+     * @param colors
+     *            The colors as packed {@code r, g, b, a} quadruplets, one
+     *            per position; or {@code null} for white points.
+     * @param pointBudget
+     *            The most points drawn at a time, which is also the size of
+     *            the mesh in points; rounded down to whole chunks.
+     * @param uploadBudget
+     *            The most points streamed into the mesh before a draw; at
+     *            least one chunk is.
+     */
+    public GVRPointCloud(GVRContext gvrContext, float[] positions,
+            float[] colors, int pointBudget, int uploadBudget) {
+        this(gvrContext, positions, colors, pointBudget, uploadBudget, null);
+    }
+
+    /**
+     * Constructs a point cloud whose points wait in a cache file rather
+     * than in memory, and are read a node at a time as they are streamed.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param positions
+     *            The positions as packed {@code x, y, z} triplets.
+     * @param colors
+     *            The colors as packed {@code r, g, b, a} quadruplets, one
+     *            per position; or {@code null} for white points.
+     * @param pointBudget
+     *            The most points drawn at a time, which is also the size of
+     *            the mesh in points; rounded down to whole chunks.
+     * @param uploadBudget
+     *            The most points streamed into the mesh before a draw; at
+     *            least one chunk is.
+     * @param cacheFile
+     *            The file to keep the points in, for instance in
+     *            {@link android.content.Context#getCacheDir()}; it is
+     *            overwritten, and deleted with the point cloud. {@code null}
+     *            keeps them in memory.
+     */
+    public GVRPointCloud(GVRContext gvrContext, float[] positions,
+            float[] colors, int pointBudget, int uploadBudget, File cacheFile) {
+        super(gvrContext, NativePointCloud.ctor(positions, colors,
+                pointBudget, uploadBudget,
+                cacheFile == null ? null : cacheFile.getPath()));
+    }
+
+    /**
+     * @return The mesh the point cloud is streamed into.
+     */
+    public GVRMesh getMesh() {
+        return GVRMesh.factory(getGVRContext(),
+                NativePointCloud.getMesh(getPtr()));
+    }
+
+    /**
+     * @return The number of nodes in the octree.
+     */
+    public int getNodeCount() {
+        return NativePointCloud.getNodeCount(getPtr());
+    }
+
+    /**
+     * @return The number of points of the last draw.
+     */
+    public int getDrawnPointCount() {
+        return NativePointCloud.getDrawnPointCount(getPtr());
+    }
+
+    /**
+     * @return The number of points streamed into the mesh so far, counting
+     *         those streamed again after they were evicted.
+     */
+    public long getStreamedPointCount() {
+        return NativePointCloud.getStreamedPointCount(getPtr());
+    }
+
+    static void updateAll(GVRScene scene) {
+        NativePointCloud.updateAll(scene.getPtr());
+    }
+}
+
+class NativePointCloud {
+    static native long ctor(float[] positions, float[] colors,
+            int pointBudget, int uploadBudget, String cachePath);
+
+    static native long getMesh(long pointCloud);
+
+    static native int getNodeCount(long pointCloud);
+
+    static native int getDrawnPointCount(long pointCloud);
+
+    static native long getStreamedPointCount(long pointCloud);
+
+    static native void updateAll(long scene);
+}
@@ -0,0 +1,81 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+import java.util.Arrays;
+import java.util.List;
+
+/**
+ * A scene object subtree used as a template for many cheap copies.
+ * 
+ * {@link #instantiate()} clones the template natively in a single
+ * allocation, sharing its meshes, materials and textures. The prefab keeps
+ * track of its live instances; render data cloned from the same template
+ * node report the same {@link GVRRenderData#getInstanceGroup() instance
+ * group}, which marks them as candidates for batching or instancing.
+ */
+public class GVRPrefab extends GVRHybridObject {
+    private final GVRSceneObject mSceneObject;
+
+    /**
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param sceneObject
+     *            The template. Later changes to it affect only later
+     *            instances.
+     */
+    public GVRPrefab(GVRContext gvrContext, GVRSceneObject sceneObject) {
+        super(gvrContext, NativePrefab.ctor(sceneObject.getPtr()));
+        mSceneObject = sceneObject;
+    }
+
+    /**
+     * @return The template object.
+     */
+    public GVRSceneObject getSceneObject() {
+        return mSceneObject;
+    }
+
+    /**
+     * Clone the template.
+     * 
+     * @return The root of the new instance. It is not part of any scene.
+     */
+    public GVRSceneObject instantiate() {
+        return GVRSceneObject.factory(getGVRContext(),
+                NativePrefab.instantiate(getPtr()));
+    }
+
+    /**
+     * @return The instances that are still alive.
+     */
+    public List<GVRSceneObject> getInstances() {
+        long[] ptrs = NativePrefab.getInstances(getPtr());
+        GVRSceneObject[] instances = new GVRSceneObject[ptrs.length];
+        for (int i = 0; i < ptrs.length; ++i) {
+            instances[i] = GVRSceneObject.factory(getGVRContext(), ptrs[i]);
+        }
+        return Arrays.asList(instances);
+    }
+}
+
+class NativePrefab {
+    static native long ctor(long sceneObject);
+
+    static native long instantiate(long prefab);
+
+    static native long[] getInstances(long prefab);
+}
@@ -323,6 +323,89 @@ public class GVRRenderData extends GVRComponent {
     public void setAlphaBlend(boolean alphaBlend) {
         NativeRenderData.setAlphaBlend(getPtr(), alphaBlend);
     }
+
+    /**
+     * @return The width of the lines of a line mesh, in pixels.
+     */
+    public float getLineWidth() {
+        return NativeRenderData.getLineWidth(getPtr());
+    }
+
+    /**
+     * Set the width passed to {@code glLineWidth()} when the mesh is of
+     * {@linkplain GVRMesh.GVRPrimitiveType#LINES lines}. Devices may only
+     * support a width of 1.
+     * 
+     * @param lineWidth
+     *            Width in pixels; the initial value is 1.
+     */
+    public void setLineWidth(float lineWidth) {
+        NativeRenderData.setLineWidth(getPtr(), lineWidth);
+    }
+
+    /**
+     * @return The size of the points of a point mesh, in pixels.
+     */
+    public float getPointSize() {
+        return NativeRenderData.getPointSize(getPtr());
+    }
+
+    /**
+     * Set the value of the {@code u_point_size} uniform of custom shaders,
+     * for a vertex shader drawing {@linkplain GVRMesh.GVRPrimitiveType#POINTS
+     * points} to write to {@code gl_PointSize}.
+     * 
+     * @param pointSize
+     *            Size in pixels; the initial value is 1.
+     */
+    public void setPointSize(float pointSize) {
+        NativeRenderData.setPointSize(getPtr(), pointSize);
+    }
+
+    /**
+     * @return Whether the object is skipped when its mesh's bounds are out
+     *         of view.
+     */
+    public boolean getFrustumCulling() {
+        return NativeRenderData.getFrustumCulling(getPtr());
+    }
+
+    /**
+     * Enable or disable frustum culling, which is on by default: the object
+     * is not drawn when the bounds of its mesh are out of view. Turn it off
+     * for a custom shader that moves vertices beyond the mesh, or ignores
+     * {@code u_mvp}; the object is then drawn, and counts as in view.
+     * 
+     * @param frustumCulling
+     *            {@code false} to draw the object wherever its mesh is.
+     */
+    public void setFrustumCulling(boolean frustumCulling) {
+        NativeRenderData.setFrustumCulling(getPtr(), frustumCulling);
+    }
+
+    /**
+     * Draw a {@link GVRPointCloud}: its mesh becomes the mesh of this render
+     * data, and the chunks of the cloud to draw are chosen and streamed
+     * once every frame. Setting another mesh stops that; a clone of the
+     * render data draws a clone of the point cloud, with its own mesh.
+     * 
+     * @param pointCloud
+     *            The point cloud to draw.
+     */
+    public void setPointCloud(GVRPointCloud pointCloud) {
+        NativeRenderData.setPointCloud(getPtr(), pointCloud.getPtr());
+    }
+
+    /**
+     * Render data cloned from the same source share an instance group, and
+     * so the same mesh, material and render state, until one of them is
+     * changed.
+     * 
+     * @return The instance group, or 0 if this render data is in none.
+     */
+    public int getInstanceGroup() {
+        return NativeRenderData.getInstanceGroup(getPtr());
+    }
 }
 
 class NativeRenderData {
@@ -369,4 +452,21 @@ class NativeRenderData {
     public static native boolean getAlphaBlend(long renderData);
 
     public static native void setAlphaBlend(long renderData, boolean alphaBlend);
+
+    public static native int getInstanceGroup(long renderData);
+
+    public static native float getLineWidth(long renderData);
+
+    public static native void setLineWidth(long renderData, float lineWidth);
+
+    public static native float getPointSize(long renderData);
+
+    public static native void setPointSize(long renderData, float pointSize);
+
+    public static native boolean getFrustumCulling(long renderData);
+
+    public static native void setFrustumCulling(long renderData,
+            boolean frustumCulling);
+
+    public static native void setPointCloud(long renderData, long pointCloud);
 }
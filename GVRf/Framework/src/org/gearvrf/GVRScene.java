@@ -117,6 +117,75 @@ public class GVRScene extends GVRHybridObject {
         }
         return sceneObjects;
     }
+
+    /**
+     * Get the id of a name or tag. Resolving the id once and passing it to
+     * {@link #getSceneObjectsByName(int)} or {@link #getSceneObjectsByTag(int)}
+     * saves converting the string on every lookup.
+     * 
+     * @param string
+     *            A scene object name or tag.
+     * @return The id of {@code string}; ids are the same for every scene.
+     *         The string is kept for the lifetime of the process, so do not
+     *         resolve strings no object will carry.
+     */
+    public static int getStringId(String string) {
+        return NativeScene.getStringId(string);
+    }
+
+    /**
+     * Find the objects of the scene with a given name, at any depth of the
+     * hierarchy. The scene keeps an index of names, so the hierarchy is not
+     * walked.
+     * 
+     * @param name
+     *            Name of the objects.
+     * @return The matching objects, in no particular order.
+     */
+    public GVRSceneObject[] getSceneObjectsByName(String name) {
+        int nameId = NativeScene.findStringId(name);
+        return nameId < 0 ? new GVRSceneObject[0]
+                : getSceneObjectsByName(nameId);
+    }
+
+    /**
+     * Same as {@link #getSceneObjectsByName(String)}, with the name resolved
+     * by {@link #getStringId(String)}.
+     */
+    public GVRSceneObject[] getSceneObjectsByName(int nameId) {
+        return toSceneObjects(NativeScene.getSceneObjectsByName(getPtr(),
+                nameId));
+    }
+
+    /**
+     * Find the objects of the scene with a given
+     * {@linkplain GVRSceneObject#addTag(String) tag}, at any depth of the
+     * hierarchy.
+     * 
+     * @param tag
+     *            Tag of the objects.
+     * @return The matching objects, in no particular order.
+     */
+    public GVRSceneObject[] getSceneObjectsByTag(String tag) {
+        int tagId = NativeScene.findStringId(tag);
+        return tagId < 0 ? new GVRSceneObject[0] : getSceneObjectsByTag(tagId);
+    }
+
+    /**
+     * Same as {@link #getSceneObjectsByTag(String)}, with the tag resolved by
+     * {@link #getStringId(String)}.
+     */
+    public GVRSceneObject[] getSceneObjectsByTag(int tagId) {
+        return toSceneObjects(NativeScene.getSceneObjectsByTag(getPtr(), tagId));
+    }
+
+    private GVRSceneObject[] toSceneObjects(long[] ptrs) {
+        GVRSceneObject[] sceneObjects = new GVRSceneObject[ptrs.length];
+        for (int i = 0; i < ptrs.length; ++i) {
+            sceneObjects[i] = GVRSceneObject.factory(getGVRContext(), ptrs[i]);
+        }
+        return sceneObjects;
+    }
 }
 
 class NativeScene {
@@ -131,4 +200,12 @@ class NativeScene {
     public static native void setMainCameraRig(long scene, long cameraRig);
 
     public static native long[] getWholeSceneObjects(long scene);
+
+    public static native int getStringId(String string);
+
+    public static native int findStringId(String string);
+
+    public static native long[] getSceneObjectsByName(long scene, int nameId);
+
+    public static native long[] getSceneObjectsByTag(long scene, int tagId);
 }
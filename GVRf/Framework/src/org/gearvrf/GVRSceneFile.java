@@ -0,0 +1,140 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+import java.io.IOException;
+
+import android.content.res.AssetManager;
+
+/**
+ * Saves and loads scenes in the compact binary scene format.
+ * <p>
+ * A scene file stores the hierarchy, transforms, render data settings and
+ * material parameters. Meshes and textures are not embedded: they are
+ * referenced by a content hash, so register them with
+ * {@link #registerMesh(GVRMesh)} and
+ * {@link #registerTexture(long, GVRTexture)} before saving or loading.
+ * Loading maps the file and creates all its objects in one native call.
+ */
+public class GVRSceneFile {
+    private GVRSceneFile() {
+    }
+
+    /**
+     * Makes a mesh available to scene files.
+     * 
+     * @param mesh
+     *            The mesh to register.
+     * @return The content hash the mesh is referenced by.
+     */
+    public static long registerMesh(GVRMesh mesh) {
+        return NativeSceneFile.registerMesh(mesh.getPtr());
+    }
+
+    /**
+     * Makes a texture available to scene files. Textures have no CPU copy to
+     * hash, so the caller provides the hash, typically of the image file.
+     * 
+     * @param hash
+     *            The hash to reference the texture by.
+     * @param texture
+     *            The texture to register.
+     */
+    public static void registerTexture(long hash, GVRTexture texture) {
+        NativeSceneFile.registerTexture(hash, texture.getPtr());
+    }
+
+    /**
+     * Releases all registered meshes and textures.
+     */
+    public static void clearResources() {
+        NativeSceneFile.clearResources();
+    }
+
+    /**
+     * Writes every object of a scene to a file.
+     * 
+     * @param scene
+     *            The scene to save.
+     * @param path
+     *            Path of the file to write.
+     * @throws IOException
+     *             If the file cannot be written.
+     */
+    public static void save(GVRScene scene, String path) throws IOException {
+        if (!NativeSceneFile.writeToFile(scene.getPtr(), path)) {
+            throw new IOException("Cannot write scene file " + path);
+        }
+    }
+
+    /**
+     * Loads a scene file from the application's {@code assets} directory.
+     * Store the file uncompressed so it can be mapped in place.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param filename
+     *            Name of the file to load.
+     * @return The root objects of the file, or {@code null} if the file does
+     *         not exist or is not a scene file.
+     */
+    public static GVRSceneObject[] loadFromAssets(GVRContext gvrContext,
+            String filename) {
+        return wrap(gvrContext, NativeSceneFile.readFileFromAssets(gvrContext
+                .getContext().getAssets(), filename));
+    }
+
+    /**
+     * Loads a scene file from the device's SD card.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param path
+     *            Path of the file to load.
+     * @return The root objects of the file, or {@code null} if the file
+     *         cannot be read or is not a scene file.
+     */
+    public static GVRSceneObject[] loadFromSDCard(GVRContext gvrContext,
+            String path) {
+        return wrap(gvrContext, NativeSceneFile.readFileFromSDCard(path));
+    }
+
+    private static GVRSceneObject[] wrap(GVRContext gvrContext, long[] ptrs) {
+        if (ptrs == null) {
+            return null;
+        }
+        GVRSceneObject[] sceneObjects = new GVRSceneObject[ptrs.length];
+        for (int i = 0; i < ptrs.length; ++i) {
+            sceneObjects[i] = GVRSceneObject.factory(gvrContext, ptrs[i]);
+        }
+        return sceneObjects;
+    }
+}
+
+class NativeSceneFile {
+    static native long registerMesh(long mesh);
+
+    static native void registerTexture(long hash, long texture);
+
+    static native void clearResources();
+
+    static native boolean writeToFile(long scene, String path);
+
+    static native long[] readFileFromAssets(AssetManager assetManager,
+            String filename);
+
+    static native long[] readFileFromSDCard(String path);
+}
@@ -16,6 +16,7 @@
 package org.gearvrf;
 
 import java.util.Iterator;
+import java.util.NoSuchElementException;
 import java.util.concurrent.Future;
 
 import org.gearvrf.GVRMaterial.GVRShaderType;
@@ -37,6 +38,13 @@ import org.gearvrf.GVRMaterial.GVRShaderType.Unlit;
  * geometry, and a {@link GVRMaterial} that defines its surface.
  */
 public class GVRSceneObject extends GVRHybridObject {
+    /** The object or one of its ancestors is disabled. */
+    public static final int UPDATE_INACTIVE = 0;
+    /** The object is active, but its updates may be skipped this frame. */
+    public static final int UPDATE_SKIP = 1;
+    /** The object should be updated this frame. */
+    public static final int UPDATE_NOW = 2;
+
     /**
      * Constructs an empty scene object with a default {@link GVRTransform
      * transform}.
@@ -436,6 +444,70 @@ public class GVRSceneObject extends GVRHybridObject {
                 ptr);
     }
 
+    /**
+     * Attach a new {@link GVRBillboard} to the object.
+     * 
+     * If another {@link GVRBillboard} is currently attached, it is replaced
+     * with the new one.
+     * 
+     * @param billboard
+     *            New {@link GVRBillboard}.
+     */
+    public void attachBillboard(GVRBillboard billboard) {
+        NativeSceneObject.attachBillboard(getPtr(), billboard.getPtr());
+    }
+
+    /**
+     * Detach the object's current {@link GVRBillboard}.
+     */
+    public void detachBillboard() {
+        NativeSceneObject.detachBillboard(getPtr());
+    }
+
+    /**
+     * Get the attached {@link GVRBillboard}
+     * 
+     * @return The {@link GVRBillboard} attached to the object. If no
+     *         {@link GVRBillboard} is currently attached, returns {@code null}.
+     */
+    public GVRBillboard getBillboard() {
+        long ptr = NativeSceneObject.getBillboard(getPtr());
+        return ptr == 0 ? null : GVRBillboard.factory(getGVRContext(), ptr);
+    }
+
+    /**
+     * Attach a new {@link GVRTriggerVolume} to the object.
+     * 
+     * If another {@link GVRTriggerVolume} is currently attached, it is
+     * replaced with the new one.
+     * 
+     * @param triggerVolume
+     *            New {@link GVRTriggerVolume}.
+     */
+    public void attachTriggerVolume(GVRTriggerVolume triggerVolume) {
+        NativeSceneObject.attachTriggerVolume(getPtr(), triggerVolume.getPtr());
+    }
+
+    /**
+     * Detach the object's current {@link GVRTriggerVolume}.
+     */
+    public void detachTriggerVolume() {
+        NativeSceneObject.detachTriggerVolume(getPtr());
+    }
+
+    /**
+     * Get the attached {@link GVRTriggerVolume}
+     * 
+     * @return The {@link GVRTriggerVolume} attached to the object. If no
+     *         {@link GVRTriggerVolume} is currently attached, returns
+     *         {@code null}.
+     */
+    public GVRTriggerVolume getTriggerVolume() {
+        long ptr = NativeSceneObject.getTriggerVolume(getPtr());
+        return ptr == 0 ? null : GVRTriggerVolume.factory(getGVRContext(),
+                ptr);
+    }
+
     /**
      * Get the {@linkplain GVRSceneObject parent object.}
      * 
@@ -484,7 +556,10 @@ public class GVRSceneObject extends GVRHybridObject {
     }
 
     /**
-     * Get the child object at {@code index}.
+     * Get the child object at {@code index}. Children are kept in a linked
+     * list, so this walks the list, and a loop calling it for every index
+     * takes time quadratic in the number of children; use
+     * {@link #children()} to visit them all.
      * 
      * @param index
      *            Position of the child to get.
@@ -503,6 +578,152 @@ public class GVRSceneObject extends GVRHybridObject {
         }
     }
 
+    /**
+     * Clone this object and all its descendants. Transforms and render data
+     * are copied; meshes, materials and textures are shared with this
+     * object. Cameras, camera rigs and eye pointees are not cloned.
+     * 
+     * @return The root of the clone. It is not part of any scene.
+     */
+    public GVRSceneObject cloneHierarchy() {
+        return GVRSceneObject.factory(getGVRContext(),
+                NativeSceneObject.cloneHierarchy(getPtr()));
+    }
+
+    /**
+     * Add a tag to the object. The scene keeps an index of tags, see
+     * {@link GVRScene#getSceneObjectsByTag(String)}.
+     * 
+     * @param tag
+     *            Tag to add; an object may have several.
+     */
+    public void addTag(String tag) {
+        NativeSceneObject.addTag(getPtr(), tag);
+    }
+
+    /**
+     * Remove a tag added by {@link #addTag(String)}.
+     * 
+     * @param tag
+     *            Tag to remove.
+     */
+    public void removeTag(String tag) {
+        NativeSceneObject.removeTag(getPtr(), tag);
+    }
+
+    /**
+     * @param tag
+     *            A tag.
+     * @return {@code true} if the object has the tag.
+     */
+    public boolean hasTag(String tag) {
+        int tagId = NativeScene.findStringId(tag);
+        return tagId >= 0 && hasTag(tagId);
+    }
+
+    /**
+     * Same as {@link #hasTag(String)}, with the tag resolved by
+     * {@link GVRScene#getStringId(String)}.
+     */
+    public boolean hasTag(int tagId) {
+        return NativeSceneObject.hasTag(getPtr(), tagId);
+    }
+
+    /**
+     * Enable or disable the object. A disabled object and its whole subtree
+     * are skipped by rendering, picking, transform updates and animations,
+     * but stay attached to their parent.
+     * 
+     * @param enable
+     *            {@code false} to disable the object.
+     */
+    public void setEnable(boolean enable) {
+        NativeSceneObject.setEnable(getPtr(), enable);
+    }
+
+    /**
+     * @return {@code false} if the object itself has been disabled by
+     *         {@link #setEnable(boolean)}.
+     */
+    public boolean isEnabled() {
+        return NativeSceneObject.isEnabled(getPtr());
+    }
+
+    /**
+     * @return {@code true} if the object and all of its ancestors are
+     *         enabled.
+     */
+    public boolean isActive() {
+        return NativeSceneObject.isActive(getPtr());
+    }
+
+    /**
+     * @return {@code true} if the object, or one of its descendants, was
+     *         inside the view of a camera in the last frame. Objects count
+     *         as visible until they have been rendered once.
+     */
+    public boolean isVisibleLastFrame() {
+        return NativeSceneObject.isVisibleLastFrame(getPtr());
+    }
+
+    /**
+     * @return An estimate of the fraction of the viewport height the bounds
+     *         of the object covered in the last frame, between 0 and 1; 0 if
+     *         it was not visible.
+     */
+    public float getScreenSize() {
+        return NativeSceneObject.getScreenSize(getPtr());
+    }
+
+    /**
+     * Enable or disable update culling for the object. With update culling,
+     * which is on by default, the animations and the {@link GVRBillboard} of
+     * an object that was out of view in the last frame are only updated
+     * every few frames, and those of an object covering a small part of the
+     * view every other frame. An object with no render data below it, such
+     * as a camera rig or an empty pivot, cannot be seen and is always
+     * updated. Turn it off for objects whose updates matter to the game
+     * logic.
+     * 
+     * @param updateCulling
+     *            {@code false} to update the object every frame.
+     */
+    public void setUpdateCulling(boolean updateCulling) {
+        NativeSceneObject.setUpdateCulling(getPtr(), updateCulling);
+    }
+
+    /**
+     * @return Whether update culling is on for the object.
+     */
+    public boolean getUpdateCulling() {
+        return NativeSceneObject.getUpdateCulling(getPtr());
+    }
+
+    /**
+     * For systems that update objects every frame, like animations.
+     * 
+     * @return {@code false} if the updates of the object may be skipped
+     *         this frame, according to its visibility in the last frame.
+     */
+    public boolean shouldUpdate() {
+        return NativeSceneObject.shouldUpdate(getPtr());
+    }
+
+    /**
+     * {@link #isActive()} and {@link #shouldUpdate()} in a single call, for
+     * systems that check both every frame.
+     * 
+     * @return {@link #UPDATE_INACTIVE}, {@link #UPDATE_SKIP} or
+     *         {@link #UPDATE_NOW}.
+     */
+    public int getUpdateState() {
+        return NativeSceneObject.getUpdateState(getPtr());
+    }
+
+    static void nextFrame() {
+        NativeSceneObject.nextFrame();
+    }
+
     /**
      * As an alternative to calling {@link #getChildrenCount()} then repeatedly
      * calling {@link #getChildByIndex(int)}, you can
@@ -512,6 +733,9 @@ public class GVRSceneObject extends GVRHybridObject {
      * }
      * </pre>
      * 
+     * The children are fetched in one native call when the iteration starts,
+     * so stopping early costs nothing more.
+     * 
      * @return An {@link Iterable}, so you can use Java's enhanced for loop
      */
     public Iterable<GVRSceneObject> children() {
@@ -521,11 +745,18 @@ public class GVRSceneObject extends GVRHybridObject {
     private static class Children implements Iterable<GVRSceneObject>,
             Iterator<GVRSceneObject> {
 
-        private final GVRSceneObject object;
+        private final GVRSceneObject[] children;
         private int index;
 
         private Children(GVRSceneObject object) {
-            this.object = object;
+            // one native call for the whole list; every handle is owned by
+            // its object right away, so none leaks if the loop stops early
+            GVRContext gvrContext = object.getGVRContext();
+            long[] ptrs = NativeSceneObject.getChildren(object.getPtr());
+            this.children = new GVRSceneObject[ptrs.length];
+            for (int i = 0; i < ptrs.length; ++i) {
+                children[i] = GVRSceneObject.factory(gvrContext, ptrs[i]);
+            }
             this.index = 0;
         }
 
@@ -536,12 +767,15 @@ public class GVRSceneObject extends GVRHybridObject {
 
         @Override
         public boolean hasNext() {
-            return index < object.getChildrenCount();
+            return index < children.length;
         }
 
         @Override
         public GVRSceneObject next() {
-            return object.getChildByIndex(index++);
+            if (index >= children.length) {
+                throw new NoSuchElementException();
+            }
+            return children[index++];
         }
 
         @Override
@@ -590,6 +824,19 @@ class NativeSceneObject {
 
     public static native long getEyePointeeHolder(long sceneObject);
 
+    public static native void attachBillboard(long sceneObject, long billboard);
+
+    public static native void detachBillboard(long sceneObject);
+
+    public static native long getBillboard(long sceneObject);
+
+    public static native void attachTriggerVolume(long sceneObject,
+            long triggerVolume);
+
+    public static native void detachTriggerVolume(long sceneObject);
+
+    public static native long getTriggerVolume(long sceneObject);
+
     public static native long getParent(long sceneObject);
 
     public static native long setParent(long sceneObject, long parent);
@@ -601,4 +848,35 @@ class NativeSceneObject {
     public static native int getChildrenCount(long sceneObject);
 
     public static native long getChildByIndex(long sceneObject, int index);
+
+    public static native long[] getChildren(long sceneObject);
+
+    public static native long cloneHierarchy(long sceneObject);
+
+    public static native void setEnable(long sceneObject, boolean enable);
+
+    public static native boolean isEnabled(long sceneObject);
+
+    public static native boolean isActive(long sceneObject);
+
+    public static native boolean isVisibleLastFrame(long sceneObject);
+
+    public static native float getScreenSize(long sceneObject);
+
+    public static native boolean getUpdateCulling(long sceneObject);
+
+    public static native void setUpdateCulling(long sceneObject,
+            boolean updateCulling);
+
+    public static native boolean shouldUpdate(long sceneObject);
+
+    public static native int getUpdateState(long sceneObject);
+
+    public static native void nextFrame();
+
+    public static native void addTag(long sceneObject, String tag);
+
+    public static native void removeTag(long sceneObject, String tag);
+
+    public static native boolean hasTag(long sceneObject, int tagId);
 }
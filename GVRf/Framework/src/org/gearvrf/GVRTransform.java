@@ -297,6 +297,17 @@ public class GVRTransform extends GVRComponent {
         return NativeTransform.getModelMatrix(getPtr());
     }
 
+    /**
+     * Get the 4x4 model matrix without allocating.
+     * 
+     * @param matrix
+     *            An array of at least 16 {@code float}s that receives the
+     *            matrix in OpenGL-compatible column-major format.
+     */
+    public void getModelMatrix(float[] matrix) {
+        NativeTransform.fillModelMatrix(getPtr(), matrix);
+    }
+
     /**
      * Set the 4x4 model matrix and set current scaling, rotation, and 
      * transformation based on this model matrix.
@@ -461,6 +472,8 @@ class NativeTransform {
 
     public static native float[] getModelMatrix(long transform);
 
+    public static native void fillModelMatrix(long transform, float[] matrix);
+
     public static native void setModelMatrix(long tranform, float[] mat);
 
     public static native void translate(long transform, float x, float y,
@@ -0,0 +1,223 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.FloatBuffer;
+
+import org.gearvrf.utility.Exceptions;
+
+/**
+ * A group of {@link GVRTransform}s whose position, rotation and scale live in
+ * memory shared with native code.
+ * 
+ * Setting a pose through a block writes the shared buffer in place and costs
+ * no JNI call; all blocks are applied once per frame, right after
+ * {@link GVRScript#onStep()}, and the resulting model matrices are written
+ * back for the slots that moved, so they can be read without allocating.
+ * Only use a block from the GL thread.
+ */
+public class GVRTransformBlock extends GVRHybridObject {
+    private static final int POSE_SIZE = 10;
+    private static final int MATRIX_SIZE = 16;
+
+    private final int mCapacity;
+    private final FloatBuffer mPoses;
+    private final FloatBuffer mMatrices;
+    private final ByteBuffer mDirtyFlags;
+
+    /**
+     * Constructs a block with room for {@code capacity} transforms.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param capacity
+     *            Number of slots.
+     */
+    public GVRTransformBlock(GVRContext gvrContext, int capacity) {
+        super(gvrContext, NativeTransformBlock.ctor(capacity));
+        mCapacity = capacity;
+        mPoses = NativeTransformBlock.getPoses(getPtr())
+                .order(ByteOrder.nativeOrder()).asFloatBuffer();
+        mMatrices = NativeTransformBlock.getMatrices(getPtr())
+                .order(ByteOrder.nativeOrder()).asFloatBuffer();
+        mDirtyFlags = NativeTransformBlock.getDirtyFlags(getPtr());
+    }
+
+    /**
+     * @return The number of slots.
+     */
+    public int getCapacity() {
+        return mCapacity;
+    }
+
+    /**
+     * Drives a transform from a slot. The slot starts out with the current
+     * pose of the transform.
+     * 
+     * @param index
+     *            Slot to bind.
+     * @param transform
+     *            The transform to drive.
+     * @throws IllegalArgumentException
+     *             if {@code index} is not a slot of this block.
+     */
+    public void bind(int index, GVRTransform transform) {
+        checkIndex(index);
+        NativeTransformBlock.bind(getPtr(), index, transform.getPtr());
+    }
+
+    /**
+     * Releases the transform bound to a slot.
+     * 
+     * @param index
+     *            Slot to release.
+     * @throws IllegalArgumentException
+     *             if {@code index} is not a slot of this block.
+     */
+    public void unbind(int index) {
+        checkIndex(index);
+        NativeTransformBlock.unbind(getPtr(), index);
+    }
+
+    /**
+     * Set the position of a slot.
+     * 
+     * @param index
+     *            Slot to change.
+     * @param x
+     *            'X' component of the position.
+     * @param y
+     *            'Y' component of the position.
+     * @param z
+     *            'Z' component of the position.
+     */
+    public void setPosition(int index, float x, float y, float z) {
+        int offset = index * POSE_SIZE;
+        mPoses.put(offset, x);
+        mPoses.put(offset + 1, y);
+        mPoses.put(offset + 2, z);
+        markDirty(index);
+    }
+
+    /**
+     * Set the rotation of a slot as a quaternion.
+     * 
+     * @param index
+     *            Slot to change.
+     * @param w
+     *            'W' component of the quaternion.
+     * @param x
+     *            'X' component of the quaternion.
+     * @param y
+     *            'Y' component of the quaternion.
+     * @param z
+     *            'Z' component of the quaternion.
+     */
+    public void setRotation(int index, float w, float x, float y, float z) {
+        int offset = index * POSE_SIZE + 3;
+        mPoses.put(offset, w);
+        mPoses.put(offset + 1, x);
+        mPoses.put(offset + 2, y);
+        mPoses.put(offset + 3, z);
+        markDirty(index);
+    }
+
+    /**
+     * Set the scale of a slot.
+     * 
+     * @param index
+     *            Slot to change.
+     * @param x
+     *            Scaling factor on the 'X' axis.
+     * @param y
+     *            Scaling factor on the 'Y' axis.
+     * @param z
+     *            Scaling factor on the 'Z' axis.
+     */
+    public void setScale(int index, float x, float y, float z) {
+        int offset = index * POSE_SIZE + 7;
+        mPoses.put(offset, x);
+        mPoses.put(offset + 1, y);
+        mPoses.put(offset + 2, z);
+        markDirty(index);
+    }
+
+    /**
+     * Direct access to the poses: ten {@code float}s per slot, position
+     * (x, y, z), rotation (w, x, y, z) and scale (x, y, z). Call
+     * {@link #markDirty(int)} for every slot written this way.
+     * 
+     * @return The shared pose buffer.
+     */
+    public FloatBuffer getPoses() {
+        return mPoses;
+    }
+
+    /**
+     * Flags a slot to be applied at the start of the next frame.
+     * 
+     * @param index
+     *            Slot that changed.
+     */
+    public void markDirty(int index) {
+        mDirtyFlags.put(index, (byte) 1);
+    }
+
+    /**
+     * Get the model matrix of a slot as of the last time blocks were applied.
+     * 
+     * @param index
+     *            Slot to read.
+     * @param matrix
+     *            An array of at least 16 {@code float}s that receives the
+     *            matrix in OpenGL-compatible column-major format.
+     */
+    public void getModelMatrix(int index, float[] matrix) {
+        int offset = index * MATRIX_SIZE;
+        for (int i = 0; i < MATRIX_SIZE; ++i) {
+            matrix[i] = mMatrices.get(offset + i);
+        }
+    }
+
+    private void checkIndex(int index) {
+        if (index < 0 || index >= mCapacity) {
+            throw Exceptions.IllegalArgument("Slot %d is outside a block of %d",
+                    index, mCapacity);
+        }
+    }
+
+    static void applyAll() {
+        NativeTransformBlock.applyAll();
+    }
+}
+
+class NativeTransformBlock {
+    static native long ctor(int capacity);
+
+    static native ByteBuffer getPoses(long transformBlock);
+
+    static native ByteBuffer getMatrices(long transformBlock);
+
+    static native ByteBuffer getDirtyFlags(long transformBlock);
+
+    static native void bind(long transformBlock, int index, long transform);
+
+    static native void unbind(long transformBlock, int index);
+
+    static native void applyAll();
+}
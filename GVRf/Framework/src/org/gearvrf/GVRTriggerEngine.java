@@ -0,0 +1,130 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.gearvrf;
+
+import java.lang.ref.WeakReference;
+import java.util.ArrayList;
+import java.util.Iterator;
+import java.util.List;
+
+/**
+ * Reports when the {@linkplain GVRTriggerVolume trigger volumes} of a scene
+ * start or stop overlapping.
+ * 
+ * Once per frame, right after {@link GVRScript#onStep()}, every active volume
+ * of the scene is tested natively: a spatial hash finds the volumes that are
+ * near each other, only those are tested exactly, and the result is compared
+ * with the previous frame. Only changes are reported, in one
+ * {@link GVRTriggerListener#onTriggerEvents(GVRTriggerEvent[])} call per
+ * frame, so proximity logic needs no per-object distance checks in Java.
+ * Deciding what the user looks at remains the job of {@link GVRPicker}.
+ */
+public class GVRTriggerEngine extends GVRHybridObject {
+    private static final List<WeakReference<GVRTriggerEngine>> sEngines = new ArrayList<WeakReference<GVRTriggerEngine>>();
+
+    private GVRTriggerListener mListener;
+
+    /**
+     * Constructs an engine for the volumes of {@code scene}.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param scene
+     *            The scene whose volumes are tested.
+     */
+    public GVRTriggerEngine(GVRContext gvrContext, GVRScene scene) {
+        super(gvrContext, NativeTriggerEngine.ctor(scene.getPtr()));
+        synchronized (sEngines) {
+            sEngines.add(new WeakReference<GVRTriggerEngine>(this));
+        }
+    }
+
+    /**
+     * Sets the size of the cells of the spatial hash. About the size of a
+     * typical volume works best; the default is 2.
+     * 
+     * @param cellSize
+     *            Edge length of a cell, in world units.
+     */
+    public void setCellSize(float cellSize) {
+        NativeTriggerEngine.setCellSize(getPtr(), cellSize);
+    }
+
+    /**
+     * @return The number of volume pairs that overlapped in the last frame.
+     */
+    public int getOverlapCount() {
+        return NativeTriggerEngine.getOverlapCount(getPtr());
+    }
+
+    /**
+     * @param listener
+     *            The listener to call with the events of each frame, or
+     *            {@code null} to stop testing the volumes.
+     */
+    public void setListener(GVRTriggerListener listener) {
+        mListener = listener;
+    }
+
+    private void update() {
+        GVRTriggerListener listener = mListener;
+        if (listener == null) {
+            return;
+        }
+        long[] ptrs = NativeTriggerEngine.update(getPtr());
+        if (ptrs == null) {
+            return;
+        }
+
+        GVRContext gvrContext = getGVRContext();
+        GVRTriggerEvent[] events = new GVRTriggerEvent[ptrs.length / 3];
+        for (int i = 0; i < events.length; ++i) {
+            events[i] = new GVRTriggerEvent(ptrs[3 * i] != 0,
+                    GVRTriggerVolume.factory(gvrContext, ptrs[3 * i + 1]),
+                    GVRTriggerVolume.factory(gvrContext, ptrs[3 * i + 2]));
+        }
+        listener.onTriggerEvents(events);
+    }
+
+    static void updateAll() {
+        List<GVRTriggerEngine> engines = new ArrayList<GVRTriggerEngine>();
+        synchronized (sEngines) {
+            for (Iterator<WeakReference<GVRTriggerEngine>> it = sEngines
+                    .iterator(); it.hasNext();) {
+                GVRTriggerEngine engine = it.next().get();
+                if (engine == null) {
+                    it.remove();
+                } else {
+                    engines.add(engine);
+                }
+            }
+        }
+        for (GVRTriggerEngine engine : engines) {
+            engine.update();
+        }
+    }
+}
+
+class NativeTriggerEngine {
+    public static native long ctor(long scene);
+
+    public static native void setCellSize(long triggerEngine, float cellSize);
+
+    public static native int getOverlapCount(long triggerEngine);
+
+    public static native long[] update(long triggerEngine);
+}
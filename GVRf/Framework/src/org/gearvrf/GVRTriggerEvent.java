@@ -0,0 +1,57 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.gearvrf;
+
+/**
+ * Two {@linkplain GVRTriggerVolume trigger volumes} that started or stopped
+ * overlapping.
+ */
+public class GVRTriggerEvent {
+    private final boolean mEnter;
+    private final GVRTriggerVolume mFirst;
+    private final GVRTriggerVolume mSecond;
+
+    GVRTriggerEvent(boolean enter, GVRTriggerVolume first,
+            GVRTriggerVolume second) {
+        mEnter = enter;
+        mFirst = first;
+        mSecond = second;
+    }
+
+    /**
+     * @return {@code true} if the volumes started overlapping, {@code false}
+     *         if they stopped.
+     */
+    public boolean isEnter() {
+        return mEnter;
+    }
+
+    /**
+     * @return One of the two volumes. The order of the volumes is arbitrary,
+     *         but the same for the enter and the exit event of a pair.
+     */
+    public GVRTriggerVolume getFirst() {
+        return mFirst;
+    }
+
+    /**
+     * @return The other volume.
+     */
+    public GVRTriggerVolume getSecond() {
+        return mSecond;
+    }
+}
@@ -0,0 +1,31 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.gearvrf;
+
+/**
+ * Receives the trigger events of a {@link GVRTriggerEngine}.
+ */
+public interface GVRTriggerListener {
+    /**
+     * Called on the GL thread, at most once per frame, with every pair of
+     * trigger volumes that started or stopped overlapping during the frame.
+     * 
+     * @param events
+     *            The events of the frame; never empty.
+     */
+    void onTriggerEvents(GVRTriggerEvent[] events);
+}
@@ -0,0 +1,116 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+package org.gearvrf;
+
+/**
+ * A sphere or box, in the space of its {@linkplain GVRSceneObject owner
+ * object}, whose overlaps with other trigger volumes are reported by a
+ * {@link GVRTriggerEngine}.
+ * 
+ * The volume follows the owner's {@link GVRTransform}, scale included. A
+ * new volume is a sphere of radius 0.5 centered on the owner.
+ */
+public class GVRTriggerVolume extends GVRComponent {
+    /** The volume is a sphere. */
+    public static final int SPHERE = 0;
+    /** The volume is a box, aligned with the owner's axes. */
+    public static final int BOX = 1;
+
+    /**
+     * Constructs a sphere of radius 0.5.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     */
+    public GVRTriggerVolume(GVRContext gvrContext) {
+        super(gvrContext, NativeTriggerVolume.ctor());
+    }
+
+    private GVRTriggerVolume(GVRContext gvrContext, long ptr) {
+        super(gvrContext, ptr);
+    }
+
+    static GVRTriggerVolume factory(GVRContext gvrContext, long ptr) {
+        GVRHybridObject wrapper = wrapper(ptr);
+        return wrapper == null ? new GVRTriggerVolume(gvrContext, ptr)
+                : (GVRTriggerVolume) wrapper;
+    }
+
+    @Override
+    protected final boolean registerWrapper() {
+        return true;
+    }
+
+    /**
+     * @return {@link #SPHERE} or {@link #BOX}.
+     */
+    public int getShape() {
+        return NativeTriggerVolume.getShape(getPtr());
+    }
+
+    /**
+     * Makes the volume a sphere.
+     * 
+     * @param radius
+     *            Radius of the sphere.
+     */
+    public void setSphere(float radius) {
+        NativeTriggerVolume.setSphere(getPtr(), radius);
+    }
+
+    /**
+     * Makes the volume a box.
+     * 
+     * @param halfX
+     *            Half the size of the box along the owner's x axis.
+     * @param halfY
+     *            Half the size of the box along the owner's y axis.
+     * @param halfZ
+     *            Half the size of the box along the owner's z axis.
+     */
+    public void setBox(float halfX, float halfY, float halfZ) {
+        NativeTriggerVolume.setBox(getPtr(), halfX, halfY, halfZ);
+    }
+
+    /**
+     * Moves the volume away from the owner's origin.
+     * 
+     * @param x
+     *            X of the center, in the owner's space.
+     * @param y
+     *            Y of the center, in the owner's space.
+     * @param z
+     *            Z of the center, in the owner's space.
+     */
+    public void setCenter(float x, float y, float z) {
+        NativeTriggerVolume.setCenter(getPtr(), x, y, z);
+    }
+}
+
+class NativeTriggerVolume {
+    public static native long ctor();
+
+    public static native int getShape(long triggerVolume);
+
+    public static native void setSphere(long triggerVolume, float radius);
+
+    public static native void setBox(long triggerVolume, float x, float y,
+            float z);
+
+    public static native void setCenter(long triggerVolume, float x, float y,
+            float z);
+}
@@ -236,6 +236,7 @@ class GVRViewManager extends GVRContext implements RotationSensorListener {
         /*
          * GL Initializations.
          */
+        NativeGLStreamBuffer.onContextCreated();
         mRenderBundle = new GVRRenderBundle(this, mLensInfo);
         mMainScene = new GVRScene(this);
     }
@@ -671,7 +672,15 @@ class GVRViewManager extends GVRContext implements RotationSensorListener {
             doMemoryManagementAndPerFrameCallbacks();
 
             GVRHybridObject.onStep();
+            GVRSceneObject.nextFrame();
             mScript.onStep();
+
+            GVRMutationBatch.applyAll();
+            GVRTransformBlock.applyAll();
+            GVRWorldStreamer.updateAll();
+            GVRBillboard.updateAll(mMainScene);
+            GVRPointCloud.updateAll(mMainScene);
+            GVRTriggerEngine.updateAll();
         }
 
         public void onDrawFrame() {
@@ -876,3 +885,7 @@ class GVRViewManager extends GVRContext implements RotationSensorListener {
         return mRecyclableObjectProtector;
     }
 }
+
+class NativeGLStreamBuffer {
+    static native void onContextCreated();
+}
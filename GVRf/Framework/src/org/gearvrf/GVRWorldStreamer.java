@@ -0,0 +1,163 @@
+/* Copyright 2015 Samsung Electronics Co., LTD
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+package org.gearvrf;
+
+/**
+ * Streams a large world into a {@link GVRScene} one spatial cell at a time.
+ * 
+ * The world is split offline into cells, each saved with
+ * {@link GVRSceneFile#save(GVRScene, String)} and described by a
+ * bounding sphere. A background thread reads the files of the cells nearest
+ * the main camera rig; once per frame, right after {@link GVRScript#onStep()},
+ * loaded cells are added to the scene and cells that fell out of range are
+ * removed. That work is split into steps (parsing a cell, adding one of its
+ * root objects, removing a cell) and stops once the per-frame time budget is
+ * spent. A single step is never split, so a frame can overrun the budget by
+ * the time it takes to parse one cell; keep cells small. Meshes are uploaded
+ * the first time they are drawn, which is not counted against the budget.
+ * Cells ahead of the camera are streamed before cells behind it. The meshes
+ * and textures the cells reference must be registered with
+ * {@link GVRSceneFile}.
+ */
+public class GVRWorldStreamer extends GVRHybridObject {
+    /** The cell is not in memory. */
+    public static final int CELL_UNLOADED = 0;
+    /** The cell file is queued or being read. */
+    public static final int CELL_REQUESTED = 1;
+    /**
+     * The cell file has been read, and waits to be added to the scene or is
+     * partly added.
+     */
+    public static final int CELL_LOADED = 2;
+    /** The cell is in the scene. */
+    public static final int CELL_RESIDENT = 3;
+    /** The cell file could not be read; it will not be tried again. */
+    public static final int CELL_FAILED = 4;
+
+    /**
+     * Constructs a streamer that adds its cells to {@code scene}.
+     * 
+     * @param gvrContext
+     *            Current {@link GVRContext}
+     * @param scene
+     *            The scene to stream into.
+     */
+    public GVRWorldStreamer(GVRContext gvrContext, GVRScene scene) {
+        super(gvrContext, NativeWorldStreamer.ctor(scene.getPtr()));
+    }
+
+    /**
+     * Adds a cell to the world.
+     * 
+     * @param path
+     *            Path of the cell's scene file on the file system.
+     * @param x
+     *            X of the center of the cell's bounding sphere.
+     * @param y
+     *            Y of the center of the cell's bounding sphere.
+     * @param z
+     *            Z of the center of the cell's bounding sphere.
+     * @param radius
+     *            Radius of the cell's bounding sphere.
+     * @return The index of the cell.
+     */
+    public int addCell(String path, float x, float y, float z, float radius) {
+        return NativeWorldStreamer.addCell(getPtr(), path, x, y, z, radius);
+    }
+
+    /**
+     * @param cell
+     *            Index of a cell, returned by
+     *            {@link #addCell(String, float, float, float, float)}.
+     * @return One of the {@code CELL_} constants.
+     */
+    public int getCellState(int cell) {
+        return NativeWorldStreamer.getCellState(getPtr(), cell);
+    }
+
+    /**
+     * Sets how close to the camera, from the bounds of a cell, the cell starts
+     * streaming in.
+     * 
+     * @param loadDistance
+     *            Distance, in scene units.
+     */
+    public void setLoadDistance(float loadDistance) {
+        NativeWorldStreamer.setLoadDistance(getPtr(), loadDistance);
+    }
+
+    /**
+     * Sets how far from the camera a loaded cell is removed. It should exceed
+     * the load distance, so cells at the edge are not streamed in and out
+     * every frame.
+     * 
+     * @param unloadDistance
+     *            Distance, in scene units.
+     */
+    public void setUnloadDistance(float unloadDistance) {
+        NativeWorldStreamer.setUnloadDistance(getPtr(), unloadDistance);
+    }
+
+    /**
+     * Sets the time spent adding and removing cells per frame. At least one
+     * step is taken per frame regardless.
+     * 
+     * @param milliseconds
+     *            Budget per frame.
+     */
+    public void setFrameBudget(float milliseconds) {
+        NativeWorldStreamer.setFrameBudget(getPtr(),
+                (long) (milliseconds * 1000000.0f));
+    }
+
+    /**
+     * Sets how many cells may be in memory at once; the cells nearest the
+     * camera win.
+     * 
+     * @param maxResidentCells
+     *            Number of cells.
+     */
+    public void setMaxResidentCells(int maxResidentCells) {
+        NativeWorldStreamer.setMaxResidentCells(getPtr(), maxResidentCells);
+    }
+
+    static void updateAll() {
+        NativeWorldStreamer.updateAll();
+    }
+}
+
+class NativeWorldStreamer {
+    public static native long ctor(long scene);
+
+    public static native int addCell(long worldStreamer, String path, float x,
+            float y, float z, float radius);
+
+    public static native int getCellState(long worldStreamer, int cell);
+
+    public static native void setLoadDistance(long worldStreamer,
+            float loadDistance);
+
+    public static native void setUnloadDistance(long worldStreamer,
+            float unloadDistance);
+
+    public static native void setFrameBudget(long worldStreamer,
+            long frameBudget);
+
+    public static native void setMaxResidentCells(long worldStreamer,
+            int maxResidentCells);
+
+    public static native void updateAll();
+}
@@ -326,6 +326,12 @@ public abstract class GVRAnimation {
      *         it down
      */
     final boolean onDrawFrame(float frameTime) {
+        final int updateState = getTargetUpdateState();
+        if (updateState == GVRSceneObject.UPDATE_INACTIVE) {
+            // paused while the target is disabled
+            return true;
+        }
+
         final int previousCycleCount = (int) (mElapsedTime / mDuration);
 
         mElapsedTime += frameTime;
@@ -357,6 +363,11 @@ public abstract class GVRAnimation {
         }
 
         if (stillRunning) {
+            if (updateState == GVRSceneObject.UPDATE_SKIP) {
+                // the time still runs, so the target catches up when seen
+                return true;
+            }
+
             final boolean countDown = mRepeatMode == GVRRepeatMode.PINGPONG
                     && (mIterations & 1) == 1;
             float elapsedRatio = //
@@ -377,6 +388,17 @@ public abstract class GVRAnimation {
         return stillRunning;
     }
 
+    // one native call per frame for both the enabled state and update culling
+    private int getTargetUpdateState() {
+        if (mTarget instanceof GVRSceneObject) {
+            return ((GVRSceneObject) mTarget).getUpdateState();
+        } else if (mTarget instanceof GVRTransform) {
+            return ((GVRTransform) mTarget).getUpdateState();
+        } else {
+            return GVRSceneObject.UPDATE_NOW;
+        }
+    }
+
     private float interpolate(float cycleTime, float duration) {
         float ratio = cycleTime / duration;
         return mInterpolator == null ? ratio : mInterpolator.mapRatio(ratio);